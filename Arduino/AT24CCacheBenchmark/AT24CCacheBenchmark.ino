@@ -0,0 +1,218 @@
+#include <Arduino.h>
+#include <Wire.h>
+#include "AT24C.h"
+#include "AT24CDataStream.h"
+#include "DisplayController.h"
+
+#include "XFont.h"
+XFont xFont;
+/*
+*	The same subset exported as 8 bit (for 16 bit displays) and as 1 bit
+*	rotated (for the monochrome displays.)  The glyph data is included so the
+*	sketch can write it to the AT24C before each test.
+*/
+#include "Lato-Regular_14.h"
+#include "Lato-Regular_14_1bR.h"
+/*
+*	The 8 bit subset again, with the glyph data laid out for 32 byte pages
+*	(exported with ePageAlign32 and eGlyphDataSeparately.)  The contents of
+*	the .gdat file were included as glyphData so the sketch can write it.
+*/
+#include "Lato-Regular_14_P32.h"
+
+/*
+*	AT24C32, 32 byte pages.  The page size determines the size of each
+*	read-ahead line.
+*/
+const uint8_t	kAT24CDeviceAddr = 0x50;
+const uint8_t	kAT24CDeviceCapacity = 4;	// Value at end of AT24Cxxx xxx/8
+AT24C	eeprom(kAT24CDeviceAddr, kAT24CDeviceCapacity);
+const uint16_t	kGlyphDataAddress = 0;
+
+const char		kClockStr[] = "12:34:56 12:34:57 12:34:58";
+const char		kFoxStr[] = "The quick brown fox 0123456789";
+const uint16_t	kWindowSizes[] = {0, 128, 256};
+uint8_t			readAheadWindow[256];
+
+/*
+*	NullDisplay pulls the glyph data through the stream like a real display
+*	would, but discards it.  This keeps the display's own bus traffic and
+*	timing out of the measurement.
+*/
+class NullDisplay : public DisplayController
+{
+public:
+							NullDisplay(
+								uint16_t				inRows,
+								uint16_t				inColumns,
+								uint8_t					inBitsPerPixel)
+								: DisplayController(inRows, inColumns),
+								  mBitsPerPixel(inBitsPerPixel){}
+	virtual uint8_t			BitsPerPixel(void) const
+								{return(mBitsPerPixel);}
+	virtual void			MoveTo(
+								uint16_t				inRow,
+								uint16_t				inColumn)
+								{mRow = inRow; mColumn = inColumn;}
+	virtual void			MoveToRow(
+								uint16_t				inRow)
+								{mRow = inRow;}
+	virtual void			MoveToColumn(
+								uint16_t				inColumn)
+								{mColumn = inColumn;}
+	virtual void			Sleep(void){}
+	virtual void			WakeUp(void){}
+	virtual void			FillPixels(
+								uint32_t				inPixelsToFill,
+								uint16_t				inFillColor){}
+	virtual void			SetColumnRange(
+								uint16_t				inStartColumn,
+								uint16_t				inEndColumn){}
+	virtual void			SetRowRange(
+								uint16_t				inStartRow,
+								uint16_t				inEndRow){}
+	virtual void			StreamCopy(
+								DataStream*				inDataStream,
+								uint16_t				inPixelsToCopy);
+	virtual void			SetAddressingMode(
+								EAddressingMode			inAddressingMode)
+								{mAddressingMode = inAddressingMode;}
+protected:
+	uint8_t	mBitsPerPixel;
+};
+
+/******************************** StreamCopy **********************************/
+void NullDisplay::StreamCopy(
+	DataStream*	inDataStream,
+	uint16_t	inPixelsToCopy)
+{
+	uint16_t	buffer[16];
+	// 16 bit pixels or, for the monochrome displays, bytes.
+	uint8_t	maxPerRead = mBitsPerPixel == 16 ? 16 : sizeof(buffer);
+	while (inPixelsToCopy)
+	{
+		uint16_t pixelsToRead = inPixelsToCopy > maxPerRead ? maxPerRead : inPixelsToCopy;
+		inPixelsToCopy -= pixelsToRead;
+		inDataStream->Read(pixelsToRead, buffer);
+	}
+}
+
+NullDisplay	display16(240, 320, 16);
+NullDisplay	display1(8, 320, 1);	// 8 pages of 8 rows
+
+/******************************* LoadGlyphData ********************************/
+/*
+*	Writes the PROGMEM glyph data to the AT24C at kGlyphDataAddress.  Only
+*	the blocks that differ are written.
+*/
+void LoadGlyphData(
+	const uint8_t*	inGlyphData,
+	uint16_t		inLength)
+{
+	uint8_t		buffer[32];
+	uint8_t		current[32];
+	uint16_t	address = kGlyphDataAddress;
+	while (inLength)
+	{
+		uint8_t	blockLen = inLength > sizeof(buffer) ? sizeof(buffer) : inLength;
+		memcpy_P(buffer, inGlyphData, blockLen);
+		eeprom.WaitTillReady();
+		eeprom.Read(address, blockLen, current);
+		if (memcmp(buffer, current, blockLen))
+		{
+			eeprom.Write(address, blockLen, buffer);
+		}
+		inGlyphData += blockLen;
+		address += blockLen;
+		inLength -= blockLen;
+	}
+	eeprom.WaitTillReady();
+}
+
+/******************************** RunTest *************************************/
+/*
+*	Draws inString once per read-ahead window size and prints the I2C
+*	transactions made by AT24C::Read, the window's hits and misses, and the
+*	time taken.  Each test starts with an empty window.
+*/
+void RunTest(
+	const char*			inLabel,
+	const FontHeader*	inFontHeader,
+	const CharcodeRun*	inCharcodeRuns,
+	const uint16_t*		inGlyphDataCheckpoint,
+	const uint8_t*		inGlyphDataDelta,
+	uint16_t			inGlyphDataLength,
+	NullDisplay*		inDisplay,
+	const char*			inString)
+{
+	for (uint8_t i = 0; i < sizeof(kWindowSizes)/sizeof(kWindowSizes[0]); i++)
+	{
+		AT24CDataStream	dataStream(&eeprom, (const void*)kGlyphDataAddress,
+							inGlyphDataLength, kWindowSizes[i] ? readAheadWindow : nullptr,
+								kWindowSizes[i]);
+		XFont16BitDataStream	xFont16BitDataStream(&xFont, &dataStream);
+		XFontR1BitDataStream	xFontR1BitDataStream(&xFont, &dataStream);
+		XFontDataStream*	xFontDataStream = inDisplay->BitsPerPixel() == 1 ?
+			(XFontDataStream*)&xFontR1BitDataStream :
+				(XFontDataStream*)&xFont16BitDataStream;
+		XFont::Font	font(inFontHeader, inCharcodeRuns, inGlyphDataCheckpoint,
+						xFontDataStream, nullptr, inGlyphDataDelta);
+		xFont.SetDisplay(inDisplay, &font);
+		inDisplay->MoveTo(0, 0);
+		eeprom.ResetReadTransactions();
+		uint32_t	startTime = micros();
+		xFont.DrawStr(inString);
+		uint32_t	elapsedMicros = micros() - startTime;
+		Serial.print(inLabel);
+		Serial.print(F(", "));
+		Serial.print(kWindowSizes[i]);
+		Serial.print(F("B window: "));
+		Serial.print(eeprom.ReadTransactions());
+		Serial.print(F(" transactions, "));
+		Serial.print(dataStream.CacheHits());
+		Serial.print(F(" hits, "));
+		Serial.print(dataStream.CacheMisses());
+		Serial.print(F(" misses, "));
+		Serial.print(elapsedMicros);
+		Serial.println(F(" us"));
+	}
+}
+
+/********************************** setup *************************************/
+void setup(void)
+{
+	Serial.begin(115200);
+	Wire.begin();
+
+	LoadGlyphData(Lato_Regular_14::glyphData, sizeof(Lato_Regular_14::glyphData));
+	RunTest("8-bit", &Lato_Regular_14::fontHeader, Lato_Regular_14::charcodeRun,
+		Lato_Regular_14::glyphDataCheckpoint, Lato_Regular_14::glyphDataDelta,
+			sizeof(Lato_Regular_14::glyphData), &display16, kClockStr);
+
+	LoadGlyphData(Lato_Regular_14_1bR::glyphData, sizeof(Lato_Regular_14_1bR::glyphData));
+	RunTest("1-bit rotated", &Lato_Regular_14_1bR::fontHeader,
+		Lato_Regular_14_1bR::charcodeRun, Lato_Regular_14_1bR::glyphDataCheckpoint,
+			Lato_Regular_14_1bR::glyphDataDelta,
+				sizeof(Lato_Regular_14_1bR::glyphData), &display1, kClockStr);
+
+	/*
+	*	Packed vs page aligned.  The aligned layout only pays off when an
+	*	entry no longer straddles a page, so compare with a window.
+	*/
+	LoadGlyphData(Lato_Regular_14::glyphData, sizeof(Lato_Regular_14::glyphData));
+	RunTest("8-bit packed", &Lato_Regular_14::fontHeader, Lato_Regular_14::charcodeRun,
+		Lato_Regular_14::glyphDataCheckpoint, Lato_Regular_14::glyphDataDelta,
+			sizeof(Lato_Regular_14::glyphData), &display16, kFoxStr);
+
+	LoadGlyphData(Lato_Regular_14_P32::glyphData, sizeof(Lato_Regular_14_P32::glyphData));
+	RunTest("8-bit page aligned", &Lato_Regular_14_P32::fontHeader,
+		Lato_Regular_14_P32::charcodeRun, Lato_Regular_14_P32::glyphDataCheckpoint,
+			Lato_Regular_14_P32::glyphDataDelta,
+				sizeof(Lato_Regular_14_P32::glyphData), &display16, kFoxStr);
+}
+
+
+/********************************** loop ***********************************/
+void loop()
+{
+}
@@ -0,0 +1,96 @@
+// Subset font created by SubsetFontCreator
+// For subset: "  0:TTbcefhikknoqruuwx"
+
+#ifndef Lato_Regular_14_1bR_h
+#define Lato_Regular_14_1bR_h
+
+#include "XFontGlyph.h"
+#include "XFontR1BitDataStream.h"
+
+namespace Lato_Regular_14_1bR
+{
+	const FontHeader	fontHeader PROGMEM =
+	{
+		1,		// version, 1 = 16 bit charcodes, 2 = charcode planes, 3 = 16 bit metrics
+		1,		// oneBit, 1 = 1 bit per pixel, 0 = 8 bit (antialiased)
+		1,		// rotated, glyph data is rotated (applies to 1 bit only)
+		0,		// horizontal, addressing for rotated data, else vertical
+		0,		// monospaced, fixed width font (for this subset)
+		14,		// ascent, font in pixels
+		-3,		// descent, font in pixels
+		17,		// height, font height (ascent+descent+leading) in pixels
+		11,		// width, widest glyph advanceX within subset in pixels
+		12,		// numCharcodeRuns
+		27		// numCharCodes
+	};
+	
+	const CharcodeRun	charcodeRun[] PROGMEM = // {start, entryIndex}, ...
+	{
+		{0x0020, 0}, {0x0030, 1}, {0x0054, 12}, {0x0062, 13}, {0x0065, 15},
+		{0x0068, 17}, {0x006B, 19}, {0x006E, 20}, {0x0071, 22}, {0x0075, 24},
+		{0x0077, 25}, {0xFFFF, 27}
+	};
+	
+	const uint16_t	glyphDataCheckpoint[] PROGMEM = // offset of every 16th entry
+	{
+		0x0000, 0x00C7
+	};
+	
+	const uint8_t	glyphDataDelta[] PROGMEM = // size of each entry
+	{
+		0x06, 0x0F, 0x0D, 0x0D, 0x0D, 0x0F, 0x0D, 0x0E, 0x0E, 0x0D, 0x0E, 0x07,
+		0x0F, 0x0D, 0x0A, 0x0B, 0x0C, 0x0D, 0x08, 0x0D, 0x0B, 0x0C, 0x0D, 0x09,
+		0x0B, 0x0F, 0x0C
+	};
+	
+	const uint8_t	glyphData[] PROGMEM =
+	{
+		0x03, 0x00, 0x0D, 0x01, 0x01, 0x00, 0x08, 0x00, 0x04, 0x0A, 0x08, 0x30,
+		0xF8, 0x37, 0x70, 0x80, 0x01, 0x0E, 0xEC, 0x1F, 0x1E, 0x08, 0x01, 0x04,
+		0x0A, 0x06, 0x04, 0x10, 0x28, 0xE0, 0xFF, 0x00, 0x02, 0x08, 0x08, 0x01,
+		0x04, 0x0A, 0x06, 0x06, 0x0E, 0x1C, 0x68, 0x98, 0x33, 0x7A, 0x08, 0x08,
+		0x01, 0x04, 0x0A, 0x06, 0x86, 0x0D, 0x1C, 0x60, 0x84, 0x11, 0xBA, 0x07,
+		0x08, 0x00, 0x04, 0x0A, 0x08, 0x40, 0x80, 0x81, 0x05, 0x13, 0x42, 0xFC,
+		0x0F, 0x04, 0x10, 0x08, 0x01, 0x04, 0x0A, 0x06, 0x10, 0x7F, 0x18, 0x61,
+		0x84, 0x31, 0x87, 0x07, 0x08, 0x01, 0x04, 0x0A, 0x07, 0xF0, 0xE1, 0xCC,
+		0xE1, 0x84, 0x11, 0x82, 0x07, 0x04, 0x08, 0x01, 0x04, 0x0A, 0x07, 0x01,
+		0x04, 0x1C, 0x5C, 0x1C, 0x1D, 0x1C, 0x10, 0x00, 0x08, 0x01, 0x04, 0x0A,
+		0x06, 0xEE, 0xAD, 0x1C, 0x61, 0x84, 0x1B, 0xBA, 0x07, 0x08, 0x01, 0x04,
+		0x0A, 0x07, 0x1E, 0xCC, 0x18, 0x72, 0x68, 0x61, 0xF8, 0x80, 0x00, 0x04,
+		0x01, 0x07, 0x07, 0x02, 0xC1, 0x20, 0x08, 0x00, 0x04, 0x0A, 0x08, 0x01,
+		0x04, 0x10, 0xC0, 0xFF, 0xFF, 0x07, 0x10, 0x40, 0x00, 0x08, 0x01, 0x04,
+		0x0A, 0x06, 0xFF, 0x43, 0x84, 0x20, 0x82, 0x18, 0xC3, 0x07, 0x07, 0x01,
+		0x07, 0x07, 0x05, 0xBE, 0x61, 0x30, 0x38, 0x06, 0x07, 0x01, 0x07, 0x07,
+		0x06, 0xBE, 0x64, 0x32, 0xA9, 0x64, 0x01, 0x05, 0x00, 0x04, 0x0A, 0x05,
+		0x08, 0xF8, 0xFF, 0x7F, 0x02, 0x09, 0x00, 0x08, 0x01, 0x04, 0x0A, 0x06,
+		0xFF, 0x43, 0x80, 0x00, 0x02, 0x18, 0xC0, 0x0F, 0x04, 0x01, 0x04, 0x0A,
+		0x02, 0xF9, 0x07, 0x00, 0x07, 0x01, 0x04, 0x0A, 0x06, 0xFF, 0x03, 0x01,
+		0x0E, 0x6C, 0x18, 0x23, 0x08, 0x08, 0x01, 0x07, 0x07, 0x06, 0x7F, 0x41,
+		0x20, 0x30, 0xF0, 0x03, 0x08, 0x00, 0x07, 0x07, 0x07, 0x08, 0x5F, 0x30,
+		0x18, 0x1C, 0xFB, 0x00, 0x08, 0x00, 0x07, 0x09, 0x07, 0x08, 0x7C, 0x04,
+		0x09, 0x12, 0x44, 0xC4, 0x7F, 0x06, 0x01, 0x07, 0x07, 0x04, 0x7F, 0x41,
+		0x20, 0x00, 0x08, 0x01, 0x07, 0x07, 0x06, 0x3F, 0x20, 0x10, 0x08, 0xFA,
+		0x03, 0x0B, 0x00, 0x07, 0x07, 0x0B, 0x81, 0x07, 0x1C, 0xEE, 0x18, 0x70,
+		0xC0, 0xF8, 0x43, 0x00, 0x07, 0x00, 0x07, 0x07, 0x07, 0xC1, 0xB1, 0x0D,
+		0x61, 0x1B, 0x07, 0x01
+	};
+	
+	// Usage: Copy the 3 commented lines to your code, removing the comments.
+	//#include "XFont.h"
+	//XFont xFont;
+	//#include "Lato-Regular_14_1bR.h"
+	
+	// Leave the next 3 lines here, as is.
+	DataStream_P	dataStream(glyphData, sizeof(glyphData));
+	XFontR1BitDataStream xFontDataStream(&xFont, &dataStream);
+	XFont::Font font(&fontHeader, charcodeRun, glyphDataCheckpoint, &xFontDataStream, nullptr, glyphDataDelta);
+	
+	// The display needs to be set before using xFont.  This only needs
+	// to be done once at the beginning of the program.
+	// Use xFont.SetDisplay(&display, &Lato_Regular_14_1bR::font); to do this.
+	// To change to this font anywhere after setting the display,
+	// use: xFont.SetFont(&Lato_Regular_14_1bR::font);
+}
+
+#endif // Lato_Regular_14_1bR_h
+
@@ -0,0 +1,212 @@
+// Subset font created by SubsetFontCreator
+// For subset: "  0:TTbcefhikknoqruuwx"
+
+#ifndef Lato_Regular_14_P32_h
+#define Lato_Regular_14_P32_h
+
+#include "XFontGlyph.h"
+#include "XFont16BitDataStream.h"
+
+namespace Lato_Regular_14_P32
+{
+	const FontHeader	fontHeader PROGMEM =
+	{
+		1,		// version, 1 = 16 bit charcodes, 2 = charcode planes, 3 = 16 bit metrics
+		0,		// oneBit, 1 = 1 bit per pixel, 0 = 8 bit (antialiased)
+		0,		// rotated, glyph data is rotated (applies to 1 bit only)
+		0,		// horizontal, addressing for rotated data, else vertical
+		0,		// monospaced, fixed width font (for this subset)
+		14,		// ascent, font in pixels
+		-3,		// descent, font in pixels
+		17,		// height, font height (ascent+descent+leading) in pixels
+		11,		// width, widest glyph advanceX within subset in pixels
+		12,		// numCharcodeRuns
+		27		// numCharCodes
+	};
+	
+	const CharcodeRun	charcodeRun[] PROGMEM = // {start, entryIndex}, ...
+	{
+		{0x0020, 0}, {0x0030, 1}, {0x0054, 12}, {0x0062, 13}, {0x0065, 15},
+		{0x0068, 17}, {0x006B, 19}, {0x006E, 20}, {0x0071, 22}, {0x0075, 24},
+		{0x0077, 25}, {0xFFFF, 27}
+	};
+	
+	const uint16_t	glyphDataCheckpoint[] PROGMEM = // offset of every 16th entry
+	{
+		0x0000, 0x0420
+	};
+	
+	const uint8_t	glyphDataDelta[] PROGMEM = // size of each entry
+	{
+		0x05, 0x52, 0x49, 0x4C, 0x54, 0x48, 0x48, 0x50, 0x40, 0x60, 0x4B, 0x15,
+		0x3A, 0x46, 0x40, 0x40, 0x40, 0x40, 0x20, 0x46, 0x3A, 0x3E, 0x42, 0x28,
+		0x38, 0x60, 0x37
+	};
+	
+	const uint8_t	glyphData[] PROGMEM =
+	{
+		0x03, 0x00, 0x0E, 0x00, 0x00, 0x08, 0x00, 0x04, 0x0A, 0x08, 0xE6, 0x00,
+		0x0D, 0x9C, 0xEF, 0xF2, 0xA8, 0x17, 0x00, 0x00, 0xB2, 0xBB, 0x21, 0x1A,
+		0xA9, 0xCB, 0x03, 0x2F, 0xFD, 0x1E, 0x00, 0x00, 0x0E, 0xF5, 0x4E, 0x71,
+		0xD3, 0x04, 0x00, 0xFC, 0xBA, 0x90, 0x8C, 0xB9, 0x04, 0x00, 0xFC, 0x9E,
+		0xAC, 0x8D, 0xB9, 0x04, 0x00, 0xFC, 0x9F, 0xAC, 0x72, 0xD3, 0x04, 0x00,
+		0xE6, 0xBA, 0x91, 0x30, 0xFD, 0x1E, 0x00, 0x00, 0x0E, 0xF5, 0x4F, 0x00,
+		0xB4, 0xBB, 0x21, 0x1A, 0xA9, 0xCD, 0x03, 0x00, 0x0E, 0x9D, 0xEF, 0xF3,
+		0xA9, 0x17, 0x00, 0x08, 0x01, 0x04, 0x0A, 0x07, 0xFB, 0x00, 0x00, 0x42,
+		0xEF, 0x68, 0x03, 0x00, 0xEE, 0x60, 0xF4, 0xF3, 0x68, 0x00, 0x00, 0x56,
+		0xEA, 0x3D, 0xD3, 0x68, 0x00, 0x00, 0x09, 0x19, 0x00, 0xD4, 0x68, 0x05,
+		0x00, 0xFE, 0xD4, 0x68, 0x05, 0x00, 0xFE, 0xD4, 0x68, 0x05, 0x00, 0xFE,
+		0xD4, 0x68, 0x05, 0x00, 0xFE, 0xD4, 0x68, 0x05, 0x00, 0xFE, 0xD4, 0x68,
+		0x03, 0x00, 0xFF, 0xFC, 0x04, 0xFF, 0xFF, 0x64, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x0A, 0x08, 0xE8, 0x00, 0x06,
+		0x88, 0xE3, 0xF1, 0xB6, 0x24, 0x00, 0x00, 0x90, 0xC8, 0x26, 0x10, 0x9C,
+		0xD8, 0x02, 0x01, 0xD2, 0x33, 0x00, 0x00, 0x1E, 0xFF, 0x26, 0x05, 0x00,
+		0xFD, 0x34, 0xFF, 0x19, 0x05, 0x00, 0xFE, 0xB0, 0xB7, 0x05, 0x00, 0xFD,
+		0x81, 0xE6, 0x1B, 0x04, 0x00, 0xFD, 0x7D, 0xEB, 0x2B, 0x04, 0x00, 0xFD,
+		0x7E, 0xED, 0x30, 0x04, 0x00, 0xFD, 0x7F, 0xF0, 0x33, 0x04, 0x00, 0xFC,
+		0x36, 0xFF, 0xF5, 0xFB, 0x03, 0xFF, 0xFF, 0x60, 0x08, 0x00, 0x04, 0x0A,
+		0x08, 0xE8, 0x00, 0x04, 0x82, 0xE0, 0xF5, 0xCA, 0x44, 0x00, 0x00, 0x88,
+		0xCD, 0x28, 0x0A, 0x72, 0xF6, 0x14, 0x00, 0x7C, 0x2C, 0x00, 0x00, 0x04,
+		0xFD, 0x36, 0x03, 0x00, 0xFB, 0x01, 0x17, 0x85, 0xCE, 0x06, 0x03, 0x00,
+		0xFC, 0x54, 0xFF, 0xE7, 0x36, 0x05, 0x00, 0xFC, 0x13, 0x7A, 0xF4, 0x20,
+		0x06, 0x00, 0xE6, 0xD3, 0x6D, 0x17, 0xE1, 0x1B, 0x00, 0x00, 0x01, 0xDE,
+		0x66, 0x00, 0xB6, 0xBD, 0x20, 0x12, 0x88, 0xE7, 0x13, 0x00, 0x13, 0xA0,
+		0xE8, 0xF0, 0xB6, 0x2A, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x0A,
+		0x08, 0x04, 0x00, 0xFD, 0x41, 0xFC, 0x54, 0x04, 0x00, 0xFC, 0x1E, 0xE4,
+		0xE6, 0x54, 0x03, 0x00, 0xFB, 0x08, 0xCC, 0x66, 0xC7, 0x54, 0x03, 0x00,
+		0xE9, 0xA1, 0x9B, 0x00, 0xC8, 0x54, 0x00, 0x00, 0x6D, 0xC9, 0x07, 0x00,
+		0xC8, 0x54, 0x00, 0x3D, 0xE4, 0x1C, 0x00, 0x00, 0xC8, 0x54, 0x00, 0x9C,
+		0x06, 0xFF, 0xFF, 0xD2, 0x05, 0x00, 0xFE, 0xC8, 0x54, 0x06, 0x00, 0xFE,
+		0xC8, 0x54, 0x06, 0x00, 0xFD, 0xC8, 0x54, 0x00, 0x08, 0x00, 0x04, 0x0A,
+		0x08, 0xFD, 0x00, 0x03, 0xF9, 0x03, 0xFF, 0xFB, 0xBF, 0x00, 0x00, 0x26,
+		0xE4, 0x06, 0x00, 0xFE, 0x4F, 0xBE, 0x06, 0x00, 0xFE, 0x78, 0x98, 0x06,
+		0x00, 0xF2, 0xA2, 0xEF, 0xF3, 0xE9, 0xA8, 0x1C, 0x00, 0x00, 0x1B, 0x29,
+		0x07, 0x25, 0xB8, 0xC8, 0x06, 0x00, 0xFD, 0x2E, 0xFF, 0x17, 0x05, 0x00,
+		0xED, 0x3D, 0xFC, 0x10, 0x08, 0x85, 0x35, 0x07, 0x2C, 0xCC, 0x93, 0x00,
+		0x06, 0x7C, 0xDB, 0xF8, 0xDA, 0x7A, 0x05, 0x00, 0x08, 0x00, 0x04, 0x0A,
+		0x08, 0x04, 0x00, 0xFD, 0x99, 0xDA, 0x0E, 0x04, 0x00, 0xFD, 0x64, 0xF7,
+		0x2F, 0x04, 0x00, 0xFD, 0x2C, 0xF6, 0x63, 0x04, 0x00, 0xFD, 0x0A, 0xD7,
+		0xA0, 0x05, 0x00, 0xEE, 0x8E, 0xFC, 0xCF, 0xF5, 0xD2, 0x4D, 0x00, 0x0E,
+		0xF8, 0xB1, 0x22, 0x10, 0x7C, 0xF9, 0x29, 0x37, 0xFE, 0x11, 0x03, 0x00,
+		0xFB, 0xD6, 0x70, 0x1A, 0xFE, 0x0E, 0x03, 0x00, 0xEE, 0xD7, 0x62, 0x00,
+		0xB6, 0xA4, 0x17, 0x11, 0x83, 0xE7, 0x14, 0x00, 0x12, 0x9D, 0xE7, 0xED,
+		0xB2, 0x27, 0x00, 0x00, 0x08, 0x00, 0x04, 0x0A, 0x08, 0xFF, 0x35, 0x06,
+		0xFF, 0xFF, 0x93, 0x05, 0x00, 0xFD, 0x13, 0xEE, 0x45, 0x05, 0x00, 0xFE,
+		0x87, 0xC7, 0x05, 0x00, 0xFD, 0x13, 0xF3, 0x48, 0x05, 0x00, 0xFE, 0x88,
+		0xC9, 0x05, 0x00, 0xFD, 0x14, 0xF4, 0x4A, 0x05, 0x00, 0xFE, 0x8A, 0xCB,
+		0x05, 0x00, 0xFD, 0x15, 0xF4, 0x4D, 0x05, 0x00, 0xFE, 0x8B, 0xCD, 0x05,
+		0x00, 0xFD, 0x16, 0xEF, 0x48, 0x04, 0x00, 0x00, 0x08, 0x00, 0x04, 0x0A,
+		0x08, 0xB0, 0x00, 0x16, 0xA4, 0xEA, 0xEE, 0xAF, 0x20, 0x00, 0x00, 0xB7,
+		0xAE, 0x19, 0x13, 0x9C, 0xCF, 0x00, 0x00, 0xF0, 0x47, 0x00, 0x00, 0x2F,
+		0xFF, 0x08, 0x00, 0xA2, 0xB0, 0x17, 0x11, 0x9B, 0xBA, 0x00, 0x00, 0x13,
+		0xD1, 0xFF, 0xFF, 0xE0, 0x1F, 0x00, 0x04, 0xCF, 0xA5, 0x19, 0x13, 0x93,
+		0xDF, 0x0D, 0x40, 0xFE, 0x0F, 0x00, 0x00, 0x02, 0xF3, 0x5B, 0x3E, 0xFE,
+		0x0C, 0x00, 0x00, 0x02, 0xF0, 0x57, 0x09, 0xDC, 0xA3, 0x17, 0x13, 0x90,
+		0xE9, 0x14, 0x00, 0x23, 0xAD, 0xEC, 0xEE, 0xB7, 0x2E, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x01, 0x04, 0x0A,
+		0x07, 0xF0, 0x01, 0x6B, 0xD6, 0xF3, 0xC4, 0x39, 0x00, 0x6D, 0xDC, 0x35,
+		0x0C, 0x65, 0xF1, 0x1B, 0xD7, 0x61, 0x03, 0x00, 0xFC, 0xC4, 0x6B, 0xE6,
+		0x5E, 0x03, 0x00, 0xF0, 0xC1, 0x83, 0x9E, 0xD3, 0x27, 0x0D, 0x6B, 0xFF,
+		0x4F, 0x0F, 0xA3, 0xEF, 0xE2, 0xD4, 0xD2, 0x03, 0x03, 0x00, 0xFD, 0x2F,
+		0xF1, 0x34, 0x03, 0x00, 0xFD, 0x10, 0xDC, 0x7C, 0x03, 0x00, 0xFC, 0x01,
+		0xB1, 0xC4, 0x03, 0x03, 0x00, 0xFD, 0x79, 0xEA, 0x21, 0x03, 0x00, 0x04,
+		0x00, 0x07, 0x07, 0x03, 0xFD, 0x08, 0xDE, 0x6F, 0x0F, 0x00, 0xFD, 0x08,
+		0xDE, 0x6F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x04, 0x0A,
+		0x09, 0xFF, 0xCC, 0x07, 0xFF, 0xFF, 0x0C, 0x03, 0x00, 0xFE, 0x8C, 0xD0,
+		0x07, 0x00, 0xFE, 0x8C, 0xD0, 0x07, 0x00, 0xFE, 0x8C, 0xD0, 0x07, 0x00,
+		0xFE, 0x8C, 0xD0, 0x07, 0x00, 0xFE, 0x8C, 0xD0, 0x07, 0x00, 0xFE, 0x8C,
+		0xD0, 0x07, 0x00, 0xFE, 0x8C, 0xD0, 0x07, 0x00, 0xFE, 0x8C, 0xD0, 0x07,
+		0x00, 0xFE, 0x8C, 0xD0, 0x04, 0x00, 0x08, 0x01, 0x04, 0x0A, 0x07, 0xFE,
+		0xF0, 0x50, 0x05, 0x00, 0xFE, 0xF0, 0x50, 0x05, 0x00, 0xFE, 0xF0, 0x50,
+		0x05, 0x00, 0xCF, 0xF0, 0x67, 0xB7, 0xF6, 0xCF, 0x35, 0x00, 0xF0, 0xCA,
+		0x29, 0x0F, 0x9C, 0xDE, 0x04, 0xF0, 0x50, 0x00, 0x00, 0x19, 0xFF, 0x31,
+		0xF0, 0x50, 0x00, 0x00, 0x01, 0xFD, 0x4A, 0xF0, 0x50, 0x00, 0x00, 0x23,
+		0xFF, 0x29, 0xF0, 0xA7, 0x17, 0x1A, 0xB4, 0xC3, 0x00, 0xEF, 0x6C, 0xDE,
+		0xF8, 0xB2, 0x16, 0x00, 0x07, 0x00, 0x07, 0x07, 0x07, 0xEF, 0x00, 0x24,
+		0xB8, 0xF7, 0xE0, 0x83, 0x05, 0x09, 0xE2, 0x98, 0x14, 0x18, 0x65, 0x03,
+		0x53, 0xF1, 0x07, 0x04, 0x00, 0xFE, 0x72, 0xD4, 0x05, 0x00, 0xFD, 0x53,
+		0xF0, 0x06, 0x04, 0x00, 0xF2, 0x0C, 0xE4, 0x94, 0x11, 0x1B, 0x83, 0x11,
+		0x00, 0x2C, 0xBE, 0xF4, 0xE3, 0x80, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x07,
+		0x07, 0xEA, 0x00, 0x24, 0xB7, 0xF6, 0xDD, 0x67, 0x00, 0x0B, 0xE2, 0x8F,
+		0x10, 0x2C, 0xDC, 0x44, 0x57, 0xEC, 0x03, 0x00, 0x00, 0x6E, 0x9E, 0x71,
+		0x05, 0xFF, 0xFD, 0xB7, 0x4E, 0xD9, 0x05, 0x00, 0xF2, 0x08, 0xDB, 0x80,
+		0x12, 0x0D, 0x4E, 0x3D, 0x00, 0x22, 0xB1, 0xEE, 0xF1, 0xAD, 0x23, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x05, 0x00, 0x04, 0x0A, 0x05, 0xF0, 0x00, 0x10, 0xB0, 0xF3, 0x86, 0x00,
+		0x86, 0xCA, 0x15, 0x00, 0x00, 0xB1, 0x87, 0x00, 0x00, 0xBB, 0x03, 0xFF,
+		0xFC, 0x90, 0x00, 0xB4, 0x90, 0x03, 0x00, 0xFE, 0xB4, 0x90, 0x03, 0x00,
+		0xFE, 0xB4, 0x90, 0x03, 0x00, 0xFE, 0xB4, 0x90, 0x03, 0x00, 0xFE, 0xB4,
+		0x90, 0x03, 0x00, 0xFC, 0xB4, 0x90, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x08, 0x01, 0x04, 0x0A, 0x06, 0xFE, 0xFC, 0x44,
+		0x04, 0x00, 0xFE, 0xFC, 0x44, 0x04, 0x00, 0xFE, 0xFC, 0x44, 0x04, 0x00,
+		0xD6, 0xFC, 0x68, 0xC2, 0xF6, 0xC5, 0x24, 0xFC, 0xC3, 0x26, 0x10, 0xB7,
+		0xB2, 0xFC, 0x44, 0x00, 0x00, 0x5B, 0xE4, 0xFC, 0x44, 0x00, 0x00, 0x54,
+		0xEC, 0xFC, 0x44, 0x00, 0x00, 0x54, 0xEC, 0xFC, 0x44, 0x00, 0x00, 0x54,
+		0xEC, 0xFC, 0x44, 0x00, 0x00, 0x54, 0xEC, 0x00, 0x04, 0x00, 0x04, 0x0A,
+		0x03, 0xFD, 0x06, 0xDB, 0x79, 0x07, 0x00, 0xEC, 0xD8, 0x68, 0x00, 0xD8,
+		0x68, 0x00, 0xD8, 0x68, 0x00, 0xD8, 0x68, 0x00, 0xD8, 0x68, 0x00, 0xD8,
+		0x68, 0x00, 0xD8, 0x68, 0x07, 0x01, 0x04, 0x0A, 0x07, 0xFE, 0xF0, 0x50,
+		0x05, 0x00, 0xFE, 0xF0, 0x50, 0x05, 0x00, 0xFE, 0xF0, 0x50, 0x05, 0x00,
+		0xE7, 0xF0, 0x50, 0x00, 0x10, 0xD0, 0x7E, 0x00, 0xF0, 0x50, 0x06, 0xBF,
+		0x9D, 0x00, 0x00, 0xF0, 0x53, 0xA7, 0xB8, 0x04, 0x00, 0x00, 0xF0, 0xFF,
+		0xFE, 0x36, 0x03, 0x00, 0xEB, 0xF0, 0x52, 0x8D, 0xE0, 0x17, 0x00, 0x00,
+		0xF0, 0x50, 0x01, 0xA3, 0xC9, 0x09, 0x00, 0xF0, 0x50, 0x00, 0x05, 0xB4,
+		0xAC, 0x01, 0x08, 0x01, 0x07, 0x07, 0x06, 0xD6, 0xF9, 0x3E, 0xC4, 0xF6,
+		0xC5, 0x24, 0xFC, 0xBF, 0x26, 0x10, 0xB7, 0xB2, 0xFC, 0x44, 0x00, 0x00,
+		0x5B, 0xE4, 0xFC, 0x44, 0x00, 0x00, 0x54, 0xEC, 0xFC, 0x44, 0x00, 0x00,
+		0x54, 0xEC, 0xFC, 0x44, 0x00, 0x00, 0x54, 0xEC, 0xFC, 0x44, 0x00, 0x00,
+		0x54, 0xEC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x08, 0x00, 0x07, 0x07, 0x08, 0xE6, 0x00, 0x23, 0xB1, 0xED, 0xE4, 0x97,
+		0x0F, 0x00, 0x0A, 0xE0, 0x91, 0x13, 0x1F, 0xBE, 0xB0, 0x00, 0x56, 0xEE,
+		0x05, 0x00, 0x00, 0x2F, 0xFF, 0x19, 0x76, 0xD3, 0x03, 0x00, 0xE5, 0x0C,
+		0xFF, 0x39, 0x56, 0xEE, 0x04, 0x00, 0x00, 0x2E, 0xFF, 0x1A, 0x0B, 0xE1,
+		0x8F, 0x12, 0x1E, 0xBC, 0xB3, 0x00, 0x00, 0x25, 0xB6, 0xEF, 0xE6, 0x9C,
+		0x10, 0x00, 0x08, 0x00, 0x07, 0x09, 0x07, 0xE9, 0x00, 0x29, 0xC6, 0xF6,
+		0xC7, 0x7D, 0xBF, 0x0B, 0xE6, 0x93, 0x12, 0x26, 0xC6, 0xC0, 0x58, 0xF0,
+		0x06, 0x00, 0x00, 0x7C, 0xC0, 0x77, 0xD3, 0x03, 0x00, 0xFC, 0x7C, 0xC0,
+		0x62, 0xE7, 0x03, 0x00, 0xF0, 0x7C, 0xC0, 0x1C, 0xF9, 0x6F, 0x0C, 0x3F,
+		0xDF, 0xC0, 0x00, 0x55, 0xDD, 0xF5, 0xA0, 0x88, 0xC0, 0x05, 0x00, 0xFE,
+		0x7C, 0xC0, 0x05, 0x00, 0xFE, 0x7C, 0xC0, 0x00, 0x06, 0x01, 0x07, 0x07,
+		0x05, 0xF4, 0xF9, 0x49, 0xD2, 0xFA, 0x34, 0xFC, 0xCA, 0x23, 0x00, 0x00,
+		0xFC, 0x4E, 0x03, 0x00, 0xFE, 0xFC, 0x44, 0x03, 0x00, 0xFE, 0xFC, 0x44,
+		0x03, 0x00, 0xFE, 0xFC, 0x44, 0x03, 0x00, 0xFE, 0xFC, 0x44, 0x03, 0x00,
+		0x08, 0x00, 0x07, 0x07, 0x07, 0xCF, 0x24, 0xFF, 0x18, 0x00, 0x00, 0x7C,
+		0xC0, 0x24, 0xFF, 0x18, 0x00, 0x00, 0x7C, 0xC0, 0x24, 0xFF, 0x18, 0x00,
+		0x00, 0x7C, 0xC0, 0x24, 0xFF, 0x18, 0x00, 0x00, 0x7C, 0xC0, 0x1D, 0xFF,
+		0x1E, 0x00, 0x00, 0x7C, 0xC0, 0x03, 0xEC, 0x82, 0x0C, 0x41, 0xDA, 0xC0,
+		0x00, 0x4A, 0xDC, 0xF6, 0xA8, 0x63, 0xBF, 0x00, 0x0B, 0x00, 0x07, 0x07,
+		0x0B, 0xC0, 0xBF, 0x84, 0x00, 0x00, 0x4A, 0xF8, 0x1B, 0x00, 0x00, 0xBA,
+		0x79, 0x6B, 0xD7, 0x00, 0x00, 0xA3, 0xED, 0x6C, 0x00, 0x12, 0xFB, 0x25,
+		0x18, 0xFD, 0x24, 0x07, 0xEC, 0x68, 0xBF, 0x00, 0x5D, 0xD1, 0x00, 0x00,
+		0xC3, 0x71, 0x4D, 0xB9, 0x0A, 0xF1, 0x15, 0xAC, 0x7D, 0x00, 0x00, 0x6F,
+		0xBE, 0xA1, 0x63, 0x00, 0xAA, 0x6B, 0xF2, 0x29, 0x00, 0x00, 0x1C, 0xF4,
+		0xE7, 0x12, 0x00, 0x54, 0xE2, 0xD5, 0x04, 0x00, 0xF7, 0xC6, 0xAF, 0x00,
+		0x00, 0x0A, 0xEF, 0x81, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0x07, 0x07,
+		0x07, 0xEC, 0x5C, 0xEE, 0x1A, 0x00, 0x0B, 0xDA, 0x65, 0x00, 0xAA, 0xB0,
+		0x00, 0x94, 0xB1, 0x00, 0x00, 0x12, 0xE6, 0x8D, 0xE6, 0x15, 0x03, 0x00,
+		0xFD, 0x7D, 0xFF, 0x8A, 0x03, 0x00, 0xEC, 0x1C, 0xED, 0x79, 0xF4, 0x28,
+		0x00, 0x01, 0xBD, 0x8F, 0x00, 0x8F, 0xCA, 0x04, 0x72, 0xD1, 0x08, 0x00,
+		0x0A, 0xD8, 0x7F
+	};
+	
+	// Usage: Copy the 3 commented lines to your code, removing the comments.
+	//#include "XFont.h"
+	//XFont xFont;
+	//#include "Lato-Regular_14_P32.h"
+	
+	// Leave the next 3 lines here, as is.
+	DataStream_P	dataStream(glyphData, sizeof(glyphData));
+	XFont16BitDataStream xFontDataStream(&xFont, &dataStream);
+	XFont::Font font(&fontHeader, charcodeRun, glyphDataCheckpoint, &xFontDataStream, nullptr, glyphDataDelta);
+	
+	// The display needs to be set before using xFont.  This only needs
+	// to be done once at the beginning of the program.
+	// Use xFont.SetDisplay(&display, &Lato_Regular_14_P32::font); to do this.
+	// To change to this font anywhere after setting the display,
+	// use: xFont.SetFont(&Lato_Regular_14_P32::font);
+}
+
+#endif // Lato_Regular_14_P32_h
+
@@ -110,7 +110,7 @@ void loop(void)
 			}
 			case 'D':	// Dump Glyph Header (last character loaded/drawn)
 			{
-				const GlyphHeader&	gh = xFont.Glyph();
+				const GlyphHeader16&	gh = xFont.Glyph();
 				char charCode = (char)xFont.Charcode();
 				Serial.print(F("\n\'"));
 				Serial.print(charCode);
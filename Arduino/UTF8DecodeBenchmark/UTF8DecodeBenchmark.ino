@@ -0,0 +1,86 @@
+#include <Arduino.h>
+
+#include "XFont.h"
+
+const char		kASCIIStr[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNO"
+							"PQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+const char		kMixedStr[] = "D\xC3\xA9j\xC3\xA0 vu, na\xC3\xAFve caf\xC3\xA9 \xE2\x80\xA6 "
+							"12:34 \xE2\x84\x83 \xC2\xB1" "5\xC2\xB0 stra\xC3\x9F" "e";
+const uint16_t	kIterations = 100;
+uint32_t		checksum;	// Keeps the decode loops from being optimized away
+
+/******************************* TimeNextChar *********************************/
+/*
+*	Decodes inUTF8Str one charcode per call, the way the draw loops did before
+*	UTF8Reader.
+*/
+uint32_t TimeNextChar(
+	const char*	inUTF8Str)
+{
+	uint32_t	startTime = micros();
+	for (uint16_t i = 0; i < kIterations; i++)
+	{
+		const char*	strPtr = inUTF8Str;
+		for (uint32_t charcode = XFont::NextChar(strPtr); charcode;
+				charcode = XFont::NextChar(strPtr))
+		{
+			checksum += charcode;
+		}
+	}
+	return(micros() - startTime);
+}
+
+/****************************** TimeUTF8Reader ********************************/
+uint32_t TimeUTF8Reader(
+	const char*	inUTF8Str)
+{
+	uint32_t	startTime = micros();
+	for (uint16_t i = 0; i < kIterations; i++)
+	{
+		XFont::UTF8Reader	reader(inUTF8Str);
+		for (uint32_t charcode = reader.Next(); charcode;
+				charcode = reader.Next())
+		{
+			checksum += charcode;
+		}
+	}
+	return(micros() - startTime);
+}
+
+/****************************** PrintResult ***********************************/
+void PrintResult(
+	const char*		inLabel,
+	const char*		inUTF8Str,
+	uint32_t		inMicros)
+{
+	uint16_t	charcodes = 0;
+	XFont::UTF8Reader	reader(inUTF8Str);
+	while (reader.Next())
+	{
+		charcodes++;
+	}
+	uint32_t	charcodesDecoded = (uint32_t)kIterations * charcodes;
+	Serial.print(inLabel);
+	Serial.print(F(": "));
+	Serial.print((inMicros * 100) / charcodesDecoded);
+	Serial.println(F(" us/100 charcodes"));
+}
+
+/********************************** setup *************************************/
+void setup(void)
+{
+	Serial.begin(115200);
+
+	PrintResult("ASCII NextChar", kASCIIStr, TimeNextChar(kASCIIStr));
+	PrintResult("ASCII UTF8Reader", kASCIIStr, TimeUTF8Reader(kASCIIStr));
+	PrintResult("Mixed NextChar", kMixedStr, TimeNextChar(kMixedStr));
+	PrintResult("Mixed UTF8Reader", kMixedStr, TimeUTF8Reader(kMixedStr));
+	Serial.print(F("Checksum "));
+	Serial.println(checksum);
+}
+
+
+/********************************** loop ***********************************/
+void loop()
+{
+}
@@ -0,0 +1,167 @@
+// Subset font created by SubsetFontCreator
+// For subset: " ~"
+
+#ifndef Lato_Regular_14_1bFixed_h
+#define Lato_Regular_14_1bFixed_h
+
+#include "XFontGlyph.h"
+#include "XFont16BitDataStream.h"
+
+namespace Lato_Regular_14_1bFixed
+{
+	const FontHeader	fontHeader PROGMEM =
+	{
+		1,		// version, currently version = 1
+		1,		// oneBit, 1 = 1 bit per pixel, 0 = 8 bit (antialiased)
+		0,		// rotated, glyph data is rotated (applies to 1 bit only)
+		0,		// horizontal, addressing for rotated data, else vertical
+		0,		// monospaced, fixed width font (for this subset)
+		14,		// ascent, font in pixels
+		-3,		// descent, font in pixels
+		17,		// height, font height (ascent+descent+leading) in pixels
+		14,		// width, widest glyph advanceX within subset in pixels
+		2,		// numCharcodeRuns
+		95		// numCharCodes
+	};
+	
+	const CharcodeRun	charcodeRun[] PROGMEM = // {start, entryIndex}, ...
+	{
+		{0x0020, 0}, {0xFFFF, 95}
+	};
+	
+	const uint16_t	glyphDataOffset[] PROGMEM =
+	{
+		0x0000, 0x0006, 0x000D, 0x0014, 0x0023, 0x0032, 0x0045, 0x0056,
+		0x005C, 0x0066, 0x006F, 0x0076, 0x0081, 0x0087, 0x008D, 0x0093,
+		0x009F, 0x00AE, 0x00BB, 0x00C8, 0x00D5, 0x00E4, 0x00F1, 0x00FF,
+		0x010D, 0x011A, 0x0128, 0x012F, 0x0137, 0x0140, 0x0148, 0x0151,
+		0x015D, 0x0170, 0x0181, 0x018F, 0x019E, 0x01AF, 0x01BC, 0x01C9,
+		0x01D8, 0x01E7, 0x01EF, 0x01FB, 0x020A, 0x0217, 0x022A, 0x0239,
+		0x024B, 0x0259, 0x026D, 0x027C, 0x028A, 0x0299, 0x02A8, 0x02B9,
+		0x02D0, 0x02E1, 0x02F2, 0x0300, 0x030A, 0x0316, 0x031F, 0x0328,
+		0x032E, 0x0334, 0x033E, 0x034B, 0x0355, 0x0363, 0x036E, 0x037A,
+		0x0387, 0x0394, 0x039C, 0x03A6, 0x03B3, 0x03BA, 0x03C8, 0x03D3,
+		0x03DF, 0x03EB, 0x03F8, 0x0401, 0x040B, 0x0417, 0x0422, 0x042E,
+		0x043D, 0x0449, 0x0456, 0x0461, 0x046D, 0x0474, 0x047E, 0x0486
+	};
+	
+	const uint8_t	glyphData[] PROGMEM =
+	{
+		0x03, 0x00, 0x0D, 0x01, 0x01, 0x00, 0x05, 0x02, 0x04, 0x0A, 0x01, 0xFC,
+		0x40, 0x06, 0x01, 0x04, 0x03, 0x03, 0xB6, 0x80, 0x08, 0x00, 0x04, 0x0A,
+		0x08, 0x12, 0x12, 0x14, 0x7F, 0x24, 0x24, 0xFE, 0x28, 0x48, 0x48, 0x08,
+		0x01, 0x03, 0x0D, 0x06, 0x11, 0xED, 0x64, 0xD1, 0xC1, 0xC5, 0x16, 0x97,
+		0x88, 0x20, 0x0B, 0x00, 0x04, 0x0A, 0x0B, 0x70, 0xC9, 0x12, 0x24, 0x25,
+		0x07, 0x40, 0x0B, 0x82, 0x90, 0x91, 0x22, 0x4C, 0x38, 0x0A, 0x01, 0x04,
+		0x0A, 0x09, 0x38, 0x22, 0x10, 0x08, 0x02, 0x06, 0x8A, 0x29, 0x0C, 0x86,
+		0x3C, 0xC0, 0x03, 0x01, 0x04, 0x03, 0x01, 0xE0, 0x04, 0x01, 0x03, 0x0D,
+		0x03, 0x4D, 0x69, 0x24, 0x91, 0x22, 0x04, 0x01, 0x03, 0x0D, 0x02, 0xA9,
+		0x55, 0x5E, 0x80, 0x06, 0x01, 0x04, 0x04, 0x04, 0x4B, 0xF4, 0x08, 0x01,
+		0x06, 0x07, 0x06, 0x10, 0x41, 0x3F, 0x10, 0x41, 0x00, 0x03, 0x01, 0x0D,
+		0x03, 0x01, 0xE0, 0x05, 0x01, 0x09, 0x01, 0x03, 0xE0, 0x03, 0x01, 0x0D,
+		0x01, 0x01, 0x80, 0x05, 0x00, 0x04, 0x0B, 0x05, 0x08, 0x44, 0x22, 0x10,
+		0x88, 0x44, 0x20, 0x08, 0x00, 0x04, 0x0A, 0x08, 0x3C, 0x66, 0x42, 0x43,
+		0xC3, 0xC3, 0x43, 0x42, 0x66, 0x3C, 0x08, 0x01, 0x04, 0x0A, 0x06, 0x10,
+		0xCD, 0x04, 0x10, 0x41, 0x04, 0x11, 0xF0, 0x08, 0x01, 0x04, 0x0A, 0x06,
+		0x7B, 0x38, 0x41, 0x0C, 0x61, 0x08, 0x43, 0xF0, 0x08, 0x01, 0x04, 0x0A,
+		0x06, 0x7B, 0x18, 0x41, 0x18, 0x10, 0x61, 0xC5, 0xE0, 0x08, 0x00, 0x04,
+		0x0A, 0x08, 0x04, 0x0C, 0x14, 0x34, 0x24, 0x44, 0xFF, 0x04, 0x04, 0x04,
+		0x08, 0x01, 0x04, 0x0A, 0x06, 0x7D, 0x04, 0x10, 0xF8, 0x30, 0x41, 0x8F,
+		0xE0, 0x08, 0x01, 0x04, 0x0A, 0x07, 0x18, 0x20, 0x83, 0x0F, 0x98, 0xA1,
+		0xC2, 0xC4, 0xF0, 0x08, 0x01, 0x04, 0x0A, 0x07, 0xFE, 0x08, 0x30, 0x41,
+		0x82, 0x0C, 0x10, 0x60, 0x80, 0x08, 0x01, 0x04, 0x0A, 0x06, 0x7B, 0x38,
+		0x73, 0x3B, 0x18, 0x61, 0xC5, 0xE0, 0x08, 0x01, 0x04, 0x0A, 0x07, 0x79,
+		0x8A, 0x14, 0x3C, 0x4F, 0x82, 0x08, 0x30, 0xC0, 0x04, 0x01, 0x07, 0x07,
+		0x02, 0xC0, 0x0C, 0x04, 0x01, 0x07, 0x09, 0x02, 0xC0, 0x0D, 0x80, 0x08,
+		0x01, 0x06, 0x06, 0x05, 0x08, 0xD9, 0x83, 0x04, 0x08, 0x01, 0x08, 0x03,
+		0x06, 0xFC, 0x0F, 0xC0, 0x08, 0x02, 0x06, 0x06, 0x05, 0x86, 0x0C, 0x36,
+		0x40, 0x06, 0x00, 0x04, 0x0A, 0x05, 0x74, 0x42, 0x11, 0x10, 0x80, 0x01,
+		0x00, 0x0C, 0x01, 0x05, 0x0B, 0x0A, 0x1E, 0x18, 0x6C, 0x0A, 0x39, 0x92,
+		0x68, 0x9A, 0x6A, 0x6E, 0xC0, 0x18, 0x21, 0xF0, 0x0A, 0x00, 0x04, 0x0A,
+		0x09, 0x0C, 0x0E, 0x05, 0x02, 0x43, 0x21, 0x19, 0xFC, 0x82, 0x40, 0xE0,
+		0x40, 0x09, 0x01, 0x04, 0x0A, 0x07, 0xFD, 0x8F, 0x0E, 0x1C, 0x5F, 0xB0,
+		0xE1, 0xC3, 0xF8, 0x0A, 0x01, 0x04, 0x0A, 0x08, 0x3E, 0x61, 0xC0, 0x80,
+		0x80, 0x80, 0x80, 0xC0, 0x61, 0x3E, 0x0B, 0x01, 0x04, 0x0A, 0x09, 0xFC,
+		0x61, 0xB0, 0x58, 0x3C, 0x1E, 0x0F, 0x07, 0x82, 0xC3, 0x7E, 0x00, 0x08,
+		0x01, 0x04, 0x0A, 0x06, 0xFF, 0x0C, 0x30, 0xC3, 0xEC, 0x30, 0xC3, 0xF0,
+		0x08, 0x01, 0x04, 0x0A, 0x06, 0xFF, 0x0C, 0x30, 0xC3, 0xFC, 0x30, 0xC3,
+		0x00, 0x0A, 0x01, 0x04, 0x0A, 0x08, 0x3E, 0x61, 0xC0, 0x80, 0x80, 0x87,
+		0x81, 0xC1, 0x61, 0x3E, 0x0B, 0x01, 0x04, 0x0A, 0x08, 0xC1, 0xC1, 0xC1,
+		0xC1, 0xC1, 0xFF, 0xC1, 0xC1, 0xC1, 0xC1, 0x04, 0x01, 0x04, 0x0A, 0x02,
+		0xFF, 0xFF, 0xF0, 0x06, 0x00, 0x04, 0x0A, 0x05, 0x08, 0x42, 0x10, 0x84,
+		0x21, 0x1F, 0x80, 0x0A, 0x01, 0x04, 0x0A, 0x08, 0xC3, 0xC6, 0xC4, 0xC8,
+		0xD8, 0xF0, 0xD8, 0xCC, 0xC6, 0xC3, 0x07, 0x01, 0x04, 0x0A, 0x06, 0xC3,
+		0x0C, 0x30, 0xC3, 0x0C, 0x30, 0xC3, 0xF0, 0x0D, 0x01, 0x04, 0x0A, 0x0B,
+		0xC0, 0x78, 0x1E, 0x83, 0xD8, 0xF9, 0x17, 0x36, 0xE2, 0x9C, 0x63, 0x84,
+		0x70, 0x0C, 0x0B, 0x01, 0x04, 0x0A, 0x08, 0xC1, 0xC1, 0xA1, 0xB1, 0x99,
+		0x89, 0x85, 0x87, 0x83, 0x81, 0x0B, 0x01, 0x04, 0x0A, 0x0A, 0x3E, 0x18,
+		0x4C, 0x0A, 0x02, 0x80, 0xE0, 0x38, 0x0B, 0x02, 0x61, 0x0F, 0x80, 0x09,
+		0x01, 0x04, 0x0A, 0x07, 0xFD, 0x8F, 0x0E, 0x1C, 0x7F, 0xB0, 0x60, 0xC1,
+		0x80, 0x0B, 0x01, 0x04, 0x0C, 0x0A, 0x3E, 0x18, 0x4C, 0x0A, 0x02, 0x80,
+		0xE0, 0x38, 0x0B, 0x02, 0x61, 0x0F, 0xC0, 0x18, 0x03, 0x09, 0x01, 0x04,
+		0x0A, 0x08, 0xFC, 0xC6, 0xC2, 0xC6, 0xC4, 0xF8, 0xC8, 0xCC, 0xC6, 0xC3,
+		0x07, 0x00, 0x04, 0x0A, 0x07, 0x3C, 0xCD, 0x03, 0x03, 0x81, 0x81, 0x81,
+		0xC4, 0xF0, 0x08, 0x00, 0x04, 0x0A, 0x08, 0xFF, 0x18, 0x18, 0x18, 0x18,
+		0x18, 0x18, 0x18, 0x18, 0x18, 0x0A, 0x01, 0x04, 0x0A, 0x08, 0x81, 0x81,
+		0x81, 0x81, 0x81, 0x81, 0x81, 0xC3, 0x42, 0x3C, 0x0A, 0x00, 0x04, 0x0A,
+		0x09, 0xC0, 0xA0, 0xD0, 0x4C, 0x22, 0x31, 0x90, 0x58, 0x28, 0x0C, 0x06,
+		0x00, 0x0E, 0x00, 0x04, 0x0A, 0x0E, 0xC3, 0x05, 0x0C, 0x34, 0x38, 0x99,
+		0xA2, 0x24, 0x98, 0x93, 0x43, 0xC5, 0x0E, 0x14, 0x18, 0x70, 0x60, 0x80,
+		0x09, 0x00, 0x04, 0x0A, 0x09, 0xC1, 0xB1, 0x88, 0x82, 0x81, 0xC0, 0xE0,
+		0xD8, 0x44, 0x63, 0x60, 0xC0, 0x09, 0x00, 0x04, 0x0A, 0x09, 0xC1, 0xA1,
+		0x88, 0x86, 0xC1, 0x40, 0xC0, 0x20, 0x10, 0x08, 0x04, 0x00, 0x09, 0x01,
+		0x04, 0x0A, 0x07, 0xFE, 0x0C, 0x30, 0x41, 0x86, 0x08, 0x20, 0xC1, 0xFC,
+		0x04, 0x01, 0x03, 0x0D, 0x03, 0xF2, 0x49, 0x24, 0x92, 0x4E, 0x05, 0x00,
+		0x04, 0x0B, 0x05, 0x84, 0x10, 0x82, 0x10, 0x42, 0x10, 0x42, 0x04, 0x01,
+		0x03, 0x0D, 0x02, 0xD5, 0x55, 0x55, 0xC0, 0x08, 0x01, 0x04, 0x05, 0x06,
+		0x30, 0xC4, 0x92, 0x84, 0x06, 0x00, 0x0F, 0x01, 0x06, 0xFC, 0x04, 0x00,
+		0x04, 0x02, 0x03, 0xC4, 0x07, 0x01, 0x07, 0x07, 0x05, 0x74, 0x42, 0xF8,
+		0xCF, 0xA0, 0x08, 0x01, 0x04, 0x0A, 0x06, 0x82, 0x08, 0x2E, 0xCE, 0x18,
+		0x61, 0xCE, 0xE0, 0x07, 0x01, 0x07, 0x07, 0x05, 0x7E, 0x61, 0x08, 0x45,
+		0xE0, 0x08, 0x00, 0x04, 0x0A, 0x07, 0x02, 0x04, 0x09, 0xD4, 0x68, 0x70,
+		0xA1, 0x46, 0x74, 0x07, 0x01, 0x07, 0x07, 0x06, 0x72, 0x28, 0x7F, 0x82,
+		0x17, 0x80, 0x05, 0x00, 0x04, 0x0A, 0x05, 0x3B, 0x19, 0xF6, 0x31, 0x8C,
+		0x63, 0x00, 0x07, 0x00, 0x07, 0x09, 0x07, 0x3E, 0x89, 0x11, 0xC4, 0x0F,
+		0x90, 0xE3, 0x7C, 0x08, 0x01, 0x04, 0x0A, 0x06, 0x82, 0x08, 0x2E, 0xCE,
+		0x18, 0x61, 0x86, 0x10, 0x04, 0x01, 0x04, 0x0A, 0x02, 0xC2, 0xAA, 0xA0,
+		0x04, 0x00, 0x04, 0x0C, 0x03, 0x60, 0x24, 0x92, 0x49, 0x60, 0x07, 0x01,
+		0x04, 0x0A, 0x06, 0x82, 0x08, 0x23, 0x9A, 0xCE, 0x2C, 0x9A, 0x30, 0x04,
+		0x01, 0x04, 0x0A, 0x01, 0xFF, 0xC0, 0x0C, 0x01, 0x07, 0x07, 0x0A, 0xB3,
+		0xB3, 0x28, 0x8E, 0x23, 0x88, 0xE2, 0x38, 0x8C, 0x08, 0x01, 0x07, 0x07,
+		0x06, 0xBB, 0x38, 0x61, 0x86, 0x18, 0x40, 0x08, 0x00, 0x07, 0x07, 0x07,
+		0x3C, 0x8D, 0x0E, 0x14, 0x28, 0xCF, 0x00, 0x08, 0x01, 0x07, 0x09, 0x06,
+		0xBB, 0x38, 0x61, 0x87, 0x3B, 0xA0, 0x80, 0x08, 0x00, 0x07, 0x09, 0x07,
+		0x3A, 0x8D, 0x0E, 0x14, 0x28, 0xCE, 0x81, 0x02, 0x06, 0x01, 0x07, 0x07,
+		0x04, 0xBC, 0x88, 0x88, 0x80, 0x06, 0x00, 0x07, 0x07, 0x05, 0x7A, 0x10,
+		0x70, 0xA7, 0xE0, 0x05, 0x00, 0x04, 0x0A, 0x05, 0x21, 0x09, 0xF6, 0x31,
+		0x8C, 0x61, 0xC0, 0x08, 0x01, 0x07, 0x07, 0x06, 0x86, 0x18, 0x61, 0x86,
+		0x37, 0x40, 0x07, 0x00, 0x07, 0x07, 0x07, 0xC2, 0x89, 0x11, 0x62, 0x87,
+		0x04, 0x00, 0x0B, 0x00, 0x07, 0x07, 0x0B, 0xC4, 0x69, 0x89, 0x29, 0x25,
+		0x43, 0x28, 0x63, 0x0C, 0x60, 0x07, 0x00, 0x07, 0x07, 0x07, 0xC6, 0xD8,
+		0xA0, 0x82, 0x8D, 0xB1, 0x80, 0x07, 0x00, 0x07, 0x09, 0x07, 0xC2, 0x89,
+		0x91, 0x42, 0x83, 0x04, 0x18, 0x20, 0x06, 0x00, 0x07, 0x07, 0x06, 0x7C,
+		0x21, 0x84, 0x21, 0x0F, 0xC0, 0x04, 0x00, 0x03, 0x0D, 0x04, 0x34, 0x44,
+		0x44, 0x84, 0x44, 0x44, 0x30, 0x04, 0x02, 0x03, 0x0D, 0x01, 0xFF, 0xF8,
+		0x04, 0x01, 0x03, 0x0D, 0x03, 0xC9, 0x24, 0x8A, 0x49, 0x2C, 0x08, 0x01,
+		0x09, 0x03, 0x06, 0xE6, 0x78, 0x00
+	};
+	
+	// Usage: Copy the 3 commented lines to your code, removing the comments.
+	//#include "XFont.h"
+	//XFont xFont;
+	//#include "Lato-Regular_14_1bFixed.h"
+	
+	// Leave the next 3 lines here, as is.
+	DataStream_P	dataStream(glyphData, sizeof(glyphData));
+	XFont16BitDataStream xFontDataStream(&xFont, &dataStream);
+	XFont::Font font(&fontHeader, charcodeRun, glyphDataOffset, &xFontDataStream);
+	
+	// The display needs to be set before using xFont.  This only needs
+	// to be done once at the beginning of the program.
+	// Use xFont.SetDisplay(&display, &Lato_Regular_14_1bFixed::font); to do this.
+	// To change to this font anywhere after setting the display,
+	// use: xFont.SetFont(&Lato_Regular_14_1bFixed::font);
+}
+
+#endif // Lato_Regular_14_1bFixed_h
+
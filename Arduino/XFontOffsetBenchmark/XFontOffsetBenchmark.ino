@@ -0,0 +1,68 @@
+#include <Arduino.h>
+
+#include "XFont.h"
+XFont xFont;
+/*
+*	The same subset exported twice.  Lato-Regular_14_1b.h uses delta encoded
+*	glyph data offsets (the default when it saves PROGMEM) and
+*	Lato-Regular_14_1bFixed.h uses one 16 bit offset per glyph (exported
+*	with the eFixedDataOffsets option.)
+*/
+#include "Lato-Regular_14_1b.h"
+#include "Lato-Regular_14_1bFixed.h"
+
+const char		kTestStr[] = " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJKLMNO"
+							"PQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstuvwxyz{|}~";
+const uint16_t	kIterations = 100;
+
+/******************************* TimeMeasureStr *******************************/
+/*
+*	MeasureStr loads the glyph header of every glyph in the string, so the
+*	time per glyph is dominated by the charcode and glyph data offset lookup.
+*/
+uint32_t TimeMeasureStr(
+	XFont::Font*	inFont)
+{
+	uint16_t	height, width;
+	xFont.SetFont(inFont);
+	uint32_t	startTime = micros();
+	for (uint16_t i = 0; i < kIterations; i++)
+	{
+		xFont.MeasureStr(kTestStr, height, width);
+	}
+	return(micros() - startTime);
+}
+
+/****************************** PrintResult ***********************************/
+void PrintResult(
+	const char*		inLabel,
+	uint32_t		inOffsetsSize,
+	uint32_t		inMicros)
+{
+	uint32_t	glyphsMeasured = (uint32_t)kIterations * (sizeof(kTestStr) -1);
+	Serial.print(inLabel);
+	Serial.print(F(": offsets "));
+	Serial.print(inOffsetsSize);
+	Serial.print(F(" bytes, "));
+	Serial.print((inMicros * 10) / glyphsMeasured);
+	Serial.println(F(" us/10 glyphs"));
+}
+
+/********************************** setup *************************************/
+void setup(void)
+{
+	Serial.begin(115200);
+
+	uint32_t	deltaMicros = TimeMeasureStr(&Lato_Regular_14_1b::font);
+	uint32_t	fixedMicros = TimeMeasureStr(&Lato_Regular_14_1bFixed::font);
+	PrintResult("Delta", sizeof(Lato_Regular_14_1b::glyphDataCheckpoint) +
+		sizeof(Lato_Regular_14_1b::glyphDataDelta), deltaMicros);
+	PrintResult("Fixed", sizeof(Lato_Regular_14_1bFixed::glyphDataOffset),
+		fixedMicros);
+}
+
+
+/********************************** loop ***********************************/
+void loop()
+{
+}
@@ -21,9 +21,13 @@
 *
 */
 
+#ifdef __MACH__
+#include "AT24CSimulator.h"
+#else
 #include "Arduino.h"
-#include "AT24C.h"
 #include <Wire.h>
+#endif
+#include "AT24C.h"
 
 /*********************************** AT24C ************************************/
 AT24C::AT24C(
@@ -31,7 +35,7 @@ AT24C::AT24C(
 	uint8_t	inCapacity)
 	: mDeviceAddress(inDeviceAddress)
 #ifdef DEBUG_AT24C
-		, mMaxWaitTime(0)
+		, mMaxWaitTime(0), mReadTransactions(0)
 #endif
 {
 	switch(inCapacity)
@@ -69,6 +73,9 @@ uint16_t AT24C::Read(
 	Wire.write(inDataAddress >> 8);
 	Wire.write(inDataAddress & 0xFF);
 	Wire.endTransmission(true);
+#ifdef DEBUG_AT24C
+	mReadTransactions++;
+#endif
 	
 	uint16_t	bytesRead = 0;
 	uint16_t	bytes2Read = inLength;
@@ -76,6 +83,9 @@ uint16_t AT24C::Read(
 	{
 		// The most you can read/request from Wire is 32 bytes.
 		bytesRead = Wire.requestFrom(mDeviceAddress, (uint8_t)(bytes2Read >= 32 ? 32 : bytes2Read), (uint8_t)true);
+#ifdef DEBUG_AT24C
+		mReadTransactions++;
+#endif
 		if (bytesRead > 0)
 		{
 			bytes2Read -= bytesRead;
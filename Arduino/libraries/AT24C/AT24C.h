@@ -46,10 +46,22 @@ public:
 	*	chip waiting for it to return 0 after it enables itself after writing.
 	*/
 	bool					WaitTillReady(void);
+	uint16_t				PageSize(void) const
+								{return(mPageSize);}
 #ifdef DEBUG_AT24C
 	uint32_t				MaxWaitTime(void)
 								{return(mMaxWaitTime);}
+	/*
+	*	ReadTransactions: The number of I2C transactions Read has made, one
+	*	to set the data address plus one per Wire request.  Used to measure
+	*	the effect of AT24CDataStream's read-ahead window.
+	*/
+	uint32_t				ReadTransactions(void) const
+								{return(mReadTransactions);}
+	void					ResetReadTransactions(void)
+								{mReadTransactions = 0;}
 	uint32_t mMaxWaitTime;
+	uint32_t mReadTransactions;
 #endif
 private:
 	uint8_t		mDeviceAddress;	// 0x50 + N low address bits.
@@ -22,14 +22,124 @@
 */
 #include "AT24CDataStream.h"
 #include "AT24C.h"
+#include <string.h>
 
 /****************************** AT24CDataStream *******************************/
 AT24CDataStream::AT24CDataStream(
 	AT24C*		inAT24C,
 	const void*	inStartAddress,
-	uint32_t	inLength)
-	: DataStreamImpl(inStartAddress, inLength), mAT24C(inAT24C)
+	uint32_t	inLength,
+	uint8_t*	inReadAheadBuffer,
+	uint16_t	inReadAheadBufferSize)
+	: DataStreamImpl(inStartAddress, inLength), mAT24C(inAT24C),
+	  mCache(inReadAheadBuffer), mLineSize(0), mNumLines(0), mNextVictim(0),
+	  mCacheHits(0), mCacheMisses(0)
+{
+	if (inReadAheadBuffer && inReadAheadBufferSize)
+	{
+		mLineSize = inAT24C->PageSize();
+		if (inReadAheadBufferSize < mLineSize)
+		{
+			mLineSize = inReadAheadBufferSize;
+		}
+		uint16_t	numLines = inReadAheadBufferSize/mLineSize;
+		mNumLines = numLines > kMaxLines ? kMaxLines : numLines;
+	}
+	InvalidateCache();
+}
+
+/****************************** InvalidateCache *******************************/
+void AT24CDataStream::InvalidateCache(void)
+{
+	for (uint8_t i = 0; i < kMaxLines; i++)
+	{
+		mLineLength[i] = 0;
+	}
+}
+
+/********************************** LoadLine **********************************/
+/*
+*	Loads the line aligned block containing inAddress into the next victim line.
+*	Returns the index of the line loaded or kMaxLines if the read failed.
+*/
+uint8_t AT24CDataStream::LoadLine(
+	uint32_t	inAddress)
+{
+	uint8_t		line = mNextVictim;
+	uint32_t	lineStart = inAddress - (inAddress % mLineSize);
+	uint32_t	streamStart = (uint32_t)(uintptr_t)mStartAddr;
+	if (lineStart < streamStart)
+	{
+		lineStart = streamStart;
+	}
+	uint32_t	lineLength = (uint32_t)(uintptr_t)mEndAddr - lineStart;
+	if (lineLength > mLineSize)
+	{
+		lineLength = mLineSize;
+	}
+	mCacheMisses++;
+	mNextVictim++;
+	if (mNextVictim >= mNumLines)
+	{
+		mNextVictim = 0;
+	}
+	mLineAddress[line] = lineStart;
+	mLineLength[line] = mAT24C->Read(lineStart, lineLength, &mCache[line * mLineSize]);
+	return(mLineLength[line] ? line : kMaxLines);
+}
+
+/********************************** LineFor ***********************************/
+/*
+*	Returns the index of the line containing inAddress, loading it if it isn't
+*	already loaded.  Returns kMaxLines if the read failed.
+*/
+uint8_t AT24CDataStream::LineFor(
+	uint32_t	inAddress)
+{
+	for (uint8_t line = 0; line < mNumLines; line++)
+	{
+		if (mLineLength[line] &&
+			inAddress >= mLineAddress[line] &&
+			(inAddress - mLineAddress[line]) < mLineLength[line])
+		{
+			mCacheHits++;
+			return(line);
+		}
+	}
+	return(LoadLine(inAddress));
+}
+
+/********************************** Acquire ***********************************/
+/*
+*	When there's a read-ahead window, the loaded line containing the current
+*	position is directly addressable.  At most the remainder of the line is
+*	returned so that a glyph that ends within a line doesn't cause the next
+*	line to be loaded.
+*/
+uint32_t AT24CDataStream::Acquire(
+	const uint8_t*&	outPtr,
+	uint32_t		inMaxLen)
 {
+	uint32_t	length = 0;
+	inMaxLen = Clip(inMaxLen);
+	if (mNumLines &&
+		inMaxLen)
+	{
+		uint32_t	address = (uint32_t)(uintptr_t)mCurrent;
+		uint8_t		line = LineFor(address);
+		if (line < mNumLines)
+		{
+			uint32_t	offsetInLine = address - mLineAddress[line];
+			length = mLineLength[line] - offsetInLine;
+			if (length > inMaxLen)
+			{
+				length = inMaxLen;
+			}
+			outPtr = &mCache[line * mLineSize + offsetInLine];
+			mCurrent += length;
+		}
+	}
+	return(length);
 }
 
 /************************************ Read ************************************/
@@ -37,8 +147,44 @@ uint32_t AT24CDataStream::Read(
 	uint32_t	inLength,
 	void*		outBuffer)
 {
-	uint32_t	bytesRead = mAT24C->Read((uint32_t)mCurrent, Clip(inLength), (uint8_t*)outBuffer);
-	mCurrent+=bytesRead;
+	uint32_t	bytesRead;
+	inLength = Clip(inLength);
+	/*
+	*	If there's no read-ahead window THEN
+	*	read directly from the AT24C.
+	*/
+	if (mNumLines == 0)
+	{
+		if (inLength)
+		{
+			mCacheMisses++;
+		}
+		bytesRead = mAT24C->Read((uint32_t)(uintptr_t)mCurrent, inLength, (uint8_t*)outBuffer);
+		mCurrent+=bytesRead;
+	} else
+	{
+		uint8_t*	bufferPtr = (uint8_t*)outBuffer;
+		bytesRead = 0;
+		while (bytesRead < inLength)
+		{
+			uint32_t	address = (uint32_t)(uintptr_t)mCurrent;
+			uint8_t		line = LineFor(address);
+			if (line >= mNumLines)
+			{
+				break;	// AT24C read failed
+			}
+			uint32_t	offsetInLine = address - mLineAddress[line];
+			uint32_t	bytesToCopy = mLineLength[line] - offsetInLine;
+			if (bytesToCopy > (inLength - bytesRead))
+			{
+				bytesToCopy = inLength - bytesRead;
+			}
+			memcpy(bufferPtr, &mCache[line * mLineSize + offsetInLine], bytesToCopy);
+			bufferPtr += bytesToCopy;
+			bytesRead += bytesToCopy;
+			mCurrent += bytesToCopy;
+		}
+	}
 	return(bytesRead);
 }
 
@@ -49,8 +195,9 @@ uint32_t AT24CDataStream::Write(
 {
 	// Space needs to be preallocated via the constructor, the end doesn't
 	// automatically extend.
-	uint32_t	bytesWritten = mAT24C->Write((uint32_t)mCurrent, Clip(inLength), (const uint8_t*)inBuffer);
+	uint32_t	bytesWritten = mAT24C->Write((uint32_t)(uintptr_t)mCurrent, Clip(inLength), (const uint8_t*)inBuffer);
 	mCurrent+=bytesWritten;
+	InvalidateCache();	// The read-ahead window may no longer be valid.
 	return(bytesWritten);
 }
 
@@ -29,18 +29,59 @@ class AT24C;
 class AT24CDataStream : public DataStreamImpl
 {
 public:
+	/*
+	*	inReadAheadBuffer is optional.  When supplied, reads are served from a
+	*	RAM window of inReadAheadBufferSize bytes.  The window is divided into
+	*	lines of the chip's page size (or a single line when
+	*	inReadAheadBufferSize is smaller than a page.)  Each line holds a page
+	*	aligned block of the chip.  Sequential glyph reads and repeated glyph
+	*	header reads that fall within a loaded line don't generate any I2C
+	*	transactions.
+	*/
 							AT24CDataStream(
 								AT24C*					inAT24C,
 								const void*				inStartAddress,
-								uint32_t				inLength);
+								uint32_t				inLength,
+								uint8_t*				inReadAheadBuffer = nullptr,
+								uint16_t				inReadAheadBufferSize = 0);
 	virtual uint32_t		Read(
 								uint32_t				inLength,
 								void*					outBuffer);
 	virtual uint32_t		Write(
 								uint32_t				inLength,
 								const void*				inBuffer);
+	virtual uint32_t		Acquire(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen);
+	/*
+	*	A hit is a read (or the part of a read) served from a loaded line.
+	*	A miss is a line load or a read that bypassed the window (every Read
+	*	when there's no read-ahead window.  Acquire without a window returns
+	*	0 so the caller's Read is what's counted.)
+	*/
+	uint32_t				CacheHits(void) const
+								{return(mCacheHits);}
+	uint32_t				CacheMisses(void) const
+								{return(mCacheMisses);}
+	void					ResetCacheStats(void)
+								{mCacheHits = 0; mCacheMisses = 0;}
+	void					InvalidateCache(void);
 protected:
+	static const uint8_t	kMaxLines = 8;
 	AT24C*		mAT24C;
+	uint8_t*	mCache;
+	uint16_t	mLineSize;
+	uint8_t		mNumLines;
+	uint8_t		mNextVictim;	// Line to be replaced on the next miss
+	uint32_t	mLineAddress[kMaxLines];	// AT24C address of each line
+	uint16_t	mLineLength[kMaxLines];		// Valid bytes in each line, 0 = empty
+	uint32_t	mCacheHits;
+	uint32_t	mCacheMisses;
+
+	uint8_t					LoadLine(
+								uint32_t				inAddress);
+	uint8_t					LineFor(
+								uint32_t				inAddress);
 };
 
-#endif // AT24CDataStream_h
\ No newline at end of file
+#endif // AT24CDataStream_h
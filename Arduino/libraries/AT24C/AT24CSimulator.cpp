@@ -0,0 +1,136 @@
+/*
+*	AT24CSimulator.cpp, Copyright Jonathan Mackey 2019
+*	Host (__MACH__) replacement for the Wire library as used by the AT24C
+*	class.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifdef __MACH__
+#include "AT24CSimulator.h"
+#include <chrono>
+
+AT24CSimulator Wire;
+
+/*********************************** micros ***********************************/
+uint32_t micros(void)
+{
+	return((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/******************************* AT24CSimulator *******************************/
+AT24CSimulator::AT24CSimulator(void)
+	: mImage(nullptr), mImageSize(0), mAddress(0), mTxAddressBytes(0),
+	  mRxAvailable(0), mTransactions(0), mBytesTransferred(0)
+{
+}
+
+/********************************** SetImage **********************************/
+void AT24CSimulator::SetImage(
+	uint8_t*	ioImage,
+	uint32_t	inImageSize)
+{
+	mImage = ioImage;
+	mImageSize = inImageSize;
+	mAddress = 0;
+}
+
+/***************************** beginTransmission ******************************/
+void AT24CSimulator::beginTransmission(
+	uint8_t	inDeviceAddress)
+{
+	mTxAddressBytes = 0;
+}
+
+/*********************************** write ************************************/
+/*
+*	The first two bytes of a transmission set the data address (MSB first).
+*	Any bytes that follow are written to the image at the data address.
+*/
+size_t AT24CSimulator::write(
+	uint8_t	inValue)
+{
+	mBytesTransferred++;
+	if (mTxAddressBytes < 2)
+	{
+		mAddress = mTxAddressBytes ? ((mAddress & 0xFF00) | inValue) : (inValue << 8);
+		mTxAddressBytes++;
+	} else
+	{
+		if (mAddress < mImageSize)
+		{
+			mImage[mAddress] = inValue;
+		}
+		mAddress++;
+	}
+	return(1);
+}
+
+/*********************************** write ************************************/
+size_t AT24CSimulator::write(
+	const uint8_t*	inBuffer,
+	size_t			inLength)
+{
+	for (size_t i = 0; i < inLength; i++)
+	{
+		write(inBuffer[i]);
+	}
+	return(inLength);
+}
+
+/****************************** endTransmission *******************************/
+uint8_t AT24CSimulator::endTransmission(
+	uint8_t	inSendStop)
+{
+	mTransactions++;
+	return(0);	// Success, the simulated chip is always ready.
+}
+
+/******************************** requestFrom *********************************/
+uint8_t AT24CSimulator::requestFrom(
+	uint8_t	inDeviceAddress,
+	uint8_t	inLength,
+	uint8_t	inSendStop)
+{
+	mTransactions++;
+	mRxAvailable = inLength;
+	return(inLength);
+}
+
+/********************************* available **********************************/
+int AT24CSimulator::available(void)
+{
+	return(mRxAvailable);
+}
+
+/************************************ read ************************************/
+int AT24CSimulator::read(void)
+{
+	if (mRxAvailable)
+	{
+		mRxAvailable--;
+		mBytesTransferred++;
+		int	value = mAddress < mImageSize ? mImage[mAddress] : 0xFF;
+		mAddress++;
+		return(value);
+	}
+	return(-1);
+}
+
+#endif // __MACH__
@@ -0,0 +1,84 @@
+/*
+*	AT24CSimulator.h, Copyright Jonathan Mackey 2019
+*	Host (__MACH__) replacement for the Wire library as used by the AT24C
+*	class.  The AT24C chip is simulated by a memory image.  Each I2C
+*	transaction is counted so that the effect of changes to the access
+*	pattern (e.g. AT24CDataStream's read-ahead window) can be measured off the
+*	board.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef AT24CSimulator_h
+#define AT24CSimulator_h
+#ifdef __MACH__
+
+#include <inttypes.h>
+#include <stddef.h>
+
+class AT24CSimulator
+{
+public:
+							AT24CSimulator(void);
+	/*
+	*	ioImage is the contents of the simulated chip.  It isn't copied, so it
+	*	must remain valid while the simulator is in use.
+	*/
+	void					SetImage(
+								uint8_t*				ioImage,
+								uint32_t				inImageSize);
+	// Wire interface used by AT24C
+	void					beginTransmission(
+								uint8_t					inDeviceAddress);
+	size_t					write(
+								uint8_t					inValue);
+	size_t					write(
+								const uint8_t*			inBuffer,
+								size_t					inLength);
+	uint8_t					endTransmission(
+								uint8_t					inSendStop = true);
+	uint8_t					requestFrom(
+								uint8_t					inDeviceAddress,
+								uint8_t					inLength,
+								uint8_t					inSendStop = true);
+	int						available(void);
+	int						read(void);
+	
+	// Statistics
+	uint32_t				Transactions(void) const
+								{return(mTransactions);}
+	uint32_t				BytesTransferred(void) const
+								{return(mBytesTransferred);}
+	void					ResetStats(void)
+								{mTransactions = 0; mBytesTransferred = 0;}
+protected:
+	uint8_t*	mImage;
+	uint32_t	mImageSize;
+	uint16_t	mAddress;		// Current data address of the simulated chip
+	uint8_t		mTxAddressBytes;// Data address bytes received in the current
+								// transmission (0, 1, or 2)
+	uint8_t		mRxAvailable;	// Bytes remaining from the last requestFrom
+	uint32_t	mTransactions;
+	uint32_t	mBytesTransferred;
+};
+
+extern AT24CSimulator Wire;
+uint32_t micros(void);
+
+#endif // __MACH__
+#endif // AT24CSimulator_h
@@ -50,6 +50,22 @@ public:
 	virtual bool			AtEOF(void) const = 0;
 	virtual uint32_t		Clip(
 								uint32_t				inLength) const = 0;	
+	/*
+	*	Peek and Acquire provide optional zero-copy access for streams whose
+	*	data is directly addressable (SRAM, or flash that is memory mapped.)
+	*	outPtr is set to the current position and the number of contiguous
+	*	bytes available (at most inMaxLen) is returned.  Acquire also advances
+	*	the current position by the returned length.  Streams that can't
+	*	expose their memory return 0, in which case Read must be used.
+	*/
+	virtual uint32_t		Peek(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen) const
+								{return(0);}
+	virtual uint32_t		Acquire(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen)
+								{return(0);}
 };
 
 class DataStreamImpl : public DataStream
@@ -87,6 +103,12 @@ public:
 	virtual uint32_t		Write(
 								uint32_t				inLength,
 								const void*				inBuffer);
+	virtual uint32_t		Peek(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen) const;
+	virtual uint32_t		Acquire(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen);
 
 };
 
@@ -103,6 +125,12 @@ public:
 	virtual uint32_t		Write(
 								uint32_t				inLength,
 								const void*				inBuffer);
+	virtual uint32_t		Peek(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen) const;
+	virtual uint32_t		Acquire(
+								const uint8_t*&			outPtr,
+								uint32_t				inMaxLen);
 
 };
 
@@ -0,0 +1,440 @@
+/*
+*	CanvasDisplayController.cpp, Copyright Jonathan Mackey 2023
+*	Display controller that draws to a 16 bit 565 pixel buffer in RAM.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "CanvasDisplayController.h"
+#include "DataStream.h"
+
+/************************** CanvasDisplayController ***************************/
+CanvasDisplayController::CanvasDisplayController(
+	uint16_t*	inPixels,
+	uint16_t	inRows,
+	uint16_t	inColumns)
+	: DisplayController(inRows, inColumns), mPixels(inPixels),
+	  mEndOfPixels(&inPixels[(uint32_t)inRows * inColumns]),
+	  mCurrent(inPixels), mCurrentRow(inPixels), mStartRow(inPixels),
+	  mEndRow(mEndOfPixels), mStartColumn(0), mCurrentColumn(0),
+	  mEndColumn(inColumns)
+{
+}
+
+/***************************** SetAddressingMode ******************************/
+/*
+*	In horizontal mode the pixels written advance by column within the column
+*	range, then wrap to the start column of the next row.  In vertical mode
+*	the pixels written advance by row within the row range, then wrap to the
+*	start row of the next column.  (Same as BitmapDisplayController.)
+*/
+void CanvasDisplayController::SetAddressingMode(
+	EAddressingMode	inAddressingMode)
+{
+	if (inAddressingMode != mAddressingMode)
+	{
+		mAddressingMode = inAddressingMode;
+		if (inAddressingMode == eHorizontal)
+		{
+			mEndRow = mEndOfPixels;
+		} else
+		{
+			mEndColumn = mColumns;
+			mCurrentColumn = mStartColumn;
+		}
+	}
+}
+
+/*********************************** MoveTo ***********************************/
+// No bounds checking.  Blind move.
+void CanvasDisplayController::MoveTo(
+	uint16_t	inRow,
+	uint16_t	inColumn)
+{
+	MoveToRow(inRow);
+	mColumn = inColumn;
+}
+
+/********************************* MoveToRow **********************************/
+/*
+*	No bounds checking.  Blind move.  As with the TFT controllers, the row
+*	range is set from inRow to the last row.
+*/
+void CanvasDisplayController::MoveToRow(
+	uint16_t inRow)
+{
+	mStartRow = &mPixels[(uint32_t)inRow * mColumns];
+	mEndRow = mEndOfPixels;
+	mRow = inRow;
+}
+
+/******************************** MoveToColumn ********************************/
+// No bounds checking.  Blind move.
+void CanvasDisplayController::MoveToColumn(
+	uint16_t inColumn)
+{
+	mColumn = inColumn;
+}
+
+/******************************* SetColumnRange *******************************/
+/*
+*	Starts a write at inStartColumn of the current row.  A column range that
+*	extends past the canvas is clipped to the last column.  If the range is
+*	outside of the canvas, writes are dropped till the window is set again.
+*/
+void CanvasDisplayController::SetColumnRange(
+	uint16_t	inStartColumn,
+	uint16_t	inEndColumn)
+{
+	if (inEndColumn >= mColumns)
+	{
+		inEndColumn = mColumns-1;
+	}
+	mCurrentRow = mStartRow;
+	mStartColumn = inStartColumn;
+	mEndColumn = inEndColumn+1;
+	mCurrent = (inStartColumn <= inEndColumn && mStartRow < mEndOfPixels) ?
+					&mCurrentRow[inStartColumn] : nullptr;
+}
+
+/******************************** SetRowRange *********************************/
+/*
+*	Starts a write at the current column of inStartRow.  Clipped the same way
+*	as SetColumnRange.
+*/
+void CanvasDisplayController::SetRowRange(
+	uint16_t	inStartRow,
+	uint16_t	inEndRow)
+{
+	if (inEndRow >= mRows)
+	{
+		inEndRow = mRows-1;
+	}
+	mCurrentRow = mStartRow = &mPixels[(uint32_t)inStartRow * mColumns];
+	mEndRow = &mPixels[(uint32_t)(inEndRow+1) * mColumns];
+	mStartColumn = 0;
+	mEndColumn = mColumns;
+	mCurrentColumn = mColumn;
+	mCurrent = (inStartRow <= inEndRow && mColumn < mColumns) ?
+					&mCurrentRow[mColumn] : nullptr;
+}
+
+/******************************* PixelsTillWrap *******************************/
+/*
+*	Returns the number of pixels that can be written from mCurrent before the
+*	end of the column range (horizontal) or row range (vertical.)
+*/
+uint32_t CanvasDisplayController::PixelsTillWrap(void) const
+{
+	return(mAddressingMode == eHorizontal ?
+				(uint32_t)(&mCurrentRow[mEndColumn] - mCurrent) :
+				(uint32_t)(mEndRow - mCurrent + mColumns - 1)/mColumns);
+}
+
+/****************************** AdvancePastWrap *******************************/
+/*
+*	Moves mCurrent to the start of the next row of the column range
+*	(horizontal) or the next column of the row range (vertical), wrapping back
+*	to the start of the window after the last one.
+*/
+void CanvasDisplayController::AdvancePastWrap(void)
+{
+	if (mAddressingMode == eHorizontal)
+	{
+		mCurrentRow += mColumns;
+		if (mCurrentRow >= mEndRow)
+		{
+			mCurrentRow = mStartRow;
+		}
+		mCurrent = &mCurrentRow[mStartColumn];
+	} else
+	{
+		mCurrentColumn++;
+		if (mCurrentColumn >= mEndColumn)
+		{
+			mCurrentColumn = mStartColumn;
+		}
+		mCurrent = &mStartRow[mCurrentColumn];
+	}
+}
+
+/********************************* FillPixels *********************************/
+void CanvasDisplayController::FillPixels(
+	uint32_t	inPixelsToFill,
+	uint16_t	inFillColor)
+{
+	mPixelsPushed += inPixelsToFill;
+	if (mCurrent)
+	{
+		uint16_t	step = mAddressingMode == eHorizontal ? 1 : mColumns;
+		while (inPixelsToFill)
+		{
+			uint32_t	pixelsToFill = PixelsTillWrap();
+			bool		atWrap = inPixelsToFill >= pixelsToFill;
+			if (!atWrap)
+			{
+				pixelsToFill = inPixelsToFill;
+			}
+			inPixelsToFill -= pixelsToFill;
+			uint16_t*	current = mCurrent;
+			for (; pixelsToFill; pixelsToFill--, current += step)
+			{
+				*current = inFillColor;
+			}
+			mCurrent = current;
+			if (atWrap)
+			{
+				AdvancePastWrap();
+			}
+		}
+	}
+}
+
+/******************************** WritePixels *********************************/
+void CanvasDisplayController::WritePixels(
+	const uint16_t*	inPixels,
+	uint32_t		inPixelsToWrite)
+{
+	if (mCurrent)
+	{
+		while (inPixelsToWrite)
+		{
+			uint32_t	pixelsToWrite = PixelsTillWrap();
+			bool		atWrap = inPixelsToWrite >= pixelsToWrite;
+			if (!atWrap)
+			{
+				pixelsToWrite = inPixelsToWrite;
+			}
+			inPixelsToWrite -= pixelsToWrite;
+			if (mAddressingMode == eHorizontal)
+			{
+				memcpy(mCurrent, inPixels, pixelsToWrite*2);
+				inPixels += pixelsToWrite;
+				mCurrent += pixelsToWrite;
+			} else
+			{
+				uint16_t*	current = mCurrent;
+				for (; pixelsToWrite; pixelsToWrite--, current += mColumns)
+				{
+					*current = *(inPixels++);
+				}
+				mCurrent = current;
+			}
+			if (atWrap)
+			{
+				AdvancePastWrap();
+			}
+		}
+	}
+}
+
+/******************************** CopyPixels **********************************/
+void CanvasDisplayController::CopyPixels(
+	const void*		inPixels,
+	uint16_t		inPixelsToCopy)
+{
+	mPixelsPushed += inPixelsToCopy;
+	WritePixels((const uint16_t*)inPixels, inPixelsToCopy);
+}
+
+/******************************** StreamCopy **********************************/
+/*
+*	In horizontal mode each run of pixels within the column range is read
+*	directly into the canvas.  In vertical mode the pixels aren't contiguous so
+*	they're read into a small buffer first.
+*/
+void CanvasDisplayController::StreamCopy(
+	DataStream*	inDataStream,	// A 16 bit data stream
+	uint16_t	inPixelsToCopy)
+{
+	mPixelsPushed += inPixelsToCopy;
+	if (mCurrent)
+	{
+		if (mAddressingMode == eHorizontal)
+		{
+			while (inPixelsToCopy)
+			{
+				uint32_t	pixelsToRead = PixelsTillWrap();
+				bool		atWrap = inPixelsToCopy >= pixelsToRead;
+				if (!atWrap)
+				{
+					pixelsToRead = inPixelsToCopy;
+				}
+				inPixelsToCopy -= pixelsToRead;
+				inDataStream->Read(pixelsToRead, mCurrent);
+				mCurrent += pixelsToRead;
+				if (atWrap)
+				{
+					AdvancePastWrap();
+				}
+			}
+		} else
+		{
+			uint16_t	buffer[32];
+			while (inPixelsToCopy)
+			{
+				uint16_t pixelsToWrite = inPixelsToCopy > 32 ? 32 : inPixelsToCopy;
+				inPixelsToCopy -= pixelsToWrite;
+				inDataStream->Read(pixelsToWrite, buffer);
+				WritePixels(buffer, pixelsToWrite);
+			}
+		}
+	}
+}
+
+/***************************** CopyTintedPattern ******************************/
+/*
+*	Same as TFT_ST77XX::CopyTintedPattern except the pattern is copied
+*	directly to each row or column of the canvas rather than by setting a
+*	window for each repetition.  Pixels outside of the canvas are clipped.
+*/
+void CanvasDisplayController::CopyTintedPattern(
+	uint16_t		inX,
+	uint16_t		inY,
+	const uint8_t*	inTintPattern,
+	uint16_t		inPatternLen,
+	uint16_t		inReps,
+	bool			inVertical,
+	bool			inReverseOrder)
+{
+	uint16_t	colorPattern[inPatternLen];
+	uint8_t		thisTint;
+	uint8_t		lastTint;
+	uint16_t	color = 0;
+	if (inReverseOrder)
+	{
+		const uint8_t*	patternPtr = &inTintPattern[inPatternLen-1];
+		lastTint = *patternPtr + 1;
+		for (uint16_t i = 0; i < inPatternLen; i++)
+		{
+			thisTint = *(patternPtr--);
+			if (lastTint != thisTint)
+			{
+				lastTint = thisTint;
+				color = Calc565Color(mFGColor, mBGColor, thisTint);
+			}
+			colorPattern[i] = color;
+		}
+	} else
+	{
+		lastTint = inTintPattern[0] + 1;
+		for (uint16_t i = 0; i < inPatternLen; i++)
+		{
+			thisTint = inTintPattern[i];
+			if (lastTint != thisTint)
+			{
+				lastTint = thisTint;
+				color = Calc565Color(mFGColor, mBGColor, thisTint);
+			}
+			colorPattern[i] = color;
+		}
+	}
+	/*
+	*	Clip the pattern length and the number of repetitions to the canvas.
+	*	A horizontal pattern runs along a row, the repetitions down the rows.
+	*	A vertical pattern runs down a column, the repetitions across the
+	*	columns.
+	*/
+	uint16_t	patternStart = inVertical ? inY : inX;
+	uint16_t	patternLimit = inVertical ? mRows : mColumns;
+	uint16_t	repStart = inVertical ? inX : inY;
+	uint16_t	repLimit = inVertical ? mColumns : mRows;
+	if (patternStart < patternLimit &&
+		repStart < repLimit)
+	{
+		if (inPatternLen > (patternLimit - patternStart))
+		{
+			inPatternLen = patternLimit - patternStart;
+		}
+		if (inReps > (repLimit - repStart))
+		{
+			inReps = repLimit - repStart;
+		}
+		uint16_t*	repPtr = &mPixels[((uint32_t)inY * mColumns) + inX];
+		if (inVertical)
+		{
+			for (; inReps; inReps--, repPtr++)
+			{
+				uint16_t*	current = repPtr;
+				for (uint16_t i = 0; i < inPatternLen; i++, current += mColumns)
+				{
+					*current = colorPattern[i];
+				}
+			}
+		} else
+		{
+			for (; inReps; inReps--, repPtr += mColumns)
+			{
+				memcpy(repPtr, colorPattern, inPatternLen*2);
+			}
+		}
+	}
+}
+
+/************************************ Blit ************************************/
+/*
+*	The canvas is copied to a single window on inDisplay.  When the canvas is
+*	entirely visible the pixels are copied as one contiguous run, otherwise
+*	only the visible part of each row is copied.
+*/
+void CanvasDisplayController::Blit(
+	DisplayController*	inDisplay,
+	uint16_t			inX,
+	uint16_t			inY) const
+{
+	if (inDisplay->CanMoveTo(inY, inX))
+	{
+		uint16_t	visibleRows = inDisplay->GetRows() - inY;
+		uint16_t	visibleColumns = inDisplay->GetColumns() - inX;
+		if (visibleRows > mRows)
+		{
+			visibleRows = mRows;
+		}
+		if (visibleColumns > mColumns)
+		{
+			visibleColumns = mColumns;
+		}
+		inDisplay->MoveTo(inY, inX);
+		inDisplay->SetColumnRange(visibleColumns);
+		const uint16_t*	pixels = mPixels;
+		if (visibleColumns == mColumns)
+		{
+			/*
+			*	CopyPixels takes a 16 bit count so the run is copied in
+			*	chunks of whole rows.
+			*/
+			uint32_t	pixelsToCopy = (uint32_t)visibleRows * mColumns;
+			uint32_t	maxChunk = (0xFFFF / mColumns) * mColumns;
+			while (pixelsToCopy)
+			{
+				uint16_t	chunk = pixelsToCopy > maxChunk ? maxChunk : pixelsToCopy;
+				inDisplay->CopyPixels(pixels, chunk);
+				pixels += chunk;
+				pixelsToCopy -= chunk;
+			}
+		} else
+		{
+			for (; visibleRows; visibleRows--, pixels += mColumns)
+			{
+				inDisplay->CopyPixels(pixels, visibleColumns);
+			}
+		}
+		inDisplay->SetColumnRange(0, inDisplay->GetColumns()-1);
+		inDisplay->MoveToRow(inY);
+	}
+}
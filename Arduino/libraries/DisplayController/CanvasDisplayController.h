@@ -0,0 +1,133 @@
+/*
+*	CanvasDisplayController.h, Copyright Jonathan Mackey 2023
+*	Display controller that draws to a 16 bit 565 pixel buffer in RAM.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef CanvasDisplayController_h
+#define CanvasDisplayController_h
+
+#include "DisplayController.h"
+
+/*
+*	CanvasDisplayController is an offscreen canvas.  Anything that draws to a
+*	DisplayController (XFont, the XView classes, DrawLine, DrawCircle...) can
+*	compose an image in the canvas in as many passes as needed, then Blit
+*	copies the finished image to the real display in a single window
+*	transfer, so the intermediate passes are never seen.
+*
+*	The pixel buffer is supplied by the caller and holds inRows * inColumns
+*	565 pixels, row by row.  The canvas uses its own coordinates, 0,0 being
+*	the top left of the canvas.  The canvas typically covers a sub-rectangle
+*	of the display (e.g. the bounds of a single view) that is placed by Blit.
+*
+*	The window and addressing behavior is the same as the TFT controllers:
+*	MoveTo sets the start row, SetColumnRange starts a write at the current
+*	row, and written pixels wrap within the column range and then the rows.
+*	Unlike a display controller, writes to a window outside of the canvas
+*	are dropped rather than left to the controller to ignore.
+*/
+class CanvasDisplayController : public DisplayController
+{
+public:
+							CanvasDisplayController(
+								uint16_t*				inPixels,
+								uint16_t				inRows,
+								uint16_t				inColumns);
+	virtual void			MoveTo(
+								uint16_t				inRow,
+								uint16_t				inColumn);
+	virtual void			MoveToRow(
+								uint16_t				inRow);
+	virtual void			MoveToColumn(
+								uint16_t				inColumn);
+	virtual void			Sleep(void){}
+	virtual void			WakeUp(void){}
+	/*
+	*	FillPixels: Sets a run of inPixelsToFill to inFillColor from the
+	*	current position and column clipping.
+	*/
+	virtual void			FillPixels(
+								uint32_t				inPixelsToFill,
+								uint16_t				inFillColor);
+	/*
+	*	SetColumnRange: Sets a the absolute column clipping to inStartColumn to
+	*	inEndColumn.
+	*/
+	virtual void			SetColumnRange(
+								uint16_t				inStartColumn,
+								uint16_t				inEndColumn);
+	/*
+	*	SetRowRange: Sets a the absolute row range clipping to
+	*	inStartRow to inEndRow.
+	*/
+	virtual void			SetRowRange(
+								uint16_t				inStartRow,
+								uint16_t				inEndRow);
+	/*
+	*	StreamCopy: Blindly copies inPixelsToCopy 16 bit pixels from inDataStream
+	*	starting at the current row and column.  The pixels are read directly
+	*	into the canvas.
+	*/
+	virtual void			StreamCopy(
+								DataStream*				inDataStream,
+								uint16_t				inPixelsToCopy);
+	virtual void			CopyPixels(
+								const void*				inPixels,
+								uint16_t				inPixelsToCopy);
+	virtual void			CopyTintedPattern(
+								uint16_t				inX,
+								uint16_t				inY,
+								const uint8_t*			inPattern,
+								uint16_t				inPatternLen,
+								uint16_t				inReps,
+								bool					inVertical,
+								bool					inReverseOrder);
+	virtual void			SetAddressingMode(
+								EAddressingMode			inAddressingMode = eHorizontal);
+	/*
+	*	Blit: Copies the canvas to inDisplay with the top left of the canvas at
+	*	inX, inY.  The canvas is clipped to the display.  inDisplay must be a
+	*	16 bit display.
+	*/
+	void					Blit(
+								DisplayController*		inDisplay,
+								uint16_t				inX,
+								uint16_t				inY) const;
+	uint16_t*				GetPixels(void) const
+								{return(mPixels);}
+protected:
+	uint16_t*	mPixels;
+	uint16_t*	mEndOfPixels;
+	uint16_t*	mCurrent;		// nullptr when the window is outside the canvas
+	uint16_t*	mCurrentRow;	// Only used in horizontal address mode
+	uint16_t*	mStartRow;
+	uint16_t*	mEndRow;
+	uint16_t	mStartColumn;
+	uint16_t	mCurrentColumn;	// Only used in vertical address mode
+	uint16_t	mEndColumn;		// Column after the column range
+
+	void					WritePixels(
+								const uint16_t*			inPixels,
+								uint32_t				inPixelsToWrite);
+	uint32_t				PixelsTillWrap(void) const;
+	void					AdvancePastWrap(void);
+};
+
+#endif // CanvasDisplayController_h
@@ -34,7 +34,9 @@ DisplayController::DisplayController(
 	uint16_t	inRows,
 	uint16_t	inColumns)
 	: mRows(inRows), mColumns(inColumns), mRow(0), mColumn(0),
-	  mAddressingMode(eHorizontal), mFGColor(0xFFFF), mBGColor(0)
+	  mAddressingMode(eHorizontal), mFGColor(0xFFFF), mBGColor(0),
+	  mPixelsPushed(0), mClipTop(0), mClipBottom(0), mClipLeft(0),
+	  mClipRight(0)
 {
 }
 
@@ -155,6 +157,55 @@ int32_t DisplayController::ClipY(
 	return(Clip(ioYCoord,ioHeight,mRows));
 }
 
+/******************************** SetClipRect *********************************/
+void DisplayController::SetClipRect(
+	int16_t		inX,
+	int16_t		inY,
+	uint16_t	inWidth,
+	uint16_t	inHeight)
+{
+	int32_t	x = inX;
+	int32_t	y = inY;
+	int32_t	width = inWidth;
+	int32_t	height = inHeight;
+	ClipX(x, width);
+	ClipY(y, height);
+	mClipLeft = x;
+	mClipTop = y;
+	mClipBottom = y + height;
+	/*
+	*	An empty clip rect is set to a one pixel rect outside of the display
+	*	because a mClipRight of 0 means no clip.
+	*/
+	if (width && height)
+	{
+		mClipRight = x + width;
+	} else
+	{
+		mClipLeft = mColumns;
+		mClipRight = mColumns + 1;
+	}
+}
+
+/******************************* ClipToClipRect *******************************/
+bool DisplayController::ClipToClipRect(
+	int32_t&	ioX,
+	int32_t&	ioY,
+	int32_t&	ioWidth,
+	int32_t&	ioHeight) const
+{
+	if (mClipRight)
+	{
+		ioX -= mClipLeft;
+		Clip(ioX, ioWidth, mClipRight - mClipLeft);
+		ioX += mClipLeft;
+		ioY -= mClipTop;
+		Clip(ioY, ioHeight, mClipBottom - mClipTop);
+		ioY += mClipTop;
+	}
+	return(ioWidth > 0 && ioHeight > 0);
+}
+
 /************************************ Fill************************************/
 void DisplayController::Fill(
 	uint16_t	inFillColor)
@@ -187,12 +238,34 @@ void DisplayController::FillBlock(
 	}
 	if (inColumns && inRows)
 	{
-		SetColumnRange(inColumns);
-		// The column index will wrap back to the starting point.
-		// The page won't so it needs to be reset.
-		FillPixels((uint32_t)inRows * inColumns, inFillColor);
-		//SetColumnRange(0, mColumns-1);	// Remove the column range clipping
-		//MoveToRow(mRow);	// Leave the page unchanged
+		/*
+		*	If there's a clip rect THEN
+		*	fill just the part of the block within it.
+		*/
+		if (mClipRight)
+		{
+			uint16_t	row = mRow;
+			uint16_t	column = mColumn;
+			int32_t		x = column;
+			int32_t		y = row;
+			int32_t		width = inColumns;
+			int32_t		height = inRows;
+			if (ClipToClipRect(x, y, width, height))
+			{
+				MoveTo(y, x);
+				SetColumnRange(width);
+				FillPixels((uint32_t)height * width, inFillColor);
+			}
+			MoveTo(row, column);
+		} else
+		{
+			SetColumnRange(inColumns);
+			// The column index will wrap back to the starting point.
+			// The page won't so it needs to be reset.
+			FillPixels((uint32_t)inRows * inColumns, inFillColor);
+			//SetColumnRange(0, mColumns-1);	// Remove the column range clipping
+			//MoveToRow(mRow);	// Leave the page unchanged
+		}
 		MoveColumnBy(inColumns); // Advance by inColumns (or wrap to zero if at or past end)
 	}
 }
@@ -272,18 +345,15 @@ void DisplayController::DrawFrame(
 	uint16_t	inColor,
 	uint8_t		inThickness)
 {
-	MoveTo(inY, inX);
-	SetColumnRange(inWidth);
-	FillPixels(inWidth * inThickness, inColor);
-	MoveToRow(inY+inHeight-inThickness);
-	SetColumnRange(inWidth);
-	FillPixels(inWidth * inThickness, inColor);
-	MoveToRow(inY+inThickness);
-	SetColumnRange(inThickness);
-	FillPixels((inHeight-(inThickness*2)) * inThickness, inColor);
-	MoveToColumn(inX + inWidth - inThickness);
-	SetColumnRange(inThickness);
-	FillPixels((inHeight-(inThickness*2)) * inThickness, inColor);
+	/*
+	*	The sides are filled using FillRect so that the frame is clipped to the
+	*	clip rect.
+	*/
+	uint16_t	sideHeight = inHeight-(inThickness*2);
+	FillRect(inX, inY, inWidth, inThickness, inColor);	// Top
+	FillRect(inX, inY+inHeight-inThickness, inWidth, inThickness, inColor);	// Bottom
+	FillRect(inX, inY+inThickness, inThickness, sideHeight, inColor);	// Left
+	FillRect(inX+inWidth-inThickness, inY+inThickness, inThickness, sideHeight, inColor);	// Right
 }
 
 /****************************** DrawTintedFrame *******************************/
@@ -510,35 +580,35 @@ uint8_t DisplayController::DrawCircle(
 			{
 				if (inOctants & eNNEOctant)
 				{
-					CopyTintedPattern(xx1, yy0, patternPtr, patternLen, 1, false, true);
+					CopyClippedTintedPattern(xx1, yy0, patternPtr, patternLen, 1, false, true);
 				}
 				if (inOctants & eENEOctant)
 				{
-					CopyTintedPattern(xx2, yx0, patternPtr, patternLen, 1, true, false);
+					CopyClippedTintedPattern(xx2, yx0, patternPtr, patternLen, 1, true, false);
 				}
 				if (inOctants & eESEOctant)
 				{
-					CopyTintedPattern(xx2, yx1, patternPtr, patternLen, 1, true, true);
+					CopyClippedTintedPattern(xx2, yx1, patternPtr, patternLen, 1, true, true);
 				}
 				if (inOctants & eSSEOctant)
 				{
-					CopyTintedPattern(xx1, yx2, patternPtr, patternLen, 1, false, true);
+					CopyClippedTintedPattern(xx1, yx2, patternPtr, patternLen, 1, false, true);
 				}
 				if (inOctants & eSSWOctant)
 				{
-					CopyTintedPattern(xx0, yx2, patternPtr, patternLen, 1, false, false);
+					CopyClippedTintedPattern(xx0, yx2, patternPtr, patternLen, 1, false, false);
 				}
 				if (inOctants & eWSWOctant)
 				{
-					CopyTintedPattern(xy0, yx1, patternPtr, patternLen, 1, true, true);
+					CopyClippedTintedPattern(xy0, yx1, patternPtr, patternLen, 1, true, true);
 				}
 				if (inOctants & eWNWOctant)
 				{
-					CopyTintedPattern(xy0, yx0, patternPtr, patternLen, 1, true, false);
+					CopyClippedTintedPattern(xy0, yx0, patternPtr, patternLen, 1, true, false);
 				}
 				if (inOctants & eNNWOctant)
 				{
-					CopyTintedPattern(xx0, yy0, patternPtr, patternLen, 1, false, false);
+					CopyClippedTintedPattern(xx0, yy0, patternPtr, patternLen, 1, false, false);
 				}
 			/*
 			*	Else at this point there are only rectangular areas representing
@@ -1149,7 +1219,7 @@ void DisplayController::DrawLine(
 					if (reps && clippedPatternLen)
 					{
 						lastX = oX;
-						CopyTintedPattern(oX, oY, &pattern[patternInset], clippedPatternLen, 1, swapXY, false);
+						CopyClippedTintedPattern(oX, oY, &pattern[patternInset], clippedPatternLen, 1, swapXY, false);
 					}
 					if (y < mirrorY)
 					{
@@ -1186,7 +1256,7 @@ void DisplayController::DrawLine(
 						if (reps && patternLen)
 						{
 							lastXM = oX;
-							CopyTintedPattern(oX, oY, &pattern[patternInset], patternLen, 1, swapXY, true);
+							CopyClippedTintedPattern(oX, oY, &pattern[patternInset], patternLen, 1, swapXY, true);
 						}
 					}
 				}
@@ -1226,6 +1296,48 @@ void DisplayController::CopyTintedPattern(
 	// See TFT_ST77XX::CopyTintedPattern for an implementation example
 }
 
+/************************** CopyClippedTintedPattern **************************/
+/*
+*	The pattern runs along the row, or down the column when inVertical, and the
+*	reps are the rows below, or the columns to the right when inVertical.
+*/
+void DisplayController::CopyClippedTintedPattern(
+	uint16_t		inX,
+	uint16_t		inY,
+	const uint8_t*	inTintPattern,
+	uint16_t		inPatternLen,
+	uint16_t		inReps,
+	bool			inVertical,
+	bool			inReverseOrder)
+{
+	if (mClipRight)
+	{
+		int32_t	x = inX;
+		int32_t	y = inY;
+		int32_t	width = inVertical ? inReps : inPatternLen;
+		int32_t	height = inVertical ? inPatternLen : inReps;
+		if (ClipToClipRect(x, y, width, height))
+		{
+			uint16_t	patternOffset = inVertical ? y - inY : x - inX;
+			uint16_t	patternLen = inVertical ? height : width;
+			/*
+			*	When reversed, the first pixel is the last tint so the pixels
+			*	clipped on the left (or top) are at the end of the pattern.
+			*/
+			if (inReverseOrder)
+			{
+				patternOffset = inPatternLen - patternOffset - patternLen;
+			}
+			CopyTintedPattern(x, y, &inTintPattern[patternOffset], patternLen,
+				inVertical ? width : height, inVertical, inReverseOrder);
+		}
+	} else
+	{
+		CopyTintedPattern(inX, inY, inTintPattern, inPatternLen, inReps,
+			inVertical, inReverseOrder);
+	}
+}
+
 /********************************* DrawFrameP *********************************/
 /*void DisplayController::DrawFrameP(
 	const Rect8_t*	inRect,
@@ -84,6 +84,41 @@ public:
 	int32_t					ClipY(
 								int32_t&				ioYCoord,
 								int32_t&				ioHeight);
+	/*
+	*	SetClipRect: Limits FillBlock, and the routines that draw using it
+	*	(FillRect, DrawFrame, DrawCircle, DrawRoundedRect, etc.), the tinted
+	*	patterns of DrawCircle and DrawLine, and the glyphs drawn by XFont to
+	*	the rectangle.  The pixels written directly by FillPixels, CopyPixels
+	*	and StreamCopy aren't clipped.  The clip doesn't change the current
+	*	position logic of the routines, the pixels outside of it just aren't
+	*	sent to the display.
+	*/
+	void					SetClipRect(
+								int16_t					inX,
+								int16_t					inY,
+								uint16_t				inWidth,
+								uint16_t				inHeight);
+	void					ClearClipRect(void)
+								{mClipRight = 0;}
+	bool					HasClipRect(void) const
+								{return(mClipRight != 0);}
+	uint16_t				GetClipTop(void) const
+								{return(mClipTop);}
+	uint16_t				GetClipBottom(void) const
+								{return(mClipBottom);}
+	uint16_t				GetClipLeft(void) const
+								{return(mClipLeft);}
+	uint16_t				GetClipRight(void) const
+								{return(mClipRight);}
+	/*
+	*	ClipToClipRect: Clips/adjusts the rectangle to the clip rect, if set.
+	*	Returns false if nothing is left.
+	*/
+	bool					ClipToClipRect(
+								int32_t&				ioX,
+								int32_t&				ioY,
+								int32_t&				ioWidth,
+								int32_t&				ioHeight) const;
 
 	uint16_t				GetRow(void) const
 								{return(mRow);}
@@ -212,6 +247,18 @@ public:
 								uint16_t				inReps,
 								bool					inVertical,
 								bool					inReverseOrder);
+	/*
+	*	CopyClippedTintedPattern: Same as CopyTintedPattern, limited to the
+	*	clip rect.
+	*/
+	void					CopyClippedTintedPattern(
+								uint16_t				inX,
+								uint16_t				inY,
+								const uint8_t*			inPattern,
+								uint16_t				inPatternLen,
+								uint16_t				inReps,
+								bool					inVertical,
+								bool					inReverseOrder);
 	uint16_t				DrawRoundedRect(
 								int16_t					inX,
 								int16_t					inY,
@@ -313,6 +360,15 @@ public:
 								{mBGColor = inBGColor;}
 	uint16_t				GetBGColor(void) const
 								{return(mBGColor);}
+	/*
+	*	PixelsPushed: The number of pixels filled, copied or streamed to the
+	*	display since the last ResetPixelsPushed (bytes for the monochrome
+	*	displays.)  Used to measure how much a screen update draws.
+	*/
+	uint32_t				PixelsPushed(void) const
+								{return(mPixelsPushed);}
+	void					ResetPixelsPushed(void)
+								{mPixelsPushed = 0;}
 	static inline void		SwapInt16(
 								int16_t&				ioA,
 								int16_t&				ioB)
@@ -338,6 +394,11 @@ protected:
 	EAddressingMode	mAddressingMode;
 	uint16_t	mFGColor;
 	uint16_t	mBGColor;
+	uint32_t	mPixelsPushed;
+	uint16_t	mClipTop;
+	uint16_t	mClipBottom;
+	uint16_t	mClipLeft;
+	uint16_t	mClipRight;	// 0 if no clip rect
 };
 
 #endif // DisplayController_h
@@ -172,6 +172,7 @@ void LCD_PCD8544::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
+	mPixelsPushed += inPixelsToFill;
 	mDataRow = mRow;
 	mDataColumn = mColumn;
 	uint8_t	fillData = inFillColor ? 0xFF : 0;
@@ -258,6 +259,7 @@ void LCD_PCD8544::StreamCopy(
 	DataStream*	inDataStream,
 	uint16_t	inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	BeginTransaction();
 	uint8_t	buffer[32];
 	mDataRow = mRow;
@@ -261,6 +261,7 @@ void LCD_ST7567::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
+	mPixelsPushed += inPixelsToFill;
 	mDataRow = mRow;
 	mDataColumn = mColumn;
 	uint8_t	fillData = inFillColor;
@@ -360,6 +361,7 @@ void LCD_ST7567::StreamCopy(
 	DataStream*	inDataStream,
 	uint16_t	inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	BeginTransaction();
 	uint8_t	buffer[32];
 	mDataRow = mRow;
@@ -183,6 +183,7 @@ void OLED_SSD1306::FillPixels(
 	uint32_t	inBytesToFill,
 	uint16_t	inFillColor)
 {
+	mPixelsPushed += inBytesToFill;
 	uint8_t	fillData = inFillColor ? 0xFF : 0;
 	while (inBytesToFill)
 	{
@@ -222,6 +223,7 @@ void OLED_SSD1306::StreamCopy(
 	DataStream*	inDataStream,
 	uint16_t	inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	uint8_t	buffer[32];
 	buffer[0] = 0x40; // Sending data, Co = 0, D/C# = 1  (counts as 1 of the 32)
 	while (inPixelsToCopy)
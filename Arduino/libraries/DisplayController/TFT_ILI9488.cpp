@@ -127,6 +127,7 @@ void TFT_ILI9488::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
+	mPixelsPushed += inPixelsToFill;
 #if 1
 	bool use3Bit = true;
 	uint8_t fillColor = 0;
@@ -273,6 +274,7 @@ void TFT_ILI9488::StreamCopy(
 	DataStream* inDataStream,	// A 16 bit data stream
 	uint16_t	inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	BeginTransaction();
 	uint16_t	buffer[96];	// WritePixelData's buffer holds 96 pixels.
 	while (inPixelsToCopy)
@@ -290,6 +292,7 @@ void TFT_ILI9488::CopyPixels(
 	const void*		inPixels,
 	uint16_t		inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	BeginTransaction();
 	WritePixelData((const uint16_t*)inPixels, inPixelsToCopy);
 	EndTransaction();
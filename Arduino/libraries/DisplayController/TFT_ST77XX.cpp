@@ -363,6 +363,7 @@ void TFT_ST77XX::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
+	mPixelsPushed += inPixelsToFill;
 #if 1
 	uint8_t	buffer[96*2];
 	const uint32_t	kMaxPixels = sizeof(buffer)/2;
@@ -472,6 +473,7 @@ void TFT_ST77XX::StreamCopy(
 	DataStream*	inDataStream,	// A 16 bit data stream
 	uint16_t	inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	BeginTransaction();
 	uint16_t	buffer[96];
 	while (inPixelsToCopy)
@@ -489,6 +491,7 @@ void TFT_ST77XX::CopyPixels(
 	const void*		inPixels,
 	uint16_t		inPixelsToCopy)
 {
+	mPixelsPushed += inPixelsToCopy;
 	BeginTransaction();
 	WriteData16((const uint16_t*)inPixels, inPixelsToCopy);
 	EndTransaction();
@@ -36,7 +36,10 @@
 *	By using the DataStream abstraction, the data can be stored anywhere.
 *
 *	The xfnt specification allows for more than 64KB of glyph data.
-*	This implementation only supports up to 64KB of glyph data (16 bit offsets.)
+*	This implementation supports more than 64KB of glyph data via segmented
+*	offsets (see Font::glyphDataSegments), 32 bit offsets aren't supported.
+*	Delta encoded offsets (see Font::glyphDataDeltas) trade a short summing
+*	loop for roughly half the offsets PROGMEM.
 */
 
 const uint16_t	XFont::kEllipsisCharcode = 0x2026;
@@ -45,7 +48,13 @@ const uint16_t	XFont::kEllipsisCharcode = 0x2026;
 XFont::XFont(void)
 	: mDisplay(nullptr), mFontRows(0),
 	  mHighlightEnabled(false), mFont(nullptr),
-	  mTextColor(0xFFFF), mTextBGColor(0), mStartCol(0)
+	  mTextColor(0xFFFF), mTextBGColor(0), mStartCol(0),
+	  mNumKerningLefts(0), mKernLeftIndex(0xFFFF),
+	  mClipTop(0), mClipBottom(0), mClipLeft(0), mClipRight(0), mClipScroll(0),
+	  mLineBuffer(nullptr), mLineBufferPixels(0), mGlyphDataOffset(0),
+	  mGlyphCache(nullptr), mGlyphCacheMaxEntries(0), mGlyphCacheEntries(0),
+	  mGlyphCacheBuffer(nullptr), mGlyphCacheSize(0), mGlyphCacheUsed(0),
+	  mGlyphCacheUse(0)
 {
 }
 
@@ -69,40 +78,119 @@ void XFont::SetFont(
 		mCharcode = 0;
 		if (inFont)
 		{
-			memcpy_P(&mFontHeader, mFont->header, sizeof(FontHeader));
+			FontHeader	fontHeader;
+			memcpy_P(&fontHeader, mFont->header, sizeof(FontHeader));
+			if (fontHeader.version >= 3)
+			{
+				memcpy_P(&mFontHeader, mFont->header, sizeof(FontHeader16));
+			} else
+			{
+				// Widen the 8 bit metrics
+				mFontHeader.version = fontHeader.version;
+				mFontHeader.oneBit = fontHeader.oneBit;
+				mFontHeader.rotated = fontHeader.rotated;
+				mFontHeader.horizontal = fontHeader.horizontal;
+				mFontHeader.monospaced = fontHeader.monospaced;
+				mFontHeader.flags = 0;
+				mFontHeader.ascent = fontHeader.ascent;
+				mFontHeader.descent = fontHeader.descent;
+				mFontHeader.height = fontHeader.height;
+				mFontHeader.width = fontHeader.width;
+				mFontHeader.numCharcodeRuns = fontHeader.numCharcodeRuns;
+				mFontHeader.numCharCodes = fontHeader.numCharCodes;
+			}
 			if (mDisplay)
 			{
 				mFontRows = (mFontHeader.rotated == 0 || (mFontHeader.height & 7) == 0) ?
-											mFontHeader.height : (mFontHeader.height & 0xF8) + 8;
+											mFontHeader.height : (mFontHeader.height & ~7) + 8;
 				if (mDisplay->BitsPerPixel() == 1)
 				{
 					mFontRows = (mFontHeader.height + 7)/8;
 				}
 			}
 			mEllipsisWidth = LoadGlyph(kEllipsisCharcode) ? mGlyph.advanceX : 0;
+			/*
+			*	Count the KerningLefts so that they can be binary searched.
+			*	The last KerningLeft is 0xFFFF.
+			*/
+			mNumKerningLefts = 0;
+			mKernLeftIndex = 0xFFFF;
+			if (mFont->kerningLefts)
+			{
+				while (pgm_read_word_near(&mFont->kerningLefts[mNumKerningLefts].entryIndex) != 0xFFFF)
+				{
+					mNumKerningLefts++;
+				}
+			}
 		}
 	}
 }
 
+/******************************* SetGlyphCache ********************************/
+void XFont::SetGlyphCache(
+	SCachedGlyph*	inEntries,
+	uint8_t			inMaxEntries,
+	uint16_t*		inBuffer,
+	uint16_t		inBufferBytes)
+{
+	mGlyphCache = (inEntries && inMaxEntries && inBuffer) ? inEntries : nullptr;
+	mGlyphCacheMaxEntries = inMaxEntries;
+	mGlyphCacheEntries = 0;
+	mGlyphCacheBuffer = inBuffer;
+	mGlyphCacheSize = inBufferBytes/2;
+	mGlyphCacheUsed = 0;
+	mGlyphCacheUse = 0;
+}
+
 /********************************* FindGlyph **********************************/
 /*
 *	Returns entryIndex within the glyphDataOffsets for inCharcode.
 *	0xFFFF is returned if the glyph doesn't exist.
 */
 uint16_t XFont::FindGlyph(
-	uint16_t	inCharcode)
+	uint32_t	inCharcode)
 {
 	uint16_t leftIndex = 0;
 	const CharcodeRun*	charcodeRuns = mFont->charcodeRuns;
 	const CharcodeRun*	charcodeRun = NULL;
+	uint16_t	numCharcodeRuns = mFontHeader.numCharcodeRuns;
+	if (mFont->charcodePlanes)
+	{
+		/*
+		*	Narrow the search to the runs of inCharcode's plane.
+		*	The last plane is 0xFFFF so the search always ends.
+		*	If the plane doesn't exist there are no runs to search.
+		*/
+		const CharcodePlane*	charcodePlane = mFont->charcodePlanes;
+		uint16_t	plane = inCharcode >> 16;
+		uint16_t	thisPlane;
+		while ((thisPlane = pgm_read_word_near(&charcodePlane->plane)) < plane)
+		{
+			charcodePlane++;
+		}
+		if (thisPlane == plane)
+		{
+			uint16_t	runIndex = pgm_read_word_near(&charcodePlane->runIndex);
+			charcodeRuns += runIndex;
+			numCharcodeRuns = pgm_read_word_near(&charcodePlane[1].runIndex) - runIndex;
+		} else
+		{
+			numCharcodeRuns = 0;
+		}
+	} else if (inCharcode > 0xFFFF)
+	{
+		numCharcodeRuns = 0;
+	}
+	uint16_t	charcode16 = (uint16_t)inCharcode;
+	if (numCharcodeRuns)
 	{
 		uint16_t current = 0;
-		uint16_t rightIndex = mFontHeader.numCharcodeRuns -1;
+		uint16_t rightIndex = numCharcodeRuns -1;
 		while (leftIndex <= rightIndex)
 		{
 			current = (leftIndex + rightIndex) / 2;
 			
-			int32_t	cmpResult = (int32_t)pgm_read_word_near(&charcodeRuns[current].start) - inCharcode;
+			int32_t	cmpResult = (int32_t)pgm_read_word_near(&charcodeRuns[current].start) - charcode16;
 			if (cmpResult == 0)
 			{
 				charcodeRun = &charcodeRuns[current];
@@ -126,7 +214,7 @@ uint16_t XFont::FindGlyph(
 		{
 			charcodeRun = &charcodeRuns[leftIndex-1];
 			entryIndex = pgm_read_word_near(&charcodeRun->entryIndex) +
-							inCharcode - pgm_read_word_near(&charcodeRun->start);
+							charcode16 - pgm_read_word_near(&charcodeRun->start);
 			// Sanity check...
 			// If the calculated entry index is less than the next run's entry index
 			// then the calculated entry index is valid.
@@ -146,6 +234,39 @@ uint16_t XFont::FindGlyph(
 	return(entryIndex);
 }
 
+/****************************** GlyphDataOffset *******************************/
+/*
+*	Returns the offset of the glyph header of inEntryIndex within the glyph
+*	data.  inEntryIndex must be less than numCharCodes.
+*/
+uint32_t XFont::GlyphDataOffset(
+	uint16_t	inEntryIndex) const
+{
+	uint32_t	offset;
+	if (mFont->glyphDataDeltas)
+	{
+		/*
+		*	Start at the nearest checkpoint and add the sizes of the
+		*	entries between it and inEntryIndex (at most 15.)
+		*/
+		offset = pgm_read_word_near(&mFont->glyphDataOffsets[inEntryIndex >> kGlyphDataCheckpointShift]);
+		const uint8_t*	deltaPtr = &mFont->glyphDataDeltas[inEntryIndex & ~((1 << kGlyphDataCheckpointShift) -1)];
+		const uint8_t*	deltaEnd = &mFont->glyphDataDeltas[inEntryIndex];
+		for (; deltaPtr < deltaEnd; deltaPtr++)
+		{
+			offset += pgm_read_byte_near(deltaPtr);
+		}
+	} else
+	{
+		offset = pgm_read_word_near(&mFont->glyphDataOffsets[inEntryIndex]);
+		if (mFont->glyphDataSegments)
+		{
+			offset += pgm_read_dword_near(&mFont->glyphDataSegments[inEntryIndex >> 8]);
+		}
+	}
+	return(offset);
+}
+
 /****************************** LoadGlyphHeader *******************************/
 /*
 *	Loads the glyph header of inEntryIndex into XFont->mGlyph.
@@ -154,26 +275,49 @@ uint16_t XFont::FindGlyph(
 bool XFont::LoadGlyphHeader(
 	uint16_t	inEntryIndex)
 {
-	bool	success = false;
-	if (inEntryIndex < mFontHeader.numCharCodes)
+	// At this point we have the entry index of the glyph within the GlyphDataOffsets
+	return(inEntryIndex < mFontHeader.numCharCodes &&
+			LoadGlyphHeaderAt(GlyphDataOffset(inEntryIndex)));
+}
+
+/***************************** LoadGlyphHeaderAt ******************************/
+/*
+*	Loads the glyph header at inGlyphDataOffset within the glyph data into
+*	XFont->mGlyph.  Used for glyphs and static strings.
+*	Returns true if successful.
+*/
+bool XFont::LoadGlyphHeaderAt(
+	uint32_t	inGlyphDataOffset)
+{
+	DataStream*	glyphData = mFont->glyphData;
+	// Load the glyph header
+	mGlyphDataOffset = inGlyphDataOffset;
+	bool	success = glyphData->Seek(inGlyphDataOffset, DataStream::eSeekSet);
+	if (success)
 	{
-		DataStream*	glyphData = mFont->glyphData;
-		// At this point we have the entry index of the glyph within the GlyphDataOffsets
-		// Load the glyph header
-		success = glyphData->Seek(pgm_read_word_near(&mFont->glyphDataOffsets[inEntryIndex]), DataStream::eSeekSet);
-		if (success)
+		if (mFontHeader.version < 3)
 		{
-			glyphData->Read(sizeof(GlyphHeader), &mGlyph);
-			if (mGlyph.x < 0)
-			{
-				mGlyph.x = 0; 	// Kerning not supported
-			}
-			// Forward kerning is not supported.
-			// Increase advanceX enough so that the glyph isn't clipped.
-			if (mGlyph.advanceX < (mGlyph.x + mGlyph.columns))
-			{
-				mGlyph.advanceX = mGlyph.x + mGlyph.columns;
-			}
+			// Widen the 8 bit metrics
+			GlyphHeader	glyph;
+			glyphData->Read(sizeof(GlyphHeader), &glyph);
+			mGlyph.advanceX = glyph.advanceX;
+			mGlyph.x = glyph.x;
+			mGlyph.y = glyph.y;
+			mGlyph.rows = glyph.rows;
+			mGlyph.columns = glyph.columns;
+		} else
+		{
+			glyphData->Read(sizeof(GlyphHeader16), &mGlyph);
+		}
+		if (mGlyph.x < 0)
+		{
+			mGlyph.x = 0; 	// Kerning not supported
+		}
+		// Forward kerning is not supported.
+		// Increase advanceX enough so that the glyph isn't clipped.
+		if (mGlyph.advanceX < (mGlyph.x + mGlyph.columns))
+		{
+			mGlyph.advanceX = mGlyph.x + mGlyph.columns;
 		}
 	}
 	return(success);
@@ -186,7 +330,7 @@ bool XFont::LoadGlyphHeader(
 *	mGlyph is initialized from the stream.
 */
 bool XFont::LoadGlyph(
-	uint16_t	inCharcode)
+	uint32_t	inCharcode)
 {
 	bool	success = true;
 	uint16_t	entryIndex = mCharcode != inCharcode ? FindGlyph(inCharcode) : mCharcodeIndex;
@@ -208,6 +352,110 @@ bool XFont::LoadGlyph(
 	return(success);
 }
 
+/****************************** LoadCachedGlyph *******************************/
+/*
+*	Loads a glyph from its glyph data offset and its header as previously
+*	loaded by LoadGlyphHeader.  The glyph data stream is positioned past the
+*	header.  The first read after a seek is taken by the glyph data stream as
+*	the glyph header read (see the note in LoadGlyph), so a zero length read
+*	starts the glyph without reading the header.
+*/
+void XFont::LoadCachedGlyph(
+	uint32_t				inGlyphDataOffset,
+	const GlyphHeader16&	inGlyph)
+{
+	DataStream*	glyphData = mFont->glyphData;
+	mGlyphDataOffset = inGlyphDataOffset;
+	glyphData->Seek(inGlyphDataOffset + (mFontHeader.version < 3 ?
+						sizeof(GlyphHeader) : sizeof(GlyphHeader16)), DataStream::eSeekSet);
+	glyphData->Read(0, &mGlyph);
+	mGlyph = inGlyph;
+}
+
+/********************************** Kerning ***********************************/
+/*
+*	Returns the kerning pair adjustment of inLeftEntryIndex followed by
+*	inRightEntryIndex, 0 if none.  The KerningPair range of the last left
+*	glyph searched for is cached.  When drawing or measuring a string, a run
+*	of the same left glyph (e.g. "ll", "00") only needs the pairs searched.
+*/
+int16_t XFont::Kerning(
+	uint16_t	inLeftEntryIndex,
+	uint16_t	inRightEntryIndex)
+{
+	int16_t	kerning = 0;
+	if (mNumKerningLefts)
+	{
+		if (inLeftEntryIndex != mKernLeftIndex)
+		{
+			const KerningLeft*	kerningLefts = mFont->kerningLefts;
+			uint16_t	leftIndex = 0;
+			uint16_t	rightIndex = mNumKerningLefts;
+			mKernLeftIndex = inLeftEntryIndex;
+			mKernPairIndex = 0;
+			mKernPairEnd = 0;
+			while (leftIndex < rightIndex)
+			{
+				uint16_t	current = (leftIndex + rightIndex) / 2;
+				uint16_t	entryIndex = pgm_read_word_near(&kerningLefts[current].entryIndex);
+				if (entryIndex == inLeftEntryIndex)
+				{
+					mKernPairIndex = pgm_read_word_near(&kerningLefts[current].pairIndex);
+					mKernPairEnd = pgm_read_word_near(&kerningLefts[current+1].pairIndex);
+					break;
+				} else if (entryIndex < inLeftEntryIndex)
+				{
+					leftIndex = current + 1;
+				} else
+				{
+					rightIndex = current;
+				}
+			}
+		}
+		const KerningPair*	kerningPairs = mFont->kerningPairs;
+		uint16_t	leftIndex = mKernPairIndex;
+		uint16_t	rightIndex = mKernPairEnd;
+		while (leftIndex < rightIndex)
+		{
+			uint16_t	current = (leftIndex + rightIndex) / 2;
+			uint16_t	entryIndex = pgm_read_word_near(&kerningPairs[current].entryIndex);
+			if (entryIndex == inRightEntryIndex)
+			{
+				kerning = (int16_t)pgm_read_word_near(&kerningPairs[current].adjust);
+				break;
+			} else if (entryIndex < inRightEntryIndex)
+			{
+				leftIndex = current + 1;
+			} else
+			{
+				rightIndex = current;
+			}
+		}
+	}
+	return(kerning);
+}
+
+/****************************** KerningWithLeft *******************************/
+/*
+*	Returns the kerning of inLeftEntryIndex followed by the loaded glyph.
+*	Glyphs are drawn as blocks that include their blank columns, so negative
+*	kerning is limited to the blank columns between the two glyphs, the
+*	left glyph's trailing blank columns (inLeftTrailing) plus the loaded
+*	glyph's x.  Otherwise the loaded glyph would erase part of the left glyph.
+*/
+int16_t XFont::KerningWithLeft(
+	uint16_t	inLeftEntryIndex,
+	uint16_t	inLeftTrailing)
+{
+	int16_t	kerning = Kerning(inLeftEntryIndex, mCharcodeIndex);
+	int16_t	minKerning = -(int16_t)(inLeftTrailing + mGlyph.x);
+	if (kerning < minKerning)
+	{
+		kerning = minKerning;
+	}
+	return(kerning);
+}
+
 /******************************** DrawCharcode ********************************/
 /*
 *	Draws a single glyph at the current display position.
@@ -216,22 +464,100 @@ bool XFont::LoadGlyph(
 *	Do not set inFakeMonospaceWidth if the font is already monospace.
 */
 bool XFont::DrawCharcode(
-	uint16_t	inCharcode,
-	uint8_t		inFakeMonospaceWidth)
+	uint32_t	inCharcode,
+	uint8_t		inFakeMonospaceWidth,
+	int16_t		inKerning)
 {
 	bool doContinue = LoadGlyph(inCharcode);
+	if (doContinue)
+	{
+		doContinue = DrawLoadedGlyph(inFakeMonospaceWidth, inKerning);
+	}
+	return(doContinue);
+}
+
+/****************************** DrawStaticString ******************************/
+/*
+*	A static string is stored in the glyph data as a glyph the width of the
+*	string and the height of the font, so it's drawn the same way as a glyph,
+*	without any background fills.
+*/
+bool XFont::DrawStaticString(
+	uint16_t	inStringID)
+{
+	bool	success = mFont->staticStrings != nullptr;
+	if (success)
+	{
+		mStartCol = mDisplay->GetColumn();
+		success = LoadGlyphHeaderAt(pgm_read_dword_near(&mFont->staticStrings[inStringID])) &&
+					DrawLoadedGlyph();
+	}
+	return(success);
+}
+
+/****************************** DrawLoadedGlyph *******************************/
+/*
+*	Draws the glyph loaded by LoadGlyph or LoadCachedGlyph at the current
+*	display position.  See DrawCharcode.
+*/
+bool XFont::DrawLoadedGlyph(
+	uint8_t		inFakeMonospaceWidth,
+	int16_t		inKerning)
+{
+	bool doContinue = true;
 	while (doContinue)
 	{
 		bool	rotated = mFontHeader.rotated;
 		bool	vertical = false;
 		uint16_t	startRow = mDisplay->GetRow();
-		uint8_t	rows = mGlyph.rows;
-		uint8_t	columns = mGlyph.columns;
+		uint16_t	rows = mGlyph.rows;
+		uint16_t	columns = mGlyph.columns;
 		if (inFakeMonospaceWidth)
 		{
 			mGlyph.x = (inFakeMonospaceWidth - columns)/2;
 			mGlyph.advanceX = inFakeMonospaceWidth;
 		}
+		/*
+		*	Kerning moves the glyph relative to the previous glyph.
+		*	Negative kerning first removes blank columns before the glyph,
+		*	then backs up over the previous glyph's trailing blank columns.
+		*/
+		if (inKerning)
+		{
+			int16_t	x = mGlyph.x + inKerning;
+			if (x < 0)
+			{
+				int32_t	column = (int32_t)mDisplay->GetColumn() + x;
+				/*
+				*	If backing up into the left side of the horizontal clip
+				*	THEN scroll instead.
+				*/
+				if (mClipRight &&
+					column < mClipLeft)
+				{
+					mClipScroll += mClipLeft - column;
+					column = mClipLeft;
+				}
+				mDisplay->MoveToColumn(column);
+				mGlyph.advanceX -= mGlyph.x;
+				mGlyph.x = 0;
+			} else
+			{
+				mGlyph.advanceX += inKerning;
+				mGlyph.x = x;
+			}
+		}
+		/*
+		*	If there is a clip (this font's or the display's) AND
+		*	the glyph isn't entirely within it THEN
+		*	draw just the part within it.
+		*/
+		if ((mClipBottom || mClipRight || mDisplay->HasClipRect()) &&
+			GlyphIsClipped())
+		{
+			doContinue = DrawClippedGlyph();
+			break;
+		}
 		if (mFontHeader.oneBit)
 		{
 			vertical = rotated && !mFontHeader.horizontal;
@@ -283,52 +609,642 @@ bool XFont::DrawCharcode(
 		{
 			mDisplay->SetAddressingMode(DisplayController::eVertical);
 		}
-		doContinue = mDisplay->StreamCopyBlock(mFont->glyphData, rows, columns);
+		/*
+		*	If the glyph is in, or can be added to, the glyph cache THEN
+		*	copy the cached pixels rather than decoding the glyph data.
+		*	Same as StreamCopyBlock otherwise.
+		*/
+		const uint16_t*	cachedPixels = nullptr;
+		if (mGlyphCache &&
+			!rotated &&
+			mDisplay->BitsPerPixel() == 16)
+		{
+			cachedPixels = CachedGlyphPixels();
+		}
+		if (cachedPixels)
+		{
+			doContinue = mDisplay->WillFit(rows, columns);
+			if (doContinue)
+			{
+				mDisplay->SetColumnRange(columns);
+				mDisplay->CopyPixels(cachedPixels, rows * columns);
+				mDisplay->SetColumnRange(0, mDisplay->GetColumns()-1);
+				mDisplay->MoveToRow(mDisplay->GetRow());
+				mDisplay->MoveColumnBy(columns);
+			}
+		} else
+		{
+			doContinue = mDisplay->StreamCopyBlock(mFont->glyphData, rows, columns);
+		}
 		if (vertical)
 		{
 			mDisplay->SetAddressingMode(DisplayController::eHorizontal);
 		}
-		if (doContinue)
+		if (doContinue)
+		{
+			rowsWritten += rows;
+			/*
+			*	Fill the pixels below the glyph with the BG color...
+			*/
+			if (columns &&
+				rowsWritten < mFontRows)
+			{
+				uint16_t	savedColumn = mDisplay->GetColumn();
+				mDisplay->MoveTo(startRow + rowsWritten, startColumn+mGlyph.x);
+				mDisplay->FillBlock(mFontRows-rowsWritten, columns, mTextBGColor);
+				mDisplay->MoveToColumn(savedColumn);
+			}
+			mDisplay->MoveToRow(startRow);
+			doContinue = mDisplay->GetColumn() != 0;	// don't wrap
+			/*
+			*	Fill the pixels after the glyph (advance) with the BG color...
+			*/
+			if (doContinue)
+			{
+				if (mGlyph.advanceX > (mGlyph.x + columns))
+				{
+					mDisplay->FillBlock(mFontRows, mGlyph.advanceX - mGlyph.x - columns, mTextBGColor);
+					doContinue = mDisplay->GetColumn() != 0;	// don't wrap
+				}
+				mDisplay->MoveToColumn(startColumn+mGlyph.advanceX);
+			}
+		}
+		break;
+	}
+	return(doContinue);
+}
+	
+/****************************** DrawComposedLine ******************************/
+/*
+*	Composes the glyphs of the line starting at ioReader, and the background
+*	of each glyph block, in mLineBuffer, then copies the line to the display
+*	using a single column range.  The glyph blocks are composed in the same
+*	order and with the same kerning and inFakeMonospaceWidth adjustments as
+*	DrawStr and DrawLoadedGlyph, so the pixels drawn are the same.
+*
+*	Returns false, leaving ioReader and the display unchanged, if the line
+*	can't be composed (too wide for the buffer or display, a glyph is
+*	missing, etc.), in which case DrawStr draws the line glyph by glyph.
+*	When successful, ioReader is left at the newline or end of the string
+*	and the current column is the column following the line.
+*/
+bool XFont::DrawComposedLine(
+	UTF8Reader&		ioReader,
+	uint8_t			inFakeMonospaceWidth,
+	uint8_t			inCharacterLimit,
+	uint8_t&		ioCharactersDrawn)
+{
+	uint16_t	startRow = mDisplay->GetRow();
+	uint16_t	startColumn = mDisplay->GetColumn();
+	bool	success = mLineBuffer &&
+						mFontRows &&
+						!mFontHeader.rotated &&
+						!mClipBottom &&
+						!mClipRight &&
+						!mDisplay->HasClipRect() &&
+						mDisplay->BitsPerPixel() == 16 &&
+						(startRow + mFontRows) <= mDisplay->GetRows() &&
+						startColumn < mDisplay->GetColumns();
+	if (success)
+	{
+		DataStream*	glyphData = mFont->glyphData;
+		/*
+		*	The buffer row length (stride) is limited to the columns from the
+		*	start column to one before the last display column because
+		*	DrawStr won't continue once the column wraps.
+		*/
+		uint16_t	stride = mLineBufferPixels / mFontRows;
+		uint16_t	columnsLeft = mDisplay->GetColumns() - startColumn - 1;
+		if (stride > columnsLeft)
+		{
+			stride = columnsLeft;
+		}
+		uint16_t	lineCharcodes = 0;	// Charcodes read, excluding the newline
+		uint8_t		charactersDrawn = ioCharactersDrawn;
+		int32_t		column = 0;			// Relative to startColumn
+		uint16_t	lineColumns = 0;	// Columns composed
+		/*
+		*	The first pass only loads the glyph headers to check that every
+		*	glyph block fits within the buffer, so when the line can't be
+		*	composed no glyph data has been decoded before DrawStr draws it.
+		*	The second pass composes the line.
+		*/
+		for (uint8_t pass = 0; success && pass < 2; pass++)
+		{
+			UTF8Reader	reader(ioReader);
+			uint16_t	leftEntryIndex = 0xFFFF;	// For kerning, 0xFFFF if none
+			uint16_t	leftTrailing = 0;
+			charactersDrawn = ioCharactersDrawn;
+			column = 0;
+			lineColumns = 0;
+			lineCharcodes = 0;
+			while (inCharacterLimit == 0 || charactersDrawn < inCharacterLimit)
+			{
+				uint32_t	charcode = reader.Next();
+				if (charcode == 0 ||
+					charcode == '\n')
+				{
+					break;
+				}
+				charactersDrawn++;
+				lineCharcodes++;
+				if (charcode < ' ')
+				{
+					continue;	// Ignore unsupported control characters
+				}
+				success = LoadGlyph(charcode);
+				if (!success)
+				{
+					break;
+				}
+				int16_t		x = mGlyph.x;
+				int16_t		y = mGlyph.y;
+				uint16_t	rows = mGlyph.rows;
+				uint16_t	columns = mGlyph.columns;
+				uint16_t	advanceX = mGlyph.advanceX;
+				int16_t		kerning = 0;
+				if (leftEntryIndex != 0xFFFF)
+				{
+					kerning = KerningWithLeft(leftEntryIndex, leftTrailing);
+				}
+				if (mNumKerningLefts &&
+					!inFakeMonospaceWidth)
+				{
+					leftEntryIndex = mCharcodeIndex;
+					leftTrailing = advanceX - x - columns;
+				}
+				if (inFakeMonospaceWidth)
+				{
+					x = (inFakeMonospaceWidth - columns)/2;
+					advanceX = inFakeMonospaceWidth;
+				}
+				if (kerning)
+				{
+					if ((x + kerning) < 0)
+					{
+						column += (x + kerning);
+						advanceX -= x;
+						x = 0;
+					} else
+					{
+						advanceX += kerning;
+						x += kerning;
+					}
+				}
+				uint16_t	blockColumns = x + columns;
+				if (blockColumns < advanceX)
+				{
+					blockColumns = advanceX;
+				}
+				success = x >= 0 &&
+							y >= 0 &&
+							column >= 0 &&
+							(y + rows) <= mFontRows &&
+							(column + blockColumns) <= stride;
+				if (!success)
+				{
+					break;
+				}
+				/*
+				*	If composing THEN
+				*	fill the glyph block with the BG color, then read the glyph
+				*	rows into the block.
+				*/
+				if (pass)
+				{
+					uint16_t*	blockPtr = &mLineBuffer[column];
+					for (uint16_t row = 0; row < mFontRows; row++, blockPtr += stride)
+					{
+						for (uint16_t i = 0; i < blockColumns; i++)
+						{
+							blockPtr[i] = mTextBGColor;
+						}
+					}
+					if (columns)
+					{
+						uint16_t*	glyphRowPtr = &mLineBuffer[(y * stride) + column + x];
+						const uint16_t*	cachedPixels = CachedGlyphPixels();
+						for (uint16_t row = 0; row < rows; row++, glyphRowPtr += stride)
+						{
+							if (cachedPixels)
+							{
+								for (uint16_t i = 0; i < columns; i++)
+								{
+									glyphRowPtr[i] = *(cachedPixels++);
+								}
+							} else
+							{
+								glyphData->Read(columns, glyphRowPtr);
+							}
+						}
+					}
+				}
+				if ((column + blockColumns) > lineColumns)
+				{
+					lineColumns = column + blockColumns;
+				}
+				column += advanceX;
+			}
+			success = success && lineColumns;
+		}
+		if (success)
+		{
+			/*
+			*	Remove the unused part of each buffer row so that the line is
+			*	contiguous, then copy it to the display.
+			*/
+			if (lineColumns < stride)
+			{
+				uint16_t*	toPtr = &mLineBuffer[lineColumns];
+				const uint16_t*	fromPtr = &mLineBuffer[stride];
+				for (uint16_t row = 1; row < mFontRows; row++, fromPtr += stride)
+				{
+					for (uint16_t i = 0; i < lineColumns; i++)
+					{
+						*(toPtr++) = fromPtr[i];
+					}
+				}
+			}
+			mDisplay->MoveTo(startRow, startColumn);
+			mDisplay->SetColumnRange(lineColumns);
+			mDisplay->CopyPixels(mLineBuffer, lineColumns * mFontRows);
+			mDisplay->MoveTo(startRow, startColumn + column);
+			for (; lineCharcodes; lineCharcodes--)
+			{
+				ioReader.Next();
+			}
+			ioCharactersDrawn = charactersDrawn;
+		}
+	}
+	return(success);
+}
+
+/***************************** CachedGlyphPixels ******************************/
+/*
+*	Returns the decoded 565 pixels of the loaded glyph from the glyph cache.
+*	If the glyph isn't in the cache, it's decoded into the cache, first
+*	removing the least recently used glyphs as needed to make room.
+*	Returns nullptr, leaving the glyph data unread, if there's no cache or the
+*	glyph is empty or larger than the cache.
+*/
+const uint16_t* XFont::CachedGlyphPixels(void)
+{
+	const uint16_t*	pixels = nullptr;
+	uint32_t	glyphPixels = (uint32_t)mGlyph.rows * mGlyph.columns;
+	if (mGlyphCache &&
+		glyphPixels &&
+		glyphPixels <= mGlyphCacheSize)
+	{
+		mGlyphCacheUse++;
+		for (uint8_t index = 0; index < mGlyphCacheEntries; index++)
+		{
+			SCachedGlyph&	entry = mGlyphCache[index];
+			if (entry.dataOffset == mGlyphDataOffset &&
+				entry.font == mFont &&
+				entry.textColor == mTextColor &&
+				entry.bgColor == mTextBGColor)
+			{
+				entry.lastUse = mGlyphCacheUse;
+				pixels = &mGlyphCacheBuffer[entry.pixelIndex];
+				break;
+			}
+		}
+		if (!pixels)
+		{
+			while (mGlyphCacheEntries == mGlyphCacheMaxEntries ||
+				(uint32_t)(mGlyphCacheSize - mGlyphCacheUsed) < glyphPixels)
+			{
+				uint8_t	lruIndex = 0;
+				for (uint8_t index = 1; index < mGlyphCacheEntries; index++)
+				{
+					if (mGlyphCache[index].lastUse < mGlyphCache[lruIndex].lastUse)
+					{
+						lruIndex = index;
+					}
+				}
+				RemoveCachedGlyph(lruIndex);
+			}
+			/*
+			*	The entries are kept in pixel index order so the new glyph is
+			*	added to the end of both.
+			*/
+			SCachedGlyph&	entry = mGlyphCache[mGlyphCacheEntries++];
+			entry.font = mFont;
+			entry.dataOffset = mGlyphDataOffset;
+			entry.textColor = mTextColor;
+			entry.bgColor = mTextBGColor;
+			entry.pixelIndex = mGlyphCacheUsed;
+			entry.pixels = glyphPixels;
+			entry.lastUse = mGlyphCacheUse;
+			uint16_t*	glyphBuffer = &mGlyphCacheBuffer[mGlyphCacheUsed];
+			mGlyphCacheUsed += glyphPixels;
+			mFont->glyphData->Read(glyphPixels, glyphBuffer);
+			pixels = glyphBuffer;
+		}
+	}
+	return(pixels);
+}
+
+/***************************** RemoveCachedGlyph ******************************/
+/*
+*	Removes the cache entry inIndex and moves the pixels of the glyphs that
+*	follow it down so that the free pixels are always at the end.
+*/
+void XFont::RemoveCachedGlyph(
+	uint8_t	inIndex)
+{
+	uint16_t	removedPixels = mGlyphCache[inIndex].pixels;
+	uint16_t	toIndex = mGlyphCache[inIndex].pixelIndex;
+	uint16_t	fromIndex = toIndex + removedPixels;
+	memmove(&mGlyphCacheBuffer[toIndex], &mGlyphCacheBuffer[fromIndex],
+		(mGlyphCacheUsed - fromIndex) * sizeof(uint16_t));
+	mGlyphCacheUsed -= removedPixels;
+	mGlyphCacheEntries--;
+	for (uint8_t index = inIndex; index < mGlyphCacheEntries; index++)
+	{
+		mGlyphCache[index] = mGlyphCache[index+1];
+		mGlyphCache[index].pixelIndex -= removedPixels;
+	}
+}
+
+/******************************* GlyphIsClipped *******************************/
+/*
+*	Returns true if the loaded glyph block, drawn at the current display
+*	position, isn't entirely within the clip or the display's clip rect.
+*	Clipping is only supported when the glyph data is in the display's order,
+*	unrotated for 16 bit displays and rotated for 1 bit displays.
+*/
+bool XFont::GlyphIsClipped(void) const
+{
+	bool	isClipped = false;
+	bool	rotated = mFontHeader.rotated;
+	if (rotated == (mDisplay->BitsPerPixel() == 1))
+	{
+		uint16_t	startRow = mDisplay->GetRow();
+		uint16_t	startColumn = mDisplay->GetColumn();
+		uint16_t	blockColumns = GlyphBlockColumns();
+		isClipped = (mClipBottom &&
+						!rotated &&
+						(startRow < mClipTop ||
+							(startRow + mFontRows) > mClipBottom)) ||
+					(mClipRight &&
+						(mClipScroll ||
+							startColumn < mClipLeft ||
+							(startColumn + blockColumns) > mClipRight));
+		/*
+		*	The part of the block past the edge of the display isn't drawn
+		*	whether or not there's a clip rect, so it's only compared to the
+		*	display's clip rect within the display.
+		*/
+		if (!isClipped &&
+			mDisplay->HasClipRect())
+		{
+			uint32_t	blockRight = startColumn + blockColumns;
+			uint32_t	blockBottom = startRow + mFontRows;
+			if (blockRight > mDisplay->GetColumns())
+			{
+				blockRight = mDisplay->GetColumns();
+			}
+			if (blockBottom > mDisplay->GetRows())
+			{
+				blockBottom = mDisplay->GetRows();
+			}
+			isClipped = (!rotated &&
+							(startRow < mDisplay->GetClipTop() ||
+								blockBottom > mDisplay->GetClipBottom())) ||
+						startColumn < mDisplay->GetClipLeft() ||
+						blockRight > mDisplay->GetClipRight();
+		}
+	}
+	return(isClipped);
+}
+
+/***************************** GlyphBlockColumns ******************************/
+/*
+*	Returns the columns drawn for the loaded glyph: the blank columns before
+*	the glyph, the glyph, and the blank columns after the glyph (if any.)
+*/
+uint16_t XFont::GlyphBlockColumns(void) const
+{
+	uint16_t	columns = mGlyph.x + mGlyph.columns;
+	return(mGlyph.advanceX > columns ? mGlyph.advanceX : columns);
+}
+
+/****************************** DrawClippedGlyph ******************************/
+/*
+*	Draws the part of the loaded glyph block within the clip, including the
+*	background before, above, below and after the glyph.  The glyph data
+*	outside of the clip is skipped by the glyph data stream rather than sent to
+*	the display, and the glyph rows below the clip are never read.
+*	Without a horizontal clip, like DrawCharcode, nothing is drawn if the
+*	glyph doesn't fit horizontally, and false is returned if the column would
+*	wrap.  With a horizontal clip, false is returned once the right side of
+*	the clip is reached.  The display's clip rect only limits what's drawn,
+*	it doesn't stop the drawing.
+*/
+bool XFont::DrawClippedGlyph(void)
+{
+	bool		rotated = mFontHeader.rotated;
+	uint16_t	startRow = mDisplay->GetRow();
+	uint16_t	columns = mGlyph.columns;
+	uint16_t	blockColumns = GlyphBlockColumns();
+	uint16_t	displayColumns = mDisplay->GetColumns();
+	// The block's column, less any text columns scrolled out on the left.
+	int32_t		blockColumn = (int32_t)mDisplay->GetColumn() -
+								(mClipRight ? mClipScroll : 0);
+	bool	doContinue = mClipRight ||
+					(blockColumn + mGlyph.x + columns) <= displayColumns;
+	if (doContinue)
+	{
+		/*
+		*	One bit rotated data has the y offset shifted into the data by the
+		*	XFontR1BitDataStream or XFontRH1BitDataStream, and the rows are
+		*	8 pixel pages.
+		*/
+		int32_t	glyphTop = rotated ? 0 : mGlyph.y;
+		int32_t	glyphBottom = rotated ? (mGlyph.rows + mGlyph.y + 7)/8 :
+											glyphTop + mGlyph.rows;
+		// The visible rows and columns relative to the block
+		int32_t	visTop = 0;
+		int32_t	visBottom = mFontRows;
+		int32_t	visLeft = 0;
+		int32_t	visRight = blockColumns;
+		if (mClipBottom &&
+			!rotated)
+		{
+			if (mClipTop > startRow)
+			{
+				visTop = mClipTop - startRow;
+			}
+			if (((int32_t)mClipBottom - startRow) < visBottom)
+			{
+				visBottom = (int32_t)mClipBottom - startRow;
+			}
+		}
+		if (mClipRight)
+		{
+			if (mClipLeft > blockColumn)
+			{
+				visLeft = mClipLeft - blockColumn;
+			}
+			if ((mClipRight - blockColumn) < visRight)
+			{
+				visRight = mClipRight - blockColumn;
+			}
+		} else if ((blockColumn + visRight) > displayColumns)
+		{
+			visRight = displayColumns - blockColumn;
+		}
+		int32_t	blockRight = visRight;
+		if (mDisplay->HasClipRect())
+		{
+			if (!rotated)
+			{
+				if (((int32_t)mDisplay->GetClipTop() - startRow) > visTop)
+				{
+					visTop = (int32_t)mDisplay->GetClipTop() - startRow;
+				}
+				if (((int32_t)mDisplay->GetClipBottom() - startRow) < visBottom)
+				{
+					visBottom = (int32_t)mDisplay->GetClipBottom() - startRow;
+				}
+			}
+			if ((mDisplay->GetClipLeft() - blockColumn) > visLeft)
+			{
+				visLeft = mDisplay->GetClipLeft() - blockColumn;
+			}
+			if ((mDisplay->GetClipRight() - blockColumn) < visRight)
+			{
+				visRight = mDisplay->GetClipRight() - blockColumn;
+			}
+		}
+		if (visTop < visBottom)
 		{
-			rowsWritten += rows;
+			uint16_t	visRows = visBottom - visTop;
+			int32_t		left = visLeft;
+			int32_t		right = mGlyph.x < visRight ? mGlyph.x : visRight;
 			/*
-			*	Fill the pixels below the glyph with the BG color...
+			*	Clear the pixels before the glyph...
 			*/
-			if (columns &&
-				rowsWritten < mFontRows)
+			if (left < right)
 			{
-				uint16_t	savedColumn = mDisplay->GetColumn();
-				mDisplay->MoveTo(startRow + rowsWritten, startColumn+mGlyph.x);
-				mDisplay->FillBlock(mFontRows-rowsWritten, columns, mTextBGColor);
-				mDisplay->MoveToColumn(savedColumn);
+				mDisplay->MoveTo(startRow + visTop, blockColumn + left);
+				mDisplay->FillBlock(visRows, right - left, mTextBGColor);
 			}
-			mDisplay->MoveToRow(startRow);
-			doContinue = mDisplay->GetColumn() != 0;	// don't wrap
-			/*
-			*	Fill the pixels after the glyph (advance) with the BG color...
-			*/
-			if (doContinue)
+			// The visible glyph columns relative to the glyph
+			left = visLeft > mGlyph.x ? visLeft - mGlyph.x : 0;
+			right = (visRight - mGlyph.x) < columns ? visRight - mGlyph.x : columns;
+			if (left < right)
 			{
-				if (mGlyph.advanceX > (mGlyph.x + columns))
+				uint16_t	glyphColumn = blockColumn + mGlyph.x + left;
+				uint16_t	visColumns = right - left;
+				/*
+				*	Clear the pixels above the glyph...
+				*/
+				if (glyphTop > visTop)
 				{
-					mDisplay->FillBlock(mFontRows, mGlyph.advanceX - mGlyph.x - columns, mTextBGColor);
-					doContinue = mDisplay->GetColumn() != 0;	// don't wrap
+					mDisplay->MoveTo(startRow + visTop, glyphColumn);
+					mDisplay->FillBlock((glyphTop < visBottom ? glyphTop : visBottom) - visTop,
+											visColumns, mTextBGColor);
 				}
-				mDisplay->MoveToColumn(startColumn+mGlyph.advanceX);
+				/*
+				*	Draw the visible glyph rows and columns, skipping the data
+				*	outside of the clip.
+				*/
+				int32_t	top = glyphTop > visTop ? glyphTop : visTop;
+				int32_t	bottom = glyphBottom < visBottom ? glyphBottom : visBottom;
+				if (top < bottom)
+				{
+					/*
+					*	Rotated vertical data is a column of pages at a time
+					*	so the clipped columns on the left are skipped as a
+					*	block and the ones on the right are never read.
+					*/
+					if (rotated &&
+						!mFontHeader.horizontal)
+					{
+						if (left)
+						{
+							mFont->glyphData->Skip((uint32_t)left * glyphBottom);
+						}
+						mDisplay->MoveTo(startRow, glyphColumn);
+						mDisplay->SetAddressingMode(DisplayController::eVertical);
+						mDisplay->StreamCopyBlock(mFont->glyphData, bottom, visColumns);
+						mDisplay->SetAddressingMode(DisplayController::eHorizontal);
+					/*
+					*	Else the data is a row at a time.  When columns are
+					*	clipped, each row is copied separately, skipping the
+					*	clipped columns between the rows.
+					*/
+					} else
+					{
+						uint16_t	skipColumns = columns - visColumns;
+						uint16_t	rowsPerCopy = skipColumns ? 1 : bottom - top;
+						uint32_t	pixelsToSkip = (uint32_t)(top - glyphTop) * columns + left;
+						for (int32_t row = top; row < bottom; row += rowsPerCopy)
+						{
+							if (pixelsToSkip)
+							{
+								mFont->glyphData->Skip(pixelsToSkip);
+							}
+							mDisplay->MoveTo(startRow + row, glyphColumn);
+							mDisplay->StreamCopyBlock(mFont->glyphData, rowsPerCopy, visColumns);
+							pixelsToSkip = skipColumns;
+						}
+					}
+				}
+				/*
+				*	Clear the pixels below the glyph...
+				*/
+				if (glyphBottom < visBottom)
+				{
+					top = glyphBottom > visTop ? glyphBottom : visTop;
+					mDisplay->MoveTo(startRow + top, glyphColumn);
+					mDisplay->FillBlock(visBottom - top, visColumns, mTextBGColor);
+				}
+			}
+			left = (mGlyph.x + columns) > visLeft ? mGlyph.x + columns : visLeft;
+			right = visRight;
+			/*
+			*	Clear the pixels after the glyph (advance)...
+			*/
+			if (left < right)
+			{
+				mDisplay->MoveTo(startRow + visTop, blockColumn + left);
+				mDisplay->FillBlock(visRows, right - left, mTextBGColor);
 			}
 		}
-		break;
+		int32_t	nextColumn = blockColumn + mGlyph.advanceX;
+		if (mClipRight)
+		{
+			doContinue = nextColumn < mClipRight;
+			/*
+			*	If the next glyph starts left of the clip THEN
+			*	start it at the clip, scrolled by the difference.
+			*/
+			mClipScroll = 0;
+			if (nextColumn < mClipLeft)
+			{
+				mClipScroll = mClipLeft - nextColumn;
+				nextColumn = mClipLeft;
+			}
+		} else
+		{
+			doContinue = (blockColumn + blockRight) < displayColumns;	// don't wrap
+		}
+		mDisplay->MoveTo(startRow, doContinue ? nextColumn : 0);
 	}
 	return(doContinue);
 }
-	
+
 //#include <stdio.h>
 /********************************** DrawStr ***********************************/
 /*
 *	inUTF8Str is the string to be drawn starting at the current x,y position
 *	of the display.  A glyph will only be drawn if it completely fits without
-*	being truncated.  Drawing stops on the first truncation, the end of string,
-*	or the character limit, whichever occurs first.
+*	being truncated, or is within the horizontal clip when set.  Drawing stops
+*	on the first truncation, the end of string, or the character limit,
+*	whichever occurs first.
 *	A character limit of value 0 is unlimited.
 */
 void XFont::DrawStr(
@@ -337,7 +1253,7 @@ void XFont::DrawStr(
 	uint8_t		inFakeMonospaceWidth,
 	uint8_t		inCharacterLimit)
 {
-	const char*	strPtr = inUTF8Str;
+	UTF8Reader	reader(inUTF8Str);
 	uint16_t	startRow = mDisplay->GetRow();
 	uint16_t	strStartColumn = mDisplay->GetColumn();
 	mStartCol = strStartColumn;
@@ -348,16 +1264,51 @@ void XFont::DrawStr(
 		inFakeMonospaceWidth = 0;
 	}
 	uint8_t	charactersDrawn = 0;
-	for (uint16_t charcode = NextChar(strPtr);
+	uint16_t	leftEntryIndex = 0xFFFF;	// For kerning, 0xFFFF if none
+	uint16_t	leftTrailing = 0;
+	/*
+	*	If there's a line buffer THEN
+	*	try drawing the first line as a single block.  When successful,
+	*	the reader is left at the end of the line.
+	*/
+	if (mLineBuffer)
+	{
+		DrawComposedLine(reader, inFakeMonospaceWidth, inCharacterLimit, charactersDrawn);
+	}
+	for (uint32_t charcode = reader.Next();
 			charcode && (inCharacterLimit == 0 || charactersDrawn < inCharacterLimit);
-				charcode = NextChar(strPtr), charactersDrawn++)
+				charcode = reader.Next(), charactersDrawn++)
 	{
 		if (charcode >= ' ')
 		{
-			bool doContinue = DrawCharcode(charcode, inFakeMonospaceWidth);
+			bool doContinue = LoadGlyph(charcode);
+			if (doContinue)
+			{
+				int16_t	kerning = 0;
+				if (leftEntryIndex != 0xFFFF)
+				{
+					kerning = KerningWithLeft(leftEntryIndex, leftTrailing);
+				}
+				doContinue = DrawLoadedGlyph(inFakeMonospaceWidth, kerning);
+			}
+			/*
+			*	If the font has kerning THEN
+			*	this glyph is the left glyph of the next kerning pair.
+			*/
+			if (mNumKerningLefts &&
+				!inFakeMonospaceWidth)
+			{
+				leftEntryIndex = doContinue ? mCharcodeIndex : 0xFFFF;
+				leftTrailing = mGlyph.advanceX - mGlyph.x - mGlyph.columns;
+			}
 			if (!doContinue)
 			{
+				const char*	strPtr = reader.Position();
 				doContinue = SkipToNextLine(strPtr);
+				if (doContinue)
+				{
+					reader.SetPosition(strPtr);
+				}
 			}
 			if (doContinue)
 			{
@@ -376,6 +1327,13 @@ void XFont::DrawStr(
 			{
 				startRow = mDisplay->GetRow();
 				startColumn = 0;	// if empty line & inClearTillEOL
+				leftEntryIndex = 0xFFFF;
+				if (mLineBuffer)
+				{
+					charactersDrawn++;	// For the newline
+					DrawComposedLine(reader, inFakeMonospaceWidth, inCharacterLimit, charactersDrawn);
+					charactersDrawn--;	// The loop increments it
+				}
 				continue;
 			}
 		} else
@@ -398,7 +1356,13 @@ void XFont::DrawStr(
 /***************************** EraseTillEndOfLine *****************************/
 void XFont::EraseTillEndOfLine(void)
 {
-	mDisplay->FillTillEndColumn(mFontRows, mTextBGColor);
+	if (mClipRight)
+	{
+		EraseTillColumn(mClipRight);
+	} else
+	{
+		mDisplay->FillTillEndColumn(mFontRows, mTextBGColor);
+	}
 }
 
 /****************************** EraseTillColumn *******************************/
@@ -456,20 +1420,22 @@ void XFont::DrawAligned(
 	bool					inEraseUnusedArea)
 {
 	mDisplay->ClipX(inX, inWidth);
-	const char*	strPtr = inUTF8Str;
+	UTF8Reader	reader(inUTF8Str);
 	
 	/*
 	*	Measure each character and stop when the width is exceeded or the end
 	*	of the string, which ever occurs first.
 	*/
 	uint16_t	width = 0;
-	uint16_t 	charcode = NextChar(strPtr);
-	uint16_t	prevCharcode = 0;
+	uint32_t 	charcode = reader.Next();
+	uint32_t	prevCharcode = 0;
 	uint16_t	charCount = 0;
 	uint16_t	ellipsisCharCount = 0;
 	uint16_t	truncatedWidth = 0;
 	bool		needsTruncation = false;
-	for (; charcode; charcode = NextChar(strPtr), charCount++)
+	uint16_t	leftEntryIndex = 0xFFFF;	// For kerning, 0xFFFF if none
+	uint16_t	leftTrailing = 0;
+	for (; charcode; charcode = reader.Next(), charCount++)
 	{
 		if (charcode >= ' ')
 		{
@@ -477,7 +1443,21 @@ void XFont::DrawAligned(
 				LoadGlyph(charcode))
 			{
 				prevCharcode = charcode;
-				width += mGlyph.advanceX;
+				/*
+				*	The kerning is included the same way as MeasureStr so
+				*	that the width matches what DrawStr draws.
+				*/
+				int16_t	glyphWidth = mGlyph.advanceX;
+				if (mNumKerningLefts)
+				{
+					if (leftEntryIndex != 0xFFFF)
+					{
+						glyphWidth += KerningWithLeft(leftEntryIndex, leftTrailing);
+					}
+					leftEntryIndex = mCharcodeIndex;
+					leftTrailing = mGlyph.advanceX - mGlyph.x - mGlyph.columns;
+				}
+				width += glyphWidth;
 				if (width <= inWidth)
 				{
 					/*
@@ -488,7 +1468,7 @@ void XFont::DrawAligned(
 						(width + mEllipsisWidth) > inWidth)
 					{
 						ellipsisCharCount = charCount +1;
-						truncatedWidth = width - mGlyph.advanceX + mEllipsisWidth;
+						truncatedWidth = width - glyphWidth + mEllipsisWidth;
 					}
 					continue;
 				}
@@ -541,6 +1521,212 @@ void XFont::DrawAligned(
 
 }
 
+/***************************** DrawChangedGlyphs ******************************/
+/*
+*	The boxes of the new and previous strings are walked in parallel.  A new
+*	glyph is skipped when the previous string had the same glyph with the same
+*	box, and the glyph isn't overlapped by a glyph just drawn (negative
+*	kerning.)
+*/
+void XFont::DrawChangedGlyphs(
+	const char*				inUTF8Str,
+	const char*				inPrevUTF8Str,
+	int32_t					inX,
+	int32_t					inY,
+	int32_t					inWidth,
+	XFont::ETextAlignment	inAlignment,
+	uint8_t					inFakeMonospaceWidth)
+{
+	if (inFakeMonospaceWidth && mFontHeader.monospaced)
+	{
+		inFakeMonospaceWidth = 0;
+	}
+	int32_t	startColumn;
+	int32_t	prevStartColumn = inX;
+	if (AlignedStartColumn(inUTF8Str, inX, inWidth, inAlignment,
+								inFakeMonospaceWidth, startColumn))
+	{
+		/*
+		*	If the previous string didn't fit THEN
+		*	it was truncated by DrawAligned, redraw everything.
+		*/
+		if (inPrevUTF8Str &&
+			!AlignedStartColumn(inPrevUTF8Str, inX, inWidth, inAlignment,
+								inFakeMonospaceWidth, prevStartColumn))
+		{
+			inPrevUTF8Str = nullptr;
+			prevStartColumn = inX;
+		}
+		mDisplay->ClipX(inX, inWidth);
+		SGlyphBox	glyph;
+		SGlyphBox	prevGlyph;
+		UTF8Reader	reader(inUTF8Str);
+		UTF8Reader	prevReader(inPrevUTF8Str);
+		StartGlyphBoxes(startColumn, glyph);
+		StartGlyphBoxes(prevStartColumn, prevGlyph);
+		/*
+		*	If there is no previous string THEN
+		*	treat the entire width as previously drawn so that the unused
+		*	area gets erased.
+		*/
+		bool	morePrevGlyphs = inPrevUTF8Str != nullptr;
+		if (morePrevGlyphs)
+		{
+			morePrevGlyphs = NextGlyphBox(prevReader, prevGlyph, inFakeMonospaceWidth);
+		} else
+		{
+			prevGlyph.end = inX + inWidth;
+		}
+		int32_t	drawnEnd = startColumn;	// End of the last glyph drawn
+		mStartCol = startColumn;
+		while (NextGlyphBox(reader, glyph, inFakeMonospaceWidth))
+		{
+			while (morePrevGlyphs &&
+				prevGlyph.start < glyph.start)
+			{
+				morePrevGlyphs = NextGlyphBox(prevReader, prevGlyph, inFakeMonospaceWidth);
+			}
+			if (!morePrevGlyphs ||
+				prevGlyph.charcode != glyph.charcode ||
+				prevGlyph.start != glyph.start ||
+				prevGlyph.end != glyph.end ||
+				glyph.start < drawnEnd)
+			{
+				mDisplay->MoveTo(inY, glyph.column);
+				DrawCharcode(glyph.charcode, inFakeMonospaceWidth, glyph.kerning);
+				drawnEnd = glyph.end;
+			}
+		}
+		while (morePrevGlyphs)
+		{
+			morePrevGlyphs = NextGlyphBox(prevReader, prevGlyph, inFakeMonospaceWidth);
+		}
+		/*
+		*	Erase what remains of the previous string on either side.
+		*/
+		if (glyph.end < prevGlyph.end)
+		{
+			mDisplay->MoveTo(inY, glyph.end);
+			EraseTillColumn(prevGlyph.end);
+		}
+		if (prevStartColumn < startColumn)
+		{
+			mDisplay->MoveTo(inY, prevStartColumn);
+			EraseTillColumn(startColumn);
+		}
+	} else
+	{
+		DrawAligned(inUTF8Str, inX, inY, inWidth, inAlignment, true);
+	}
+}
+
+/***************************** AlignedStartColumn *****************************/
+/*
+*	Returns the starting column of inUTF8Str as drawn by DrawAligned.  Returns
+*	false if the string is wider than inWidth.
+*/
+bool XFont::AlignedStartColumn(
+	const char*				inUTF8Str,
+	int32_t					inX,
+	int32_t					inWidth,
+	XFont::ETextAlignment	inAlignment,
+	uint8_t					inFakeMonospaceWidth,
+	int32_t&				outColumn)
+{
+	UTF8Reader	reader(inUTF8Str);
+	int32_t		width = 0;
+	uint16_t	leftEntryIndex = 0xFFFF;	// For kerning, 0xFFFF if none
+	uint16_t	leftTrailing = 0;
+	for (uint32_t charcode = reader.Next(); charcode >= ' ' &&
+				LoadGlyph(charcode); charcode = reader.Next())
+	{
+		if (inFakeMonospaceWidth)
+		{
+			width += inFakeMonospaceWidth;
+		} else
+		{
+			width += mGlyph.advanceX;
+			if (mNumKerningLefts)
+			{
+				if (leftEntryIndex != 0xFFFF)
+				{
+					width += KerningWithLeft(leftEntryIndex, leftTrailing);
+				}
+				leftEntryIndex = mCharcodeIndex;
+				leftTrailing = mGlyph.advanceX - mGlyph.x - mGlyph.columns;
+			}
+		}
+	}
+	outColumn = inX;
+	if (inAlignment == eAlignRight)
+	{
+		outColumn += (inWidth - width);
+	} else if (inAlignment == eAlignCenter)
+	{
+		outColumn += ((inWidth - width)/2);
+	}
+	return(width <= inWidth);
+}
+
+/****************************** StartGlyphBoxes *******************************/
+void XFont::StartGlyphBoxes(
+	int32_t		inColumn,
+	SGlyphBox&	outBox)
+{
+	outBox.charcode = 0;
+	outBox.column = inColumn;
+	outBox.start = inColumn;
+	outBox.end = inColumn;
+	outBox.kerning = 0;
+	outBox.entryIndex = 0xFFFF;
+	outBox.trailing = 0;
+}
+
+/******************************** NextGlyphBox ********************************/
+/*
+*	Loads the next glyph of ioReader and calculates the columns it fills,
+*	following the previous glyph in ioBox.  The kerning and box are
+*	calculated the same way as DrawStr and DrawLoadedGlyph.  Returns false,
+*	leaving ioBox.end unchanged, at the end of the string, a control character,
+*	or a charcode that isn't in the font.
+*/
+bool XFont::NextGlyphBox(
+	UTF8Reader&		ioReader,
+	SGlyphBox&		ioBox,
+	uint8_t			inFakeMonospaceWidth)
+{
+	uint32_t	charcode = ioReader.Next();
+	bool	success = charcode >= ' ' && LoadGlyph(charcode);
+	if (success)
+	{
+		int16_t		x = mGlyph.x;
+		uint16_t	advanceX = mGlyph.advanceX;
+		int16_t		kerning = 0;
+		if (inFakeMonospaceWidth)
+		{
+			x = (inFakeMonospaceWidth - mGlyph.columns)/2;
+			advanceX = inFakeMonospaceWidth;
+		} else if (mNumKerningLefts)
+		{
+			if (ioBox.entryIndex != 0xFFFF)
+			{
+				kerning = KerningWithLeft(ioBox.entryIndex, ioBox.trailing);
+			}
+			ioBox.entryIndex = mCharcodeIndex;
+			ioBox.trailing = mGlyph.advanceX - mGlyph.x - mGlyph.columns;
+		}
+		ioBox.charcode = charcode;
+		ioBox.kerning = kerning;
+		ioBox.column = ioBox.end;
+		ioBox.start = (x + kerning) < 0 ? ioBox.column + x + kerning : ioBox.column;
+		ioBox.end = ioBox.column + advanceX + kerning;
+	} else
+	{
+		ioBox.charcode = 0;
+	}
+	return(success);
+}
+
 /***************************** DrawRightJustified *****************************/
 uint16_t XFont::DrawRightJustified(
 	const char*	inUTF8Str,
@@ -598,15 +1784,15 @@ uint16_t XFont::DrawCentered(
 *	The rest of the range is assumed to exist unless it's greater than the
 *	number of charcodes in the subset font.
 */
-uint8_t XFont::WidestGlyph(
+uint16_t XFont::WidestGlyph(
 	const char*	inUTF8RangeStr)
 {
-	uint8_t	widestGlyph = 0;
-	const char*	strPtr = inUTF8RangeStr;
-	for (uint16_t startChar = NextChar(strPtr); startChar;
-								startChar = NextChar(strPtr))
+	uint16_t	widestGlyph = 0;
+	UTF8Reader	reader(inUTF8RangeStr);
+	for (uint32_t startChar = reader.Next(); startChar;
+								startChar = reader.Next())
 	{
-		uint16_t	endChar = NextChar(strPtr);
+		uint32_t	endChar = reader.Next();
 		if (startChar <= endChar)
 		{
 			uint16_t	entryIndex = FindGlyph(startChar);
@@ -647,7 +1833,7 @@ uint8_t XFont::WidestGlyph(
 bool XFont::LoadFirstGlyph(
 	const char*	inUTF8Str)
 {
-	uint16_t charcode = NextChar(inUTF8Str);
+	uint32_t charcode = NextChar(inUTF8Str);
 	return(charcode != 0 && LoadGlyph(charcode));
 }
 
@@ -660,7 +1846,7 @@ bool XFont::MeasureStr(
 	uint8_t*	ioLineCount,
 	uint16_t*	outLineWidths)
 {
-	const char*	strPtr = inUTF8Str;
+	UTF8Reader	reader(inUTF8Str);
 	if (inFakeMonospaceWidth && mFontHeader.monospaced)
 	{
 		inFakeMonospaceWidth = 0;
@@ -674,16 +1860,18 @@ bool XFont::MeasureStr(
 	*	Simulate this by rounding up to the next even 8 pixel height.
 	*	This adjustedHeight is only different for rotated 1 bit.
 	*/
-	uint8_t adjustedHeight = (mFontHeader.rotated == 0 || (mFontHeader.height & 7) == 0) ?
-										mFontHeader.height : (mFontHeader.height & 0xF8) + 8;
+	uint16_t adjustedHeight = (mFontHeader.rotated == 0 || (mFontHeader.height & 7) == 0) ?
+										mFontHeader.height : (mFontHeader.height & ~7) + 8;
 
 	outHeight = adjustedHeight;
 	outWidth = 0;
 	uint16_t	lineWidth = 0;
 	uint8_t		lineWidthsSize = (ioLineCount && outLineWidths) ? *ioLineCount : 0;
 	uint8_t		lineCount = 0;
-	for (uint16_t charcode = NextChar(strPtr); charcode;
-								charcode = NextChar(strPtr))
+	uint16_t	leftEntryIndex = 0xFFFF;	// For kerning, 0xFFFF if none
+	uint16_t	leftTrailing = 0;
+	for (uint32_t charcode = reader.Next(); charcode;
+								charcode = reader.Next())
 	{
 		if (charcode >= ' ')
 		{
@@ -696,6 +1884,15 @@ bool XFont::MeasureStr(
 				} else
 				{
 					lineWidth += mGlyph.advanceX;
+					if (mNumKerningLefts)
+					{
+						if (leftEntryIndex != 0xFFFF)
+						{
+							lineWidth += KerningWithLeft(leftEntryIndex, leftTrailing);
+						}
+						leftEntryIndex = mCharcodeIndex;
+						leftTrailing = mGlyph.advanceX - mGlyph.x - mGlyph.columns;
+					}
 				}
 				continue;
 			}
@@ -712,6 +1909,7 @@ bool XFont::MeasureStr(
 			}
 			lineCount++;
 			lineWidth = 0;
+			leftEntryIndex = 0xFFFF;
 			outHeight += adjustedHeight;
 		}	// else ignore unsupported control characters
 	}
@@ -756,14 +1954,14 @@ bool XFont::SkipToNextLine(
 
 /********************************** NextChar **********************************/
 /*
-*	Handles 1, 2, and 3 byte sequences (1 to 0xFFFF)
+*	Handles 1, 2, 3, and 4 byte sequences (1 to 0x10FFFF)
 *	Returns the next charcode pointed to by inUTF8Str.
 *	Advances inUTF8Str to point to the start of the next sequence.
 */
-uint16_t XFont::NextChar(
+uint32_t XFont::NextChar(
 	const char*&	inUTF8Str)
 {
-	uint16_t	nextChar = 0;
+	uint32_t	nextChar = 0;
 	const uint8_t* strPtr = (uint8_t*)inUTF8Str;
 	uint16_t codepoint = *(strPtr++);
 	if (codepoint)
@@ -783,12 +1981,114 @@ uint16_t XFont::NextChar(
 							(((uint16_t)(strPtr[0]) & 0x3F) << 6) +
 								((uint16_t)(strPtr[1]) & 0x3F));
 			strPtr+=2;
+		// 4 byte sequence
+		} else if ((codepoint & 0xF8) == 0xF0)
+		{
+			nextChar = ((uint32_t)(codepoint & 7) << 0x12) +
+							((uint32_t)((uint16_t)(strPtr[0]) & 0x3F) << 0xC) +
+								(((uint16_t)(strPtr[1]) & 0x3F) << 6) +
+									((uint16_t)(strPtr[2]) & 0x3F);
+			strPtr+=3;
 		}
 		inUTF8Str = (const char*)strPtr;
 	}
 	return(nextChar);
 }
 
+/********************************* NextChars **********************************/
+/*
+*	Decodes up to inMaxCharcodes charcodes starting at ioUTF8Str into
+*	outCharcodes, stopping at the end of the string.  Runs of 7 bit
+*	characters are checked 4 bytes at a time.  Only aligned words are read
+*	so a read never extends past the word containing the terminating zero.
+*	Other sequences are decoded by NextChar.
+*	Returns the number of charcodes decoded, 0 at the end of the string.
+*	ioUTF8Str is advanced to the start of the next undecoded sequence.
+*/
+uint8_t XFont::NextChars(
+	const char*&	ioUTF8Str,
+	uint32_t*		outCharcodes,
+	uint8_t			inMaxCharcodes)
+{
+	const uint8_t*	strPtr = (const uint8_t*)ioUTF8Str;
+	uint8_t	numCharcodes = 0;
+	while (numCharcodes < inMaxCharcodes)
+	{
+		/*
+		*	If there's room for 4 charcodes AND
+		*	the next 4 bytes are aligned AND
+		*	none are zero or have the high bit set THEN
+		*	copy all 4.  (A byte minus 1 only sets the high bit when the
+		*	byte is zero.)
+		*/
+		if ((inMaxCharcodes - numCharcodes) >= 4 &&
+			((uintptr_t)strPtr & 3) == 0)
+		{
+			uint32_t	bytes;
+			memcpy(&bytes, strPtr, 4);
+			if (((bytes | (bytes - 0x01010101)) & 0x80808080) == 0)
+			{
+				outCharcodes[numCharcodes++] = strPtr[0];
+				outCharcodes[numCharcodes++] = strPtr[1];
+				outCharcodes[numCharcodes++] = strPtr[2];
+				outCharcodes[numCharcodes++] = strPtr[3];
+				strPtr += 4;
+				continue;
+			}
+		}
+		uint32_t	charcode = *strPtr;
+		if (charcode < 0x80)
+		{
+			if (charcode == 0)
+			{
+				break;
+			}
+			strPtr++;
+		} else
+		{
+			const char*	sequencePtr = (const char*)strPtr;
+			charcode = NextChar(sequencePtr);
+			strPtr = (const uint8_t*)sequencePtr;
+		}
+		outCharcodes[numCharcodes++] = charcode;
+	}
+	ioUTF8Str = (const char*)strPtr;
+	return(numCharcodes);
+}
+
+/********************************** Refill ************************************/
+/*
+*	Decodes the next batch of charcodes and returns the first, 0 if at the end
+*	of the string.
+*/
+uint32_t XFont::UTF8Reader::Refill(void)
+{
+	mBatchStr = mUTF8Str;
+	mCount = NextChars(mUTF8Str, mCharcodes, kBatchSize);
+	mIndex = mCount ? 1 : 0;
+	return(mCount ? mCharcodes[0] : 0);
+}
+
+/********************************* Position ***********************************/
+/*
+*	Returns the start of the sequence the next call to Next will decode.  The
+*	batch doesn't keep the length of each sequence, so the sequences already
+*	returned from the current batch are skipped using NextChar.
+*/
+const char* XFont::UTF8Reader::Position(void) const
+{
+	const char*	position = mUTF8Str;
+	if (mIndex < mCount)
+	{
+		position = mBatchStr;
+		for (uint8_t i = 0; i < mIndex; i++)
+		{
+			NextChar(position);
+		}
+	}
+	return(position);
+}
+
 /********************************* AdvanceRow *********************************/
 /*
 *	Relative move by N text rows and the absolute pixel column.
@@ -839,8 +2139,97 @@ uint16_t XFont::Calc565Color(
 XFontDataStream::XFontDataStream(
 	XFont*		inXFont,
 	DataStream*	inSourceStream)
-	: mXFont(inXFont), mSourceStream(inSourceStream)
+	: mXFont(inXFont), mSourceStream(inSourceStream),
+	  mBufferPtr(mBuffer), mBufferEnd(mBuffer)
+{
+}
+
+/************************************ Skip ************************************/
+/*
+*	Reads and discards the pixels.  Streams that can skip without
+*	unpacking each pixel override this.
+*/
+void XFontDataStream::Skip(
+	uint32_t	inPixels)
+{
+	uint16_t	pixels[16];
+	while (inPixels)
+	{
+		uint32_t	pixelsToRead = inPixels > 16 ? 16 : inPixels;
+		Read(pixelsToRead, pixels);
+		inPixels -= pixelsToRead;
+	}
+}
+
+/********************************** NextByte **********************************/
+/*
+*	This routine manages a small buffer rather than constantly calling Read of
+*	the source stream.  When the source stream's data is directly addressable,
+*	the data is unpacked from the source rather than being copied to mBuffer.
+*/
+uint8_t XFontDataStream::NextByte(void)
+{
+	if (mBufferPtr == mBufferEnd)
+	{
+		uint32_t	bytesInBuffer = mSourceStream->Acquire(mBufferPtr, 0xFFFF);
+		if (bytesInBuffer == 0)
+		{
+			mBufferPtr = mBuffer;
+			bytesInBuffer = mSourceStream->Read(sizeof(mBuffer), mBuffer);
+		}
+		mBufferEnd = &mBufferPtr[bytesInBuffer];
+	}
+	if (mBufferPtr != mBufferEnd)
+	{
+		return(*(mBufferPtr++));
+	}
+	return(0);
+}
+
+/********************************* SkipBytes **********************************/
+/*
+*	Skips inLength bytes of the source data, first from the buffer, then by
+*	seeking the source stream.
+*/
+void XFontDataStream::SkipBytes(
+	uint32_t	inLength)
+{
+	uint32_t	bytesInBuffer = (uint32_t)(mBufferEnd - mBufferPtr);
+	if (inLength <= bytesInBuffer)
+	{
+		mBufferPtr += inLength;
+	} else
+	{
+		mBufferPtr = mBufferEnd;
+		mSourceStream->Seek(inLength - bytesInBuffer, eSeekCur);
+	}
+}
+
+/********************************** SkipBits **********************************/
+/*
+*	Skips inBits of the packed source data, LSB first.  ioByteIn and
+*	ioBitsInByteIn are the subclass's partially consumed byte.
+*/
+void XFontDataStream::SkipBits(
+	uint32_t	inBits,
+	uint8_t&	ioByteIn,
+	uint8_t&	ioBitsInByteIn)
 {
+	if (inBits < ioBitsInByteIn)
+	{
+		ioByteIn >>= inBits;
+		ioBitsInByteIn -= inBits;
+	} else
+	{
+		inBits -= ioBitsInByteIn;
+		SkipBytes(inBits >> 3);
+		ioBitsInByteIn = inBits & 7;
+		if (ioBitsInByteIn)
+		{
+			ioByteIn = NextByte() >> ioBitsInByteIn;
+			ioBitsInByteIn = 8 - ioBitsInByteIn;
+		}
+	}
 }
 
 /******************************** MakeCurrent *********************************/
@@ -31,26 +31,107 @@ class DisplayController;
 
 class XFont
 {
+	friend class XTextLayout;
 public:
 	struct Font
 	{
+		/*
+		*	header points to a FontHeader16 for version 3 (16 bit metrics)
+		*	fonts.  The version is in the first byte of both structs.
+		*/
 		const FontHeader*	header;
 		const CharcodeRun*	charcodeRuns;
 		const uint16_t*		glyphDataOffsets;
 		XFontDataStream*	glyphData;
+		/*
+		*	glyphDataSegments is only used by fonts with more than 64KB of
+		*	glyph data.  When not null, there is one base offset per 256
+		*	glyphDataOffsets entries that's added to the entry's offset.
+		*/
+		const uint32_t*		glyphDataSegments;
+		/*
+		*	glyphDataDeltas is only used by fonts with delta encoded offsets.
+		*	When not null, glyphDataOffsets contains one checkpoint offset per
+		*	16 entries and glyphDataDeltas contains the size of each entry.
+		*/
+		const uint8_t*		glyphDataDeltas;
+		/*
+		*	charcodePlanes is only used by version 2 fonts containing
+		*	charcodes above 0xFFFF.  When not null, charcodeRuns contains the
+		*	runs of each plane and charcodePlanes indexes them.
+		*/
+		const CharcodePlane*	charcodePlanes;
+		/*
+		*	kerningLefts and kerningPairs are only used by fonts exported
+		*	with kerning pairs.  When not null, the kerning is applied by
+		*	DrawStr and MeasureStr.
+		*/
+		const KerningLeft*	kerningLefts;
+		const KerningPair*	kerningPairs;
+		/*
+		*	staticStrings is only used by fonts exported with static strings.
+		*	When not null, it contains the glyph data offset of each
+		*	pre-rendered string (see DrawStaticString.)
+		*/
+		const uint32_t*		staticStrings;
 							Font(
 								const FontHeader*	inHeader,
 								const CharcodeRun*	inCharcodeRuns,
 								const uint16_t*		inGlyphDataOffsets,
-								XFontDataStream*	inGlyphData = nullptr)
+								XFontDataStream*	inGlyphData = nullptr,
+								const uint32_t*		inGlyphDataSegments = nullptr,
+								const uint8_t*		inGlyphDataDeltas = nullptr,
+								const CharcodePlane*	inCharcodePlanes = nullptr,
+								const KerningLeft*	inKerningLefts = nullptr,
+								const KerningPair*	inKerningPairs = nullptr,
+								const uint32_t*		inStaticStrings = nullptr)
 								: header(inHeader),
 								  charcodeRuns(inCharcodeRuns),
 								  glyphDataOffsets(inGlyphDataOffsets),
-								  glyphData(inGlyphData){}
+								  glyphData(inGlyphData),
+								  glyphDataSegments(inGlyphDataSegments),
+								  glyphDataDeltas(inGlyphDataDeltas),
+								  charcodePlanes(inCharcodePlanes),
+								  kerningLefts(inKerningLefts),
+								  kerningPairs(inKerningPairs),
+								  staticStrings(inStaticStrings){}
 								  
 		XFont*				GetXFont(void) const
 								{return(glyphData->GetXFont());}
 		XFont*				MakeCurrent(void);
+	};
+	/*
+	*	UTF8Reader returns the charcodes of a UTF-8 string one at a time,
+	*	the same as NextChar, but decodes them in batches using NextChars.
+	*	Once the end of the string is reached Next returns 0.
+	*	Position returns the start of the sequence Next will decode, and
+	*	SetPosition continues reading from a position within the string.
+	*/
+	class UTF8Reader
+	{
+	public:
+							UTF8Reader(
+								const char*				inUTF8Str)
+								: mUTF8Str(inUTF8Str), mBatchStr(inUTF8Str),
+								  mIndex(0), mCount(0){}
+		uint32_t			Next(void)
+								{return(mIndex < mCount ? mCharcodes[mIndex++] : Refill());}
+		const char*			Position(void) const;
+		void				SetPosition(
+								const char*				inUTF8Str)
+								{mUTF8Str = inUTF8Str; mIndex = 0; mCount = 0;}
+		enum
+		{
+			kBatchSize = 8
+		};
+	protected:
+		const char*			mUTF8Str;	// Start of the next batch
+		const char*			mBatchStr;	// Start of the current batch
+		uint8_t				mIndex;
+		uint8_t				mCount;
+		uint32_t			mCharcodes[kBatchSize];
+		
+		uint32_t			Refill(void);
 	};
 							XFont(void);
 
@@ -84,12 +165,112 @@ public:
 	bool					MoveTo(
 								uint16_t				inTextRow,
 								uint16_t				inColumn = 0) const;
+	/*
+	*	SetVerticalClip: Limits drawing to the display rows inTopRow to
+	*	inBottomRow -1.  A glyph whose rows aren't all within the clip rows is
+	*	drawn clipped rather than failing to draw.  The glyph rows above the
+	*	clip aren't sent to the display and the rows below aren't decoded.
+	*	inBottomRow should not exceed the display rows.  An inBottomRow of 0
+	*	removes the clip (the default.)
+	*	Only unrotated fonts on 16 bit displays are clipped.
+	*/
+	void					SetVerticalClip(
+									uint16_t				inTopRow,
+									uint16_t				inBottomRow)
+									{mClipTop = inTopRow; mClipBottom = inBottomRow;}
+	/*
+	*	SetHorizontalClip: Limits drawing to the display columns inLeftColumn
+	*	to inRightColumn -1.  Glyphs partially within the clip columns are
+	*	drawn clipped, glyphs left of the clip are skipped, and drawing stops
+	*	after the first glyph that reaches inRightColumn.  The clipped glyph
+	*	columns are skipped in the glyph data rather than drawn.
+	*	inScrollColumns shifts the text drawn from the current column left
+	*	by that many columns (e.g. for a marquee.)  inRightColumn should not
+	*	exceed the display columns.  An inRightColumn of 0 removes the clip
+	*	(the default.)
+	*	Only unrotated fonts on 16 bit displays and rotated fonts on 1 bit
+	*	displays are clipped.
+	*/
+	void					SetHorizontalClip(
+									uint16_t				inLeftColumn,
+									uint16_t				inRightColumn,
+									uint16_t				inScrollColumns = 0)
+									{mClipLeft = inLeftColumn; mClipRight = inRightColumn;
+										mClipScroll = inScrollColumns;}
+	/*
+	*	SetLineBuffer: Opt-in line rendering.  When set, DrawStr composes each
+	*	line of glyphs and their background in inBuffer and sends it to the
+	*	display as a single block, rather than several fills and a copy per
+	*	glyph.  inBufferPixels is the RAM budget in 16 bit pixels.  A line
+	*	wider than inBufferPixels / FontRows(), or one that doesn't fit on
+	*	the display, is drawn glyph by glyph as it would be without a buffer.
+	*	Only unrotated fonts on 16 bit displays without a clip are composed.
+	*	Passing nullptr removes the buffer (the default.)
+	*/
+	void					SetLineBuffer(
+									uint16_t*				inBuffer,
+									uint16_t				inBufferPixels)
+									{mLineBuffer = inBuffer; mLineBufferPixels = inBufferPixels;}
+	/*
+	*	SCachedGlyph: One entry of the glyph cache.  The glyph is identified
+	*	by its font and glyph data offset, and the decoded 565 pixels depend
+	*	on the text and background colors.
+	*/
+	struct SCachedGlyph
+	{
+		const Font*	font;
+		uint32_t	dataOffset;	// Of the glyph header within the glyph data
+		uint16_t	textColor;
+		uint16_t	bgColor;
+		uint16_t	pixelIndex;	// Of the first pixel within the cache buffer
+		uint16_t	pixels;		// rows * columns
+		uint32_t	lastUse;	// For the LRU
+	};
+	/*
+	*	SetGlyphCache: Opt-in cache of decoded glyphs.  When set, the decoded
+	*	565 pixels of each glyph drawn are kept in inBuffer and copied to the
+	*	display the next time the glyph is drawn with the same colors,
+	*	rather than decoded again.  inBufferBytes is the RAM budget for the
+	*	pixels and inMaxEntries the maximum number of glyphs cached.  When
+	*	either is exhausted the least recently used glyphs are removed.
+	*	Only unrotated fonts on 16 bit displays are cached.  Setting the
+	*	cache empties it.  Passing nullptr removes the cache (the default.)
+	*/
+	void					SetGlyphCache(
+									SCachedGlyph*			inEntries,
+									uint8_t					inMaxEntries,
+									uint16_t*				inBuffer,
+									uint16_t				inBufferBytes);
+	/*
+	*	inKerning is the kerning between the previous glyph and this glyph.
+	*	Negative kerning must not exceed the blank columns between the two
+	*	glyphs (see KerningWithLeft.)
+	*/
 	bool					DrawCharcode(
-								uint16_t				inCharcode,
-								uint8_t					inFakeMonospaceWidth = 0);
+								uint32_t				inCharcode,
+								uint8_t					inFakeMonospaceWidth = 0,
+								int16_t					inKerning = 0);
+	/*
+	*	DrawLoadedGlyph: Same as DrawCharcode for the glyph loaded by
+	*	LoadGlyph or LoadCachedGlyph.
+	*/
+	bool					DrawLoadedGlyph(
+								uint8_t					inFakeMonospaceWidth = 0,
+								int16_t					inKerning = 0);
+	/*
+	*	DrawStaticString: Draws the pre-rendered string inStringID at the
+	*	current display position as a single block, the height of the font,
+	*	including its background.  The current column is advanced by the
+	*	width of the string.  The string IDs are the indexes of the strings
+	*	listed in the exported font's C header.  Returns false if the font has
+	*	no static strings or the string doesn't fit.
+	*/
+	bool					DrawStaticString(
+								uint16_t				inStringID);
 	/*
 	*	Draws the UTF-8 string at the current display x,y position, stopping
-	*	on the first character that doesn't fit without being truncated.  At
+	*	on the first character that doesn't fit without being truncated (or
+	*	reaches the right side of the horizontal clip when set.)  At
 	*	that point the string is scanned for a newline. If a newline is found
 	*	and there is space to start a newline, the drawing continues on the new
 	*	line.
@@ -160,6 +341,32 @@ public:
 								int32_t					inWidth,
 								ETextAlignment			inAlignment = eAlignLeft,
 								bool					inEraseUnusedArea = false);
+	/*
+	*	DrawChangedGlyphs draws inUTF8Str the same as DrawAligned with
+	*	inEraseUnusedArea set, except only the glyphs that differ from
+	*	inPrevUTF8Str are drawn.  inPrevUTF8Str is the string currently
+	*	displayed, drawn by DrawAligned or DrawChangedGlyphs using the same
+	*	position, width, alignment and inFakeMonospaceWidth.  A glyph is only
+	*	skipped when the same glyph was previously drawn at the same columns.
+	*	The columns of the previous string not covered by the new string are
+	*	erased.  This is used by fields such as clocks and counters where most
+	*	of the glyphs don't change between updates.
+	*
+	*	When inPrevUTF8Str is nullptr or it's wider than inWidth, the entire
+	*	string is drawn.  If inUTF8Str is wider than inWidth, DrawAligned is
+	*	called instead (without inFakeMonospaceWidth.)
+	*	See DrawStr for inFakeMonospaceWidth.
+	*
+	*	Not supported by 1 bit displays.
+	*/
+	void					DrawChangedGlyphs(
+								const char*				inUTF8Str,
+								const char*				inPrevUTF8Str,
+								int32_t					inX,
+								int32_t					inY,
+								int32_t					inWidth,
+								ETextAlignment			inAlignment = eAlignLeft,
+								uint8_t					inFakeMonospaceWidth = 0);
 	void					EraseTillEndOfLine(void);
 	void					EraseTillColumn(
 								uint16_t				inColumn);
@@ -167,24 +374,43 @@ public:
 								uint16_t				inColumn);
 	uint16_t				GetLastStartColumn(void) const
 								{return(mStartCol);}
-	uint8_t					FontRows(void) const
+	uint16_t				FontRows(void) const
 								{return(mFontRows);}
-	void					DrawLoadedGlyph(void);
 	uint16_t				FindGlyph(
-								uint16_t				inCharcode);
+								uint32_t				inCharcode);
 	bool					LoadGlyph(
-								uint16_t				inCharcode);
+								uint32_t				inCharcode);
 	bool					LoadGlyphHeader(
 								uint16_t				inEntryIndex);
+	bool					LoadGlyphHeaderAt(
+								uint32_t				inGlyphDataOffset);
+	uint32_t				GlyphDataOffset(
+								uint16_t				inEntryIndex) const;
+	/*
+	*	LoadCachedGlyph: Loads a glyph from its glyph data offset and the
+	*	header previously loaded by LoadGlyphHeader, without searching for
+	*	the glyph or reading its header (see XTextLayout.)
+	*/
+	void					LoadCachedGlyph(
+								uint32_t				inGlyphDataOffset,
+								const GlyphHeader16&	inGlyph);
 	bool					LoadFirstGlyph(
 								const char*				inUTF8Str);
 	/*
+	*	Returns the kerning pair adjustment of the passed left and right
+	*	glyph entry indexes, 0 if none.  The pairs of the last left glyph
+	*	are cached so that consecutive lookups only search its pairs.
+	*/
+	int16_t					Kerning(
+								uint16_t				inLeftEntryIndex,
+								uint16_t				inRightEntryIndex);
+	/*
 	*	Returns the widest glyph in the passed range string.  The format of the
 	*	range string is the same as you would use within SubsetFontCreator.
 	*	Returns zero if any of the chars within inUTF8RangeStr don't exist or
 	*	the format of inUTF8RangeStr is invalid.
 	*/
-	uint8_t					WidestGlyph(
+	uint16_t				WidestGlyph(
 								const char*				inUTF8RangeStr);
 	/*
 	*	inUTF8Str is the string to be measured
@@ -203,11 +429,11 @@ public:
 								uint8_t*				ioLineCount = nullptr,
 								uint16_t*				outLineWidths = nullptr);
 	// Returns the last glyph loaded by LoadGlyph
-	const GlyphHeader&		Glyph(void) const
+	const GlyphHeader16&	Glyph(void) const
 								{return(mGlyph);}
-	uint16_t				Charcode(void) const
+	uint32_t				Charcode(void) const
 								{return(mCharcode);}
-	const FontHeader&		GetFontHeader(void) const
+	const FontHeader16&		GetFontHeader(void) const
 								{return(mFontHeader);}
 	void					SetTextColor(
 								uint16_t				inTextColor)
@@ -221,8 +447,16 @@ public:
 								{return(mTextBGColor);}
 	uint16_t				Calc565Color(
 								uint8_t					inTint);
-	static uint16_t			NextChar(
+	static uint32_t			NextChar(
 								const char*&			inUTF8Str);
+	/*
+	*	NextChars: Decodes up to inMaxCharcodes charcodes into outCharcodes.
+	*	Returns the number decoded, 0 at the end of the string.
+	*/
+	static uint8_t			NextChars(
+								const char*&			ioUTF8Str,
+								uint32_t*				outCharcodes,
+								uint8_t					inMaxCharcodes);
 	static bool 			SkipToNextLine(
 								const char*&			inUTF8Str);
 	enum E565Colors
@@ -243,19 +477,84 @@ public:
 	};
 
 protected:
-	FontHeader			mFontHeader;
+	FontHeader16		mFontHeader;	// Version 1 and 2 headers are widened
 	Font*				mFont;
 	DisplayController*	mDisplay;
 	uint16_t			mTextColor;
 	uint16_t			mTextBGColor;
 	uint16_t			mStartCol;	// Starting column of last call to DrawStr
-	GlyphHeader			mGlyph;
-	uint8_t				mFontRows;
-	uint16_t			mCharcode;		// Currently loaded glyph charcode
+	GlyphHeader16		mGlyph;
+	uint16_t			mFontRows;
+	uint32_t			mCharcode;		// Currently loaded glyph charcode
 	uint16_t			mCharcodeIndex; // Currently loaded glyph index
 	bool				mHighlightEnabled;
-	uint8_t				mEllipsisWidth;	// 0 if current font has no ellipsis.
+	uint16_t			mEllipsisWidth;	// 0 if current font has no ellipsis.
+	// Kerning, the pairs of mKernLeftIndex are cached
+	uint16_t			mNumKerningLefts;	// 0 if current font has no kerning.
+	uint16_t			mKernLeftIndex;
+	uint16_t			mKernPairIndex;
+	uint16_t			mKernPairEnd;
+	uint16_t			mClipTop;
+	uint16_t			mClipBottom;	// 0 if no vertical clip
+	uint16_t			mClipLeft;
+	uint16_t			mClipRight;		// 0 if no horizontal clip
+	uint16_t			mClipScroll;	// Text columns still to be scrolled out
+	uint16_t*			mLineBuffer;	// nullptr if no line rendering
+	uint16_t			mLineBufferPixels;
+	uint32_t			mGlyphDataOffset;	// Currently loaded glyph data offset
+	SCachedGlyph*		mGlyphCache;		// nullptr if no glyph cache
+	uint8_t				mGlyphCacheMaxEntries;
+	uint8_t				mGlyphCacheEntries;	// In pixel index order
+	uint16_t*			mGlyphCacheBuffer;
+	uint16_t			mGlyphCacheSize;	// In pixels
+	uint16_t			mGlyphCacheUsed;	// In pixels
+	uint32_t			mGlyphCacheUse;		// Incremented per lookup, for the LRU
 	static const uint16_t	kEllipsisCharcode;
+	/*
+	*	The columns a glyph fills when drawn by DrawStr, used by
+	*	DrawChangedGlyphs.  start is less than column when negative kerning
+	*	backs the glyph up over the previous glyph.  end is the column of the
+	*	next glyph.
+	*/
+	struct SGlyphBox
+	{
+		uint32_t	charcode;
+		int32_t		column;
+		int32_t		start;
+		int32_t		end;
+		int16_t		kerning;
+		uint16_t	entryIndex;	// For kerning, 0xFFFF if none
+		uint16_t	trailing;
+	};
+
+	bool					GlyphIsClipped(void) const;
+	uint16_t				GlyphBlockColumns(void) const;
+	bool					DrawClippedGlyph(void);
+	bool					DrawComposedLine(
+								UTF8Reader&				ioReader,
+								uint8_t					inFakeMonospaceWidth,
+								uint8_t					inCharacterLimit,
+								uint8_t&				ioCharactersDrawn);
+	const uint16_t*			CachedGlyphPixels(void);
+	void					RemoveCachedGlyph(
+								uint8_t					inIndex);
+	int16_t					KerningWithLeft(
+								uint16_t				inLeftEntryIndex,
+								uint16_t				inLeftTrailing);
+	bool					AlignedStartColumn(
+								const char*				inUTF8Str,
+								int32_t					inX,
+								int32_t					inWidth,
+								ETextAlignment			inAlignment,
+								uint8_t					inFakeMonospaceWidth,
+								int32_t&				outColumn);
+	void					StartGlyphBoxes(
+								int32_t					inColumn,
+								SGlyphBox&				outBox);
+	bool					NextGlyphBox(
+								UTF8Reader&				ioReader,
+								SGlyphBox&				ioBox,
+								uint8_t					inFakeMonospaceWidth);
 };
 
 #endif // XFont_h
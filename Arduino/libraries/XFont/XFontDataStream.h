@@ -36,8 +36,26 @@ public:
 								{return(mXFont);}
 	DataStream*				GetSourceStream(void)
 								{return(mSourceStream);}
+	/*
+	*	Skip: Skips inPixels of the current glyph's data, as if they were
+	*	read.  Used to start drawing a glyph from a row other than its first.
+	*/
+	virtual void			Skip(
+								uint32_t				inPixels);
 protected:
 	XFont*		mXFont;
 	DataStream*	mSourceStream;
+
+	uint8_t		mBuffer[32];
+	const uint8_t*	mBufferPtr;	// Points to either mBuffer or the source data
+	const uint8_t*	mBufferEnd;
+	
+	uint8_t					NextByte(void);
+	void					SkipBytes(
+								uint32_t				inLength);
+	void					SkipBits(
+								uint32_t				inBits,
+								uint8_t&				ioByteIn,
+								uint8_t&				ioBitsInByteIn);
 };
 #endif // XFontDataStream_h
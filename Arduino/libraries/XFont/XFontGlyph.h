@@ -39,7 +39,7 @@ struct FontHeader
 {
 	// A bit field can be used here because both the Arduino IDE and Xcode
 	// use the GCC compiler.  GCC stores/formats the data exactly as shown.
-	uint8_t		version : 4,	// structs version, currently 1
+	uint8_t		version : 4,	// structs version, 1, 2 (charcode planes) or 3 (16 bit metrics)
 				oneBit : 1,		// One bit per pixel, else 8 bit (antialiased)
 				rotated : 1,	// each data byte represents 8 pixels of a column (applies to 1 bit only)
 				horizontal : 1,	// addressing for rotated data, else vertical (applies to 1 bit only)
@@ -52,6 +52,53 @@ struct FontHeader
 	uint16_t	numCharCodes;	// size of the GlyphDataOffsets array.
 };
 
+/*
+*	Version 3 is for fonts whose metrics don't fit in 8 bits (e.g. a height
+*	greater than 255.)  The FontHeader and every GlyphHeader are replaced by
+*	FontHeader16 and GlyphHeader16.  The first byte (the version bit field) is
+*	the same as FontHeader so the version can be checked before knowing which
+*	header is being read.  Version 3 always has CharcodePlanes, even when all
+*	of the charcodes are 0xFFFF or less (see version 2 below.)
+*
+*	XFont always uses FontHeader16 and GlyphHeader16 internally.  Version 1
+*	and 2 headers are widened when loaded.
+*/
+struct FontHeader16
+{
+	uint8_t		version : 4,	// structs version, 3
+				oneBit : 1,
+				rotated : 1,
+				horizontal : 1,
+				monospaced : 1;
+	uint8_t		flags;			// EFontFlags, also keeps the 16 bit fields aligned
+	uint16_t 	ascent;
+	int16_t 	descent;
+	uint16_t 	height;
+	uint16_t	width;
+	uint16_t	numCharcodeRuns;
+	uint16_t	numCharCodes;
+};
+
+/*
+*	The flags describe optional features of the xfnt file so that it can be
+*	read without knowing which options were used to create it.  Version 3
+*	stores the flags in FontHeader16.flags.  The 8 bit FontHeader has no room
+*	for them, but a xfnt file is written by the host compiler, where the
+*	FontHeader is padded to align numCharcodeRuns.  Versions 1 and 2 store
+*	the flags in this padding byte (kFontHeaderFlagsOffset.)  XFont doesn't
+*	need the flags, these features are identified by the glyph data or by
+*	the XFont::Font pointers.
+*/
+enum EFontFlags
+{
+	eRawGlyphsFlag			= 1,	// Has raw 8 bit glyphs (see the glyph data below)
+	eKerningPairsFlag		= 2,	// Has the kerning arrays (see KerningLeft below)
+	eStaticStringsFlag		= 4,	// Has static strings (see XFont::DrawStaticString)
+	eSegmentedOffsetsFlag	= 8,	// Has segmented glyph data offsets
+	e32BitOffsetsFlag		= 0x10	// Has 32 bit glyph data offsets
+};
+const uint8_t	kFontHeaderFlagsOffset = 5;
+
 /*
 *	CharcodeRuns is an array of CharcodeRun of consecutive charcodes.  This makes
 *	it somewhat efficient in locating glyph data.  The runs are sorted
@@ -75,13 +122,79 @@ struct CharcodeRun
 };
 
 /*
-*	GlyphDataOffsets is an array of uint16_t, one offset per glyph.
+*	Version 2 adds charcodes above 0xFFFF (e.g. emoji, SMP symbols.)
+*	The charcodes are split into planes of 0x10000 charcodes (charcode >> 16).
+*	CharcodeRuns contains the runs of each plane, one plane after the other,
+*	where start is the low 16 bits of the charcode.  Each plane's runs end with
+*	its own sanity check run {0xFFFF, entryIndex following the plane's last
+*	glyph}.  numCharcodeRuns is the total, including the sanity check runs.
+*
+*	CharcodeRuns is followed by CharcodePlanes, one CharcodePlane per plane
+*	sorted lowest to highest, then a last {0xFFFF, numCharcodeRuns} plane.
+*	The runs of a plane are from its runIndex to the next plane's runIndex.
+*	The lookup is a short linear search for the plane followed by the same
+*	binary search of the plane's runs as version 1.
+*
+*	Version 1 fonts have no CharcodePlanes and no charcodes above 0xFFFF.
+*/
+struct CharcodePlane
+{
+	uint16_t	plane;		// charcode >> 16
+	uint16_t	runIndex;	// Index of the first CharcodeRun of this plane
+};
+
+/*
+*	GlyphDataOffsets is an array of uint16_t, one offset per glyph.  It follows
+*	CharcodeRuns (version 1) or CharcodePlanes (version 2 and 3.)
 *	The actual length is numCharCodes +1.  The +1 accounts for the extra offset
 *	used to calculate the size of the last glyph.
 *
 *	The first Glyph in a xfnt file is immediately after the last glyph offset.
 *	GlyphDataOffsets are relative to the start of the glyph data (first glyph.)
+*
+*	Segmented offsets (for more than 64KB of glyph data):
+*	The GlyphDataOffsets array is followed by an array of uint32_t segment
+*	base offsets, one per 256 GlyphDataOffsets entries, (numCharCodes+256)/256.
+*	The offset of entry N is GlyphDataOffsets[N] + SegmentBase[N/256].
+*	Segmented offsets are flagged by eSegmentedOffsetsFlag, and 32 bit offsets
+*	by e32BitOffsetsFlag.  XFont is passed the segment bases by the sketch.
+*
+*	Delta encoded offsets (C headers only):
+*	When the glyph data is stored in order and no glyph entry is larger than
+*	255 bytes, a C header replaces GlyphDataOffsets with two smaller arrays:
+*	a uint16_t checkpoint offset for every 16th entry, (numCharCodes >> 4) +1,
+*	and a uint8_t delta (entry size) per entry, numCharCodes.  The offset of
+*	entry N is Checkpoint[N >> 4] plus the sum of the deltas from entry
+*	N & ~0xF up to, but not including, entry N.
 */
+const uint8_t	kGlyphDataCheckpointShift = 4;	// One checkpoint per 16 entries
+
+/*
+*	Kerning (optional, see SubsetFontCreator::eKerningPairs)
+*	KerningLefts is an array of KerningLeft sorted lowest to highest by
+*	entryIndex, one per glyph that is the left glyph of at least one kerning
+*	pair, followed by a last {0xFFFF, numKerningPairs}.  The KerningPairs of a
+*	left glyph are from its pairIndex to the next KerningLeft's pairIndex,
+*	sorted lowest to highest by the right glyph's entryIndex.  An entryIndex
+*	is the glyph's index within GlyphDataOffsets.  adjust is added to the
+*	left glyph's advanceX when followed by the right glyph.
+*
+*	In a xfnt file the KerningLefts array followed by the KerningPairs array
+*	are at the end of the file, after the glyph data (or after the
+*	GlyphDataOffsets when the glyph data is stored separately.)  Like
+*	segmented offsets the kerning arrays aren't flagged in the FontHeader.
+*/
+struct KerningLeft
+{
+	uint16_t	entryIndex;	// Entry index of the left glyph
+	uint16_t	pairIndex;	// Index of the first KerningPair of this glyph
+};
+
+struct KerningPair
+{
+	uint16_t	entryIndex;	// Entry index of the right glyph
+	int16_t		adjust;		// in pixels, usually negative
+};
 
 /*
 *	The glyphs immediately follow the GlyphDataOffsets array.
@@ -97,6 +210,20 @@ struct GlyphHeader
 	uint8_t columns;
 };
 
+/*
+*	The version 3 (16 bit metrics) glyph header.
+*/
+struct GlyphHeader16
+{
+							GlyphHeader16(void)
+							: rows(0), columns(0){}
+	uint16_t	advanceX;
+	int16_t		x;
+	int16_t		y;
+	uint16_t	rows;
+	uint16_t	columns;
+};
+
 /*
 *	The data is either 1 bit per pixel or run length encoded 8 bit.
 *
@@ -114,6 +241,12 @@ struct GlyphHeader
 *	As an optimization, a positive run, such as 4C above, must have a minimum
 *	length of 3 otherwise they're treated as unique pixels.
 *
+*	Raw 8 bit data (optional, see SubsetFontCreator::eAdaptiveEncoding):
+*	A glyph whose run length encoding would be larger than its pixels is
+*	stored raw.  The data starts with a zero length byte (never a valid run
+*	length) followed by rows * columns pixel values.  A font containing raw
+*	glyphs has eRawGlyphsFlag set.
+*
 *	1 bit per pixel:  Each bit is a pixel as scanned horizontally, where the
 *	most significant bit is visually on the left.  The data is stored packed.
 *	The bits in a data byte may extend into the next row.
@@ -62,23 +62,53 @@ uint32_t XFontRH1BitDataStream::Clip(
 	return(mSourceStream->Clip(inLength));
 }
 
-/********************************** NextByte **********************************/
+/************************************ Skip ************************************/
 /*
-*	This routine manages a small buffer rather than constantly calling Read of
-*	the source stream.
+*	Skips inLength unpacked bytes by skipping the packed bits of each column
+*	in the page row (8 pixel rows), moving to the next page row as needed.
 */
-uint8_t XFontRH1BitDataStream::NextByte(void)
+void XFontRH1BitDataStream::Skip(
+	uint32_t	inLength)
 {
-	if (mBufferIndex == mBytesInBuffer)
+	uint16_t	columns = mXFont->Glyph().columns;
+	uint16_t	offsetBitsBy = mXFont->Glyph().y;
+	uint16_t	bitsPerColumn = offsetBitsBy + mXFont->Glyph().rows;
+	while (inLength &&
+		columns)
 	{
-		mBytesInBuffer = (uint8_t)mSourceStream->Read(sizeof(mBuffer), mBuffer);
-		mBufferIndex = 0;
-	}
-	if (mBytesInBuffer)
-	{
-		return(mBuffer[mBufferIndex++]);
+		if (mColumnsLeftInRow == 0)
+		{
+			mColumnsLeftInRow = columns;
+		}
+		uint16_t	columnsToSkip = inLength < mColumnsLeftInRow ? inLength : mColumnsLeftInRow;
+		/*
+		*	The packed bits per column in this page row exclude the y offset
+		*	bits, which aren't in the packed data.
+		*/
+		uint16_t	pageTop = mBitsInRowColumn > offsetBitsBy ? mBitsInRowColumn : offsetBitsBy;
+		uint16_t	pageBottom = (mBitsInRowColumn + 8) < bitsPerColumn ?
+										mBitsInRowColumn + 8 : bitsPerColumn;
+		if (pageTop < pageBottom)
+		{
+			SkipBits((uint32_t)columnsToSkip * (pageBottom - pageTop), mByteIn, mBitsInByteIn);
+		}
+		inLength -= columnsToSkip;
+		/*
+		*	If there are any columns left in this row THEN
+		*	move to the next column
+		*/
+		if (columnsToSkip < mColumnsLeftInRow)
+		{
+			mColumnsLeftInRow -= columnsToSkip;
+		/*
+		*	Else, move to the next row.
+		*/
+		} else
+		{
+			mColumnsLeftInRow = columns;
+			mBitsInRowColumn += 8;
+		}
 	}
-	return(0);
 }
 
 #if 0
@@ -127,8 +157,8 @@ uint32_t XFontRH1BitDataStream::Read(
 	if (mReadGlyphHeader)
 	{
 		mReadGlyphHeader = false;
-		mBufferIndex = 0;
-		mBytesInBuffer = 0;
+		mBufferPtr = mBuffer;
+		mBufferEnd = mBuffer;
 		mBitsInByteIn = 0;
 		mBitsInRowColumn = 0;
 		mColumnsLeftInRow = 0;
@@ -136,8 +166,8 @@ uint32_t XFontRH1BitDataStream::Read(
 	}
 	if (inLength)
 	{
-		uint8_t		offsetBitsBy = mXFont->Glyph().y;
-		uint8_t		bitsPerColumn = offsetBitsBy + mXFont->Glyph().rows;
+		uint16_t	offsetBitsBy = mXFont->Glyph().y;
+		uint16_t	bitsPerColumn = offsetBitsBy + mXFont->Glyph().rows;
 		uint8_t*	oBufferPtr = (uint8_t*)outBuffer;
 		uint8_t*	oBufferEnd = &oBufferPtr[inLength];
 		uint8_t		byteIn = 0;
@@ -159,7 +189,7 @@ uint32_t XFontRH1BitDataStream::Read(
 		}
 		
 		uint8_t	bitsInByteOut = 0;
-		uint8_t	bitsInColumn = mBitsInRowColumn;
+		uint16_t	bitsInColumn = mBitsInRowColumn;
 
 		while (oBufferPtr != oBufferEnd)
 		{
@@ -208,7 +238,7 @@ uint32_t XFontRH1BitDataStream::Read(
 				{
 					byteOut = byteIn;
 				}
-				uint8_t	bitsNeededToFillColumn = bitsPerColumn - bitsInColumn;
+				uint16_t	bitsNeededToFillColumn = bitsPerColumn - bitsInColumn;
 				if (bitsNeededToFillOut > bitsNeededToFillColumn)
 				{
 					if (bitsInByteIn >= bitsNeededToFillColumn)
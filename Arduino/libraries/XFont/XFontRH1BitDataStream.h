@@ -61,19 +61,15 @@ public:
 	virtual bool			AtEOF(void) const;
 	virtual uint32_t		Clip(
 								uint32_t				inLength) const;
+	virtual void			Skip(
+								uint32_t				inLength);
 protected:
 	bool		mReadGlyphHeader;
 	
 	// State data
 	uint8_t		mBitsInByteIn;
 	uint8_t		mByteIn;
-	uint8_t		mBitsInRowColumn;
-	uint8_t		mColumnsLeftInRow;
-
-	uint8_t		mBuffer[32];
-	uint8_t		mBufferIndex;
-	uint8_t		mBytesInBuffer;
-	
-	uint8_t					NextByte(void);
+	uint16_t	mBitsInRowColumn;
+	uint16_t	mColumnsLeftInRow;
 };
 #endif // XFontRH1BitDataStream_h
@@ -0,0 +1,347 @@
+/*
+*	XTextLayout.cpp, Copyright Jonathan Mackey 2023
+*	Class that retains the layout of a string for repeated drawing.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#include "XTextLayout.h"
+#include "DisplayController.h"
+#include <string.h>
+
+/******************************** XTextLayout *********************************/
+XTextLayout::XTextLayout(
+	Glyph*			inGlyphs,
+	uint8_t			inMaxGlyphs,
+	const char*		inString,
+	XFont::Font*	inFont)
+	: mGlyphs(inGlyphs), mMaxGlyphs(inMaxGlyphs), mNumLines(0),
+	  mWrapWidth(0), mString(inString), mFont(inFont)
+{
+}
+
+/********************************* SetString **********************************/
+void XTextLayout::SetString(
+	const char*	inString)
+{
+	if (inString != mString)
+	{
+		mString = inString;
+		mNumLines = 0;
+	}
+}
+
+/********************************** SetFont ***********************************/
+void XTextLayout::SetFont(
+	XFont::Font*	inFont)
+{
+	if (inFont != mFont)
+	{
+		mFont = inFont;
+		mNumLines = 0;
+	}
+}
+
+/******************************** SetWrapWidth ********************************/
+void XTextLayout::SetWrapWidth(
+	uint16_t	inWrapWidth)
+{
+	if (inWrapWidth != mWrapWidth)
+	{
+		mWrapWidth = inWrapWidth;
+		mNumLines = 0;
+	}
+}
+
+/*********************************** Update ***********************************/
+/*
+*	Loads the header of each glyph in the string once, the same way as
+*	XFont::DrawStr, retaining what's needed to draw the glyph.
+*
+*	When wrapping, the line breaks are found in the same pass.  The glyph
+*	following the last space of the line is remembered along with the line
+*	width before and after the space.  When a glyph makes the line too wide,
+*	the line is ended at that space and the glyphs that follow it (the
+*	partial word) become the start of the next line.
+*/
+bool XTextLayout::Update(void)
+{
+	if (mNumLines == 0 &&
+		mString &&
+		mFont)
+	{
+		XFont*		xFont = mFont->MakeCurrent();
+		XFont::UTF8Reader	reader(mString);
+		uint8_t		numGlyphs = 0;
+		uint8_t		numLines = 0;
+		uint16_t	lineWidth = 0;
+		uint16_t	leftEntryIndex = 0xFFFF;	// For kerning, 0xFFFF if none
+		uint16_t	leftTrailing = 0;
+		uint8_t		breakGlyph = 0;			// Glyph after the space, 0 if none
+		uint16_t	widthBeforeBreak = 0;	// Line width before the space
+		uint16_t	widthAfterBreak = 0;	// Line width including the space
+		bool		success = true;
+		for (uint32_t charcode = reader.Next(); charcode;
+									charcode = reader.Next())
+		{
+			if (charcode >= ' ')
+			{
+				success = numGlyphs < mMaxGlyphs &&
+							xFont->LoadGlyph(charcode);
+				if (success)
+				{
+					uint16_t	entryIndex = xFont->mCharcodeIndex;
+					Glyph&	glyph = mGlyphs[numGlyphs++];
+					glyph.dataOffset = xFont->GlyphDataOffset(entryIndex);
+					glyph.header = xFont->Glyph();
+					glyph.kerning = 0;
+					if (xFont->mNumKerningLefts)
+					{
+						if (leftEntryIndex != 0xFFFF)
+						{
+							glyph.kerning = xFont->KerningWithLeft(leftEntryIndex, leftTrailing);
+						}
+						leftEntryIndex = entryIndex;
+						leftTrailing = glyph.header.advanceX - glyph.header.x - glyph.header.columns;
+					}
+					if (charcode == ' ')
+					{
+						widthBeforeBreak = lineWidth;
+						breakGlyph = numGlyphs;
+					}
+					lineWidth += glyph.header.advanceX + glyph.kerning;
+					if (charcode == ' ')
+					{
+						widthAfterBreak = lineWidth;
+					}
+					/*
+					*	If wrapping and the line is now too wide and there's a
+					*	space to break at (other than at the start of the line)
+					*	THEN end the line before the space and remove the space.
+					*/
+					if (mWrapWidth &&
+						lineWidth > mWrapWidth &&
+						breakGlyph > (numLines ? mLineEnd[numLines-1] : 0) + 1)
+					{
+						success = (numLines + 1) < kMaxLines;
+						if (success)
+						{
+							uint8_t	wordStart = breakGlyph - 1;
+							mLineEnd[numLines] = wordStart;
+							mLineWidth[numLines] = widthBeforeBreak;
+							numLines++;
+							lineWidth -= widthAfterBreak;
+							numGlyphs--;
+							if (wordStart < numGlyphs)
+							{
+								memmove(&mGlyphs[wordStart], &mGlyphs[breakGlyph],
+									(numGlyphs - wordStart) * sizeof(Glyph));
+								// The first glyph of a line isn't kerned.
+								lineWidth -= mGlyphs[wordStart].kerning;
+								mGlyphs[wordStart].kerning = 0;
+							}
+							breakGlyph = 0;
+						} else
+						{
+							break;
+						}
+					}
+					continue;
+				}
+				break;
+			} else if (charcode == '\n')
+			{
+				success = (numLines + 1) < kMaxLines;
+				if (success)
+				{
+					mLineEnd[numLines] = numGlyphs;
+					mLineWidth[numLines] = lineWidth;
+					numLines++;
+					lineWidth = 0;
+					leftEntryIndex = 0xFFFF;
+					breakGlyph = 0;
+					continue;
+				}
+				break;
+			}	// else ignore unsupported control characters
+		}
+		if (success)
+		{
+			mLineEnd[numLines] = numGlyphs;
+			mLineWidth[numLines] = lineWidth;
+			mNumLines = numLines + 1;
+		}
+	}
+	return(mNumLines != 0);
+}
+
+/*********************************** Width ************************************/
+uint16_t XTextLayout::Width(void) const
+{
+	uint16_t	width = 0;
+	for (uint8_t line = 0; line < mNumLines; line++)
+	{
+		if (mLineWidth[line] > width)
+		{
+			width = mLineWidth[line];
+		}
+	}
+	return(width);
+}
+
+/********************************* DrawGlyphs *********************************/
+/*
+*	Draws the glyphs inFirstGlyph to inEndGlyph -1 at the current display
+*	position.  Returns false if a glyph didn't fit.
+*/
+bool XTextLayout::DrawGlyphs(
+	XFont*		inXFont,
+	uint8_t		inFirstGlyph,
+	uint8_t		inEndGlyph)
+{
+	bool	doContinue = true;
+	for (uint8_t glyphIndex = inFirstGlyph; doContinue && glyphIndex < inEndGlyph; glyphIndex++)
+	{
+		const Glyph&	glyph = mGlyphs[glyphIndex];
+		inXFont->LoadCachedGlyph(glyph.dataOffset, glyph.header);
+		doContinue = inXFont->DrawLoadedGlyph(0, glyph.kerning);
+	}
+	return(doContinue);
+}
+
+/************************************ Draw ************************************/
+void XTextLayout::Draw(
+	uint8_t	inFirstLine,
+	uint8_t	inEndLine)
+{
+	XFont*	xFont = mFont->MakeCurrent();
+	uint16_t	startColumn = xFont->GetDisplay()->GetColumn();
+	xFont->mStartCol = startColumn;
+	if (inEndLine > mNumLines)
+	{
+		inEndLine = mNumLines;
+	}
+	for (uint8_t line = inFirstLine; line < inEndLine; line++)
+	{
+		if (line != inFirstLine &&
+			!xFont->AdvanceRow(1, startColumn))
+		{
+			break;
+		}
+		DrawGlyphs(xFont, line ? mLineEnd[line-1] : 0, mLineEnd[line]);
+	}
+}
+
+/****************************** DrawLineAligned *******************************/
+/*
+*	Same as XFont::DrawAligned using the cached advances, which include the
+*	kerning, rather than measuring the string.
+*/
+void XTextLayout::DrawLineAligned(
+	uint8_t					inLine,
+	int32_t					inX,
+	int32_t					inY,
+	int32_t					inWidth,
+	XFont::ETextAlignment	inAlignment,
+	bool					inEraseUnusedArea)
+{
+	XFont*	xFont = mFont->MakeCurrent();
+	DisplayController*	display = xFont->GetDisplay();
+	display->ClipX(inX, inWidth);
+
+	/*
+	*	Sum the advances and stop when the width is exceeded or the end of the
+	*	line, which ever occurs first.
+	*/
+	uint16_t	ellipsisWidth = xFont->mEllipsisWidth;
+	uint16_t	width = 0;
+	uint8_t		firstGlyph = inLine ? mLineEnd[inLine-1] : 0;
+	uint8_t		glyphCount = firstGlyph;
+	uint8_t		ellipsisGlyphCount = 0;
+	uint16_t	truncatedWidth = 0;
+	bool		needsTruncation = false;
+	for (; glyphCount < mLineEnd[inLine]; glyphCount++)
+	{
+		const Glyph&	glyph = mGlyphs[glyphCount];
+		uint16_t	advanceX = glyph.header.advanceX + glyph.kerning;
+		width += advanceX;
+		if (width <= inWidth)
+		{
+			/*
+			*	In case truncation may be needed, save the glyph count
+			*	at which the ellipsis will fit.
+			*/
+			if (!truncatedWidth &&
+				(width + ellipsisWidth) > inWidth)
+			{
+				ellipsisGlyphCount = glyphCount +1;
+				truncatedWidth = width - advanceX + ellipsisWidth;
+			}
+			continue;
+		}
+		/*
+		*	At this point the line is too wide.
+		*/
+		if (ellipsisGlyphCount)
+		{
+			glyphCount = ellipsisGlyphCount-1;
+			width = truncatedWidth;
+			needsTruncation = true;
+		}
+		break;
+	}
+	int32_t	x = inX;
+	if (inAlignment == XFont::eAlignRight)
+	{
+		x += (inWidth - width);
+	} else if (inAlignment == XFont::eAlignCenter)
+	{
+		x += ((inWidth - width)/2);
+	}
+	display->MoveTo(inY, x);
+	/*
+	*	As with XFont::DrawAligned, when not even the first glyph fits, the
+	*	entire line (the entire layout for the first line) is drawn and clipped.
+	*	When wrapped, each line is drawn by its own call (see XLabel::DrawSelf)
+	*	so only the line is drawn.
+	*/
+	if (glyphCount > firstGlyph)
+	{
+		xFont->mStartCol = display->GetColumn();
+		DrawGlyphs(xFont, firstGlyph, glyphCount);
+	} else
+	{
+		Draw(inLine, (inLine || mWrapWidth) ? inLine + 1 : kMaxLines);
+	}
+	if (needsTruncation &&
+		inWidth > ellipsisWidth)
+	{
+		xFont->DrawCharcode(XFont::kEllipsisCharcode);
+	}
+	if (inEraseUnusedArea)
+	{
+		if (inAlignment != XFont::eAlignRight)
+		{
+			xFont->EraseTillColumn(inX+inWidth);
+		}
+		if (inAlignment != XFont::eAlignLeft)
+		{
+			xFont->EraseFromColumn(inX);
+		}
+	}
+}
@@ -0,0 +1,146 @@
+/*
+*	XTextLayout.h, Copyright Jonathan Mackey 2023
+*	Class that retains the layout of a string for repeated drawing.
+*
+*	GNU license:
+*	This program is free software: you can redistribute it and/or modify
+*	it under the terms of the GNU General Public License as published by
+*	the Free Software Foundation, either version 3 of the License, or
+*	(at your option) any later version.
+*
+*	This program is distributed in the hope that it will be useful,
+*	but WITHOUT ANY WARRANTY; without even the implied warranty of
+*	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*	GNU General Public License for more details.
+*
+*	You should have received a copy of the GNU General Public License
+*	along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*
+*	Please maintain this license information along with authorship and copyright
+*	notices in any redistribution of this code.
+*
+*/
+#ifndef XTextLayout_h
+#define XTextLayout_h
+
+#include "XFont.h"
+
+/*
+*	XTextLayout caches the glyph data offset, glyph header and kerning of each
+*	glyph of a string, the glyph at which each line ends, and the width of
+*	each line.  Once laid out, drawing doesn't decode the UTF-8 string, search
+*	for the glyphs, or read the glyph headers.
+*
+*	The glyph array is supplied by the caller.  One Glyph is needed per
+*	glyph drawn (newlines and other control characters don't use one.)
+*
+*	The layout is invalidated when the string or font is changed.  If the
+*	contents of the string are changed without changing the string pointer,
+*	Invalidate must be called.  If the string doesn't fit in the glyph array,
+*	has more than kMaxLines lines, or any of its glyphs don't exist, Update
+*	returns false and the string should be drawn by XFont (as XLabel does.)
+*
+*	When a wrap width is set, Update also breaks lines at spaces so that no
+*	line is wider than the wrap width (a word wider than the wrap width is
+*	left on a line of its own.)  The space at a break isn't retained.  The
+*	breaks are part of the layout, so they're only recalculated when the
+*	string, font or wrap width changes.
+*/
+class XTextLayout
+{
+public:
+	struct Glyph
+	{
+		uint32_t		dataOffset;	// Of the glyph header within the glyph data
+		GlyphHeader16	header;
+		int16_t			kerning;	// With the previous glyph of the line
+	};
+							XTextLayout(
+								Glyph*					inGlyphs,
+								uint8_t					inMaxGlyphs,
+								const char*				inString = nullptr,
+								XFont::Font*			inFont = nullptr);
+	void					SetString(
+								const char*				inString);
+	const char*				GetString(void) const
+								{return(mString);}
+	void					SetFont(
+								XFont::Font*			inFont);
+	XFont::Font*			GetFont(void) const
+								{return(mFont);}
+	void					Invalidate(void)
+								{mNumLines = 0;}
+	/*
+	*	SetWrapWidth: The maximum line width in pixels, 0 for no wrapping
+	*	(lines only end at newlines.)
+	*/
+	void					SetWrapWidth(
+								uint16_t				inWrapWidth);
+	uint16_t				GetWrapWidth(void) const
+								{return(mWrapWidth);}
+	/*
+	*	Update: Lays out the string if the layout isn't valid.  Returns true
+	*	if the layout is valid.
+	*/
+	bool					Update(void);
+	uint8_t					NumLines(void) const
+								{return(mNumLines);}
+	uint16_t				LineWidth(
+								uint8_t					inLine) const
+								{return(mLineWidth[inLine]);}
+	// The width of the widest line
+	uint16_t				Width(void) const;
+	/*
+	*	Draw: Draws the layout at the current display position.  Each line
+	*	after the first starts at the column of the first line.  Same as
+	*	XFont::DrawStr otherwise.  Update must have returned true.
+	*	Only lines inFirstLine to inEndLine -1 are drawn, the first of them
+	*	at the current display position (e.g. the visible rows of a scrolled
+	*	block of text.)
+	*/
+	void					Draw(
+								uint8_t					inFirstLine = 0,
+								uint8_t					inEndLine = kMaxLines);
+	/*
+	*	DrawAligned: Draws the first line of the layout.  Same as
+	*	XFont::DrawAligned otherwise.  Update must have returned true.
+	*/
+	void					DrawAligned(
+								int32_t					inX,
+								int32_t					inY,
+								int32_t					inWidth,
+								XFont::ETextAlignment	inAlignment = XFont::eAlignLeft,
+								bool					inEraseUnusedArea = false)
+								{DrawLineAligned(0, inX, inY, inWidth, inAlignment, inEraseUnusedArea);}
+	/*
+	*	DrawLineAligned: Same as DrawAligned for line inLine.  The line is
+	*	drawn at inY, not offset by the rows of the preceding lines.
+	*/
+	void					DrawLineAligned(
+								uint8_t					inLine,
+								int32_t					inX,
+								int32_t					inY,
+								int32_t					inWidth,
+								XFont::ETextAlignment	inAlignment = XFont::eAlignLeft,
+								bool					inEraseUnusedArea = false);
+	enum
+	{
+		kMaxLines = 8
+	};
+protected:
+	Glyph*			mGlyphs;
+	uint8_t			mMaxGlyphs;
+	uint8_t			mNumLines;	// 0 if the layout isn't valid
+	uint16_t		mWrapWidth;	// 0 if lines aren't wrapped
+	const char*		mString;
+	XFont::Font*	mFont;
+	uint8_t			mLineEnd[kMaxLines];	// Index of the glyph after the line
+	uint16_t		mLineWidth[kMaxLines];
+
+	bool					DrawGlyphs(
+								XFont*					inXFont,
+								uint8_t					inFirstGlyph,
+								uint8_t					inEndGlyph);
+};
+
+#endif // XTextLayout_h
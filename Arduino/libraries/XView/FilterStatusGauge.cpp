@@ -46,6 +46,7 @@ FilterStatusGauge::FilterStatusGauge(
   mAnimationPeriod(30), mFont(inFont),
   mGaugeThickness(inGaugeThickness), mInfoFrameRadius(inInfoFrameRadius),
   mRadius(inHeight), mPos(0), mIndicatorPos(0), mIndicatorPercentage(0),
+  mDirtyLeft(0), mDirtyTop(0), mDirtyRight(0), mDirtyBottom(0),
   mMin(0), mMax(100)
 {
 	/*
@@ -98,84 +99,256 @@ void FilterStatusGauge::SetValue(
 }
 
 /*********************************** Update ***********************************/
+/*
+*	Unlike Animate, the indicator is drawn immediately.
+*/
 void FilterStatusGauge::Update(void)
 {
-	/*
-	*	If the indicator needs to move THEN
-	*	redraw the indicator.
-	*
-	*	The indicator line is drawn with a 1-2 pixel mask around it depending on
-	*	the angle.  The line can only move by one pixel per call.  This allows
-	*	the line to move without having to erase the previous line.  The
-	*	indicator will always try to match the position mPos but it may take
-	*	several Update calls to accomplish this.  The nice side effect of
-	*	drawing the line like this is it eliminates any spikes in the position.
-	*/
 	if (mVisible &&
 		mAnimationPeriod.Passed() &&
 		mIndicatorPos != mPos)
 	{
 		mAnimationPeriod.Start();
-		if (mIndicatorPos < mPos)
-		{
-			mIndicatorPos++;
-		} else
+		StepIndicator();
+		DrawIndicator();
+	}
+}
+
+/********************************** Animate ***********************************/
+/*
+*	Called by the root view.  The area of the indicator line before and after
+*	it moves, and the percentage when it changes, are invalidated.  When the
+*	root view draws just this area, Draw only draws the indicator.
+*/
+void FilterStatusGauge::Animate(void)
+{
+	if (mVisible &&
+		mIndicatorPos != mPos)
+	{
+		AddIndicatorToDirtyRect();
+		StepIndicator();
+		AddIndicatorToDirtyRect();
+		if (map(mIndicatorPos, 0, mGaugeWidth, 0, 100) != mIndicatorPercentage)
 		{
-			mIndicatorPos--;
+			AddDirtyRect(mInfoStrLeft, mInfoStrTop, mInfoStrLeft + (mDigitWidth*3), mHeight);
 		}
-		XFont*	xFont = mFont->MakeCurrent();
-		DisplayController*	display = xFont->GetDisplay();
+		Invalidate(mDirtyLeft, mDirtyTop, mDirtyRight - mDirtyLeft, mDirtyBottom - mDirtyTop);
+	}
+}
+
+/******************************* StepIndicator ********************************/
+/*
+*	The indicator line is drawn with a 1-2 pixel mask around it depending on
+*	the angle.  The line can only move by one pixel per step.  This allows
+*	the line to move without having to erase the previous line.  The
+*	indicator will always try to match the position mPos but it may take
+*	several steps to accomplish this.  The nice side effect of drawing
+*	the line like this is it eliminates any spikes in the position.
+*/
+void FilterStatusGauge::StepIndicator(void)
+{
+	if (mIndicatorPos < mPos)
+	{
+		mIndicatorPos++;
+	} else if (mIndicatorPos > mPos)
+	{
+		mIndicatorPos--;
+	}
+}
+
+/******************************* IndicatorLine ********************************/
+/*
+*	The indicator is drawn between the arc of the multi color gauge and the
+*	half circle that surrounds the filter loading percentage text.  The
+*	origin of the indicator line is the same as the color gauge and half
+*	circle.
+*/
+void FilterStatusGauge::IndicatorLine(
+	int32_t&	outX0,
+	int32_t&	outY0,
+	int32_t&	outX1,
+	int32_t&	outY1) const
+{
+	int32_t	halfDisplayWidth = mWidth/2;
+	int32_t	halfGaugeWidth = mGaugeWidth/2;
+	int32_t	innerRadius = mRadius - mGaugeThickness - kIndicatorGap;
+	int32_t	xToOrigin = halfGaugeWidth - mIndicatorPos;
+	int32_t	y1 = xToOrigin ? sqrt((innerRadius*innerRadius)-(xToOrigin*xToOrigin)) : innerRadius;
+	int32_t	r2m = ((mInfoFrameRadius + 10)*100000)/innerRadius;
+	outX0 = halfDisplayWidth-((r2m*xToOrigin)/100000);
+	outY0 = mHeight - ((r2m*y1)/100000);
+	outX1 = halfDisplayWidth - halfGaugeWidth + mIndicatorPos;
+	outY1 = mHeight-y1;
+}
+
+/******************************* DrawIndicator ********************************/
+/*
+*	Draws the indicator line at mIndicatorPos, and the displayed percentage
+*	when it changed.
+*/
+void FilterStatusGauge::DrawIndicator(void)
+{
+	XFont*	xFont = mFont->MakeCurrent();
+	DisplayController*	display = xFont->GetDisplay();
+	{
+		int32_t	x0, y0, x1, y1;
+		IndicatorLine(x0, y0, x1, y1);
+		display->SetFGColor(eIndicatorColor);
+		display->SetBGColor(0);
+		display->DrawLine(x0, y0, x1, y1, kIndicatorThickness, true);
+	}
+	/*
+	*	Calculate the displayed indicator position as a percentage of the
+	*	gauge range.
+	*	Update the displayed percentage as needed.
+	*/
+	int32_t	indicatorPercentage = map(mIndicatorPos, 0, mGaugeWidth, 0, 100);
+	if (indicatorPercentage != mIndicatorPercentage)
+	{
 		/*
-		*	Draw the indicator line.  The indicator is drawn between the arc of
-		*	the multi color gauge and the half circle that surrounds the filter
-		*	loading percentage text.  The origin of the indicator line is the
-		*	same as the color gauge and half circle.
+		*	Only the digits that changed are drawn.  When
+		*	mIndicatorPercentage is -1 (set by DrawSelf), all of the digits
+		*	are drawn.
 		*/
+		char	percentageStr[10];
+		char	prevPercentageStr[10];
+		const char*	prevStrPtr = mIndicatorPercentage >= 0 ?
+					PercentageToString(mIndicatorPercentage, prevPercentageStr) : nullptr;
+		mIndicatorPercentage = indicatorPercentage;
+		xFont->SetTextColor(XFont::eWhite);
+		xFont->SetBGTextColor(XFont::eBlack);
+		xFont->DrawChangedGlyphs(PercentageToString(indicatorPercentage, percentageStr),
+			prevStrPtr, mInfoStrLeft, mInfoStrTop, mDigitWidth*3, XFont::eAlignRight, mDigitWidth);
+	}
+}
+
+/******************************** AddDirtyRect ********************************/
+/*
+*	Adds the local rectangle to the indicator's dirty rectangle, limited to
+*	the bounds of the gauge.
+*/
+void FilterStatusGauge::AddDirtyRect(
+	int32_t	inLeft,
+	int32_t	inTop,
+	int32_t	inRight,
+	int32_t	inBottom)
+{
+	if (inLeft < 0)
+	{
+		inLeft = 0;
+	}
+	if (inTop < 0)
+	{
+		inTop = 0;
+	}
+	if (inRight > mWidth)
+	{
+		inRight = mWidth;
+	}
+	if (inBottom > mHeight)
+	{
+		inBottom = mHeight;
+	}
+	if (inLeft < inRight &&
+		inTop < inBottom)
+	{
+		if (mDirtyRight == 0)
 		{
-			int32_t	halfDisplayWidth = mWidth/2;
-			int32_t	halfGaugeWidth = mGaugeWidth/2;
-			int32_t	innerRadius = mRadius - mGaugeThickness - kIndicatorGap;
-			int32_t	x1 = halfDisplayWidth - halfGaugeWidth + mIndicatorPos;
-			int32_t	xToOrigin = halfGaugeWidth - mIndicatorPos;
-			int32_t	y1 = xToOrigin ? sqrt((innerRadius*innerRadius)-(xToOrigin*xToOrigin)) : innerRadius;
-			int32_t	r2m = ((mInfoFrameRadius + 10)*100000)/innerRadius;
-			int32_t	x0 = halfDisplayWidth-((r2m*xToOrigin)/100000);
-			int32_t	y0 = mHeight - ((r2m*y1)/100000);
-			display->SetFGColor(eIndicatorColor);
-			display->SetBGColor(0);
-			display->DrawLine(x0, y0, x1, mHeight-y1, kIndicatorThickness, true);
-		}
-		/*
-		*	Calculate the displayed indicator position as a percentage of the
-		*	gauge range.
-		*	Update the displayed percentage as needed.
-		*/
-		int32_t	indicatorPercentage = map(mIndicatorPos, 0, mGaugeWidth, 0, 100);
-		if (indicatorPercentage != mIndicatorPercentage)
+			mDirtyLeft = inLeft;
+			mDirtyTop = inTop;
+			mDirtyRight = inRight;
+			mDirtyBottom = inBottom;
+		} else
 		{
-			mIndicatorPercentage = indicatorPercentage;
-			char percentageStr[10];
-			percentageStr[9] = 0;
-			char*	strPtr = &percentageStr[8];
-			do
+			if (inLeft < mDirtyLeft)
+			{
+				mDirtyLeft = inLeft;
+			}
+			if (inTop < mDirtyTop)
+			{
+				mDirtyTop = inTop;
+			}
+			if (inRight > mDirtyRight)
 			{
-				*(strPtr--) = (indicatorPercentage % 10) + '0';
-				indicatorPercentage /= 10;
-			} while (indicatorPercentage);
-			strPtr++;
-			display->MoveTo(mInfoStrTop, mInfoStrLeft);
-			uint16_t	strLeft =  mInfoStrLeft + (mDigitWidth*(3-(&percentageStr[9]-strPtr)));
-			if (strLeft > mInfoStrLeft)
+				mDirtyRight = inRight;
+			}
+			if (inBottom > mDirtyBottom)
 			{
-				xFont->EraseTillColumn(strLeft);
+				mDirtyBottom = inBottom;
 			}
-			xFont->SetTextColor(XFont::eWhite);
-			xFont->SetBGTextColor(XFont::eBlack);
-			xFont->DrawStr(strPtr);
 		}
 	}
 }
 
+/************************** AddIndicatorToDirtyRect ***************************/
+/*
+*	Adds the bounds of the indicator line at mIndicatorPos, including its
+*	mask, to the dirty rectangle.
+*/
+void FilterStatusGauge::AddIndicatorToDirtyRect(void)
+{
+	int32_t	x0, y0, x1, y1;
+	IndicatorLine(x0, y0, x1, y1);
+	const int32_t	kMargin = kIndicatorThickness + 2;
+	AddDirtyRect((x0 < x1 ? x0 : x1) - kMargin, (y0 < y1 ? y0 : y1) - kMargin,
+		(x0 > x1 ? x0 : x1) + kMargin + 1, (y0 > y1 ? y0 : y1) + kMargin + 1);
+}
+
+/***************************** PercentageToString *****************************/
+/*
+*	Returns a pointer to the decimal string of inPercentage within
+*	outString (at least 10 chars.)
+*/
+const char* FilterStatusGauge::PercentageToString(
+	int32_t	inPercentage,
+	char*	outString)
+{
+	outString[9] = 0;
+	char*	strPtr = &outString[8];
+	do
+	{
+		*(strPtr--) = (inPercentage % 10) + '0';
+		inPercentage /= 10;
+	} while (inPercentage);
+	return(strPtr+1);
+}
+
+/************************************ Draw ************************************/
+/*
+*	When the area to be drawn is within the area invalidated by Animate, only
+*	the indicator is drawn, without filling the background.
+*/
+void FilterStatusGauge::Draw(
+	int16_t		inX,
+	int16_t		inY,
+	uint16_t	inWidth,
+	uint16_t	inHeight)
+{
+	int32_t	left = inX - mX;
+	int32_t	top = inY - mY;
+	if (mVisible &&
+		mDirtyRight &&
+		left >= mDirtyLeft &&
+		top >= mDirtyTop &&
+		left + inWidth <= mDirtyRight &&
+		top + inHeight <= mDirtyBottom)
+	{
+		mDirtyRight = 0;
+		DrawIndicator();
+		if (mSubViews)
+		{
+			mSubViews->Draw(inX, inY, inWidth, inHeight);
+		}
+		if (mNextView)
+		{
+			mNextView->Draw(inX, inY, inWidth, inHeight);
+		}
+	} else
+	{
+		XColoredView::Draw(inX, inY, inWidth, inHeight);
+	}
+}
+
 /********************************** DrawSelf **********************************/
 void FilterStatusGauge::DrawSelf(void)
 {
@@ -190,12 +363,9 @@ void FilterStatusGauge::DrawSelf(void)
 	xFont->SetTextColor(XFont::eWhite);
 	xFont->SetBGTextColor(XFont::eBlack);
 	xFont->DrawStr("%");
-	if (mIndicatorPos == mPos)
-	{
-		mIndicatorPos = mPos-1;	// To force a redraw
-	}
+	mDirtyRight = 0;
 	mIndicatorPercentage = -1;	// To force a redraw
-	Update();
+	DrawIndicator();
 }
 
 /********************************* DrawGauge **********************************/
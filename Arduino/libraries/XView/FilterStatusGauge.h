@@ -25,6 +25,7 @@
 #include "MSPeriod.h"
 #include "XFont.h"
 #include "XColoredView.h"
+#include "XRootView.h"
 
 /*
 *	The gauge is drawn in the center of the display (for now anyway.)
@@ -32,7 +33,7 @@
 *	base XView class.)
 *	The angle of the gauge ends is 45°.
 */
-class FilterStatusGauge : public XColoredView
+class FilterStatusGauge : public XColoredView, public XAnimation
 {
 public:
 							FilterStatusGauge(
@@ -46,12 +47,24 @@ public:
 								XFont::Font*			inFont,
 								uint16_t				inGaugeThickness = 35,
 								uint16_t				inInfoFrameRadius = 105);
+	/*
+	*	Update: Polls the animation period.  Not needed when the gauge has
+	*	been added to the root view's animations (XRootView::AddAnimation.)
+	*/
 	void					Update(void);
+	virtual uint32_t		AnimationPeriod(void) const
+								{return(mAnimationPeriod.Get());}
+	virtual void			Animate(void);
 	void					SetMinMax(
 								int32_t				inMin,
 								int32_t				inMax);
 	void					SetValue(
 								int32_t				inValue);
+	virtual void			Draw(
+								int16_t					inX,
+								int16_t					inY,
+								uint16_t				inWidth,
+								uint16_t				inHeight);
 	virtual void			DrawSelf(void);
 	virtual bool			HitSelf(
 								int16_t					inLocalX,
@@ -83,6 +96,10 @@ protected:
 	int32_t				mGaugeWidth;
 	int32_t				mIndicatorPos;			// Used by Update
 	int32_t				mIndicatorPercentage;	// Used by Update
+	int16_t				mDirtyLeft;		// Local bounds of the indicator changes
+	int16_t				mDirtyTop;		// invalidated by Animate, empty when
+	int16_t				mDirtyRight;	// mDirtyRight is 0.
+	int16_t				mDirtyBottom;
 	int32_t				mPos;			// Desired indicator position (mapped)
 	int32_t				mMin;
 	int32_t				mMax;
@@ -96,6 +113,22 @@ protected:
 								uint16_t				inNumSteps,
 								uint16_t*				outLine);
 	void					DrawGauge(void);
+	void					StepIndicator(void);
+	void					IndicatorLine(
+								int32_t&				outX0,
+								int32_t&				outY0,
+								int32_t&				outX1,
+								int32_t&				outY1) const;
+	void					DrawIndicator(void);
+	void					AddDirtyRect(
+								int32_t					inLeft,
+								int32_t					inTop,
+								int32_t					inRight,
+								int32_t					inBottom);
+	void					AddIndicatorToDirtyRect(void);
+	static const char*		PercentageToString(
+								int32_t					inPercentage,
+								char*					outString);
 #if 0
 	uint16_t				TransColorAtPos(
 								uint16_t				inPosition);
@@ -62,7 +62,24 @@ void XAlert::DoMessage(
 			uint16_t	height;
 			uint16_t	width;
 			mMessageLabel.SetString(inMessage);
-			xFont->MeasureStr(inMessage, height, width);
+			XTextLayout*	textLayout = mMessageLabel.GetTextLayout();
+			/*
+			*	The message buffer may be reused with new text, so the layout
+			*	is invalidated even when the string pointer hasn't changed.
+			*/
+			if (textLayout)
+			{
+				textLayout->Invalidate();
+			}
+			if (textLayout &&
+				textLayout->Update())
+			{
+				height = textLayout->NumLines() * xFont->FontRows();
+				width = textLayout->Width();
+			} else
+			{
+				xFont->MeasureStr(inMessage, height, width);
+			}
 			mMessageLabel.SetSize(width, height);
 			mMessageLabel.SetOrigin(0,0);
 			Show();
@@ -70,3 +87,14 @@ void XAlert::DoMessage(
 	}
 }
 
+/****************************** SetMessageLayout ******************************/
+void XAlert::SetMessageLayout(
+	XTextLayout*	inTextLayout,
+	uint16_t		inWrapWidth)
+{
+	if (inTextLayout)
+	{
+		inTextLayout->SetWrapWidth(inWrapWidth);
+	}
+	mMessageLabel.SetTextLayout(inTextLayout);
+}
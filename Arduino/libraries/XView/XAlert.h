@@ -45,6 +45,15 @@ public:
 								uint16_t				inMessageTag = 0);
 	uint16_t				MessageTag(void) const
 								{return(mMessageTag);}
+	/*
+	*	SetMessageLayout: Optional layout used to wrap messages to
+	*	inWrapWidth pixels rather than relying on newlines within the message.
+	*	The message is sized to the wrapped lines.  If the message doesn't fit
+	*	the layout, it's drawn unwrapped.
+	*/
+	void					SetMessageLayout(
+								XTextLayout*			inTextLayout,
+								uint16_t				inWrapWidth);
 protected:
 	XLabel			mMessageLabel;
 	uint16_t		mMessageTag;
@@ -72,20 +72,40 @@ XFont* XAnimatedFontIcon::MakeFontCurrent(void)
 }
 
 /*********************************** Update ***********************************/
+/*
+*	Unlike Animate, the next character is drawn immediately.
+*/
 void XAnimatedFontIcon::Update(void)
 {
 	if (mAnimationPeriod.Passed())
 	{
-		mCurrentChar++;
-		if (mCurrentChar > mToChar)
-		{
-			mCurrentChar = mFromChar;
-		}
 		mAnimationPeriod.Start();
+		NextChar();
 		DrawSelf();
 	}
 }
 
+/********************************** Animate ***********************************/
+/*
+*	Called by the root view, the next character is drawn by the root view's
+*	dirty rectangle pass.
+*/
+void XAnimatedFontIcon::Animate(void)
+{
+	NextChar();
+	Invalidate();
+}
+
+/********************************** NextChar **********************************/
+void XAnimatedFontIcon::NextChar(void)
+{
+	mCurrentChar++;
+	if (mCurrentChar > mToChar)
+	{
+		mCurrentChar = mFromChar;
+	}
+}
+
 /********************************** DrawSelf **********************************/
 void XAnimatedFontIcon::DrawSelf(void)
 {
@@ -24,10 +24,11 @@
 #define XAnimatedFontIcon_h
 
 #include "XView.h"
+#include "XRootView.h"
 #include "XFont.h"
 #include "MSPeriod.h"
 
-class XAnimatedFontIcon : public XView
+class XAnimatedFontIcon : public XView, public XAnimation
 {
 public:
 							XAnimatedFontIcon(
@@ -44,7 +45,14 @@ public:
 								uint16_t				inRunningColor = 0xFFFF,	// White
 								uint16_t				inStoppedColor = 0xCE79,	// Gray
 								uint16_t				inBGColor = 0);				// Black
+	/*
+	*	Update: Polls the animation period.  Not needed when the icon has
+	*	been added to the root view's animations (XRootView::AddAnimation.)
+	*/
 	void					Update(void);
+	virtual uint32_t		AnimationPeriod(void) const
+								{return(mAnimationPeriod.Get());}
+	virtual void			Animate(void);
 							// Start/Stop.  Stop = 0
 	void					SetAnimationPeriod(
 								uint32_t				inPeriod);
@@ -60,6 +68,8 @@ protected:
 	uint16_t		mBGColor;
 	uint16_t		mRunningColor;
 	uint16_t		mStoppedColor;
+
+	void					NextChar(void);
 };
 
 #endif // XAnimatedFontIcon_h
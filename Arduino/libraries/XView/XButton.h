@@ -59,6 +59,9 @@ public:
 	virtual void			SetString(
 								const char*				inString,
 								bool					inUpdate = true);								
+	void					SetTextLayout(
+								XTextLayout*			inTextLayout)
+								{mLabel.SetTextLayout(inTextLayout);}
 protected:
 	XLabel		mLabel;	
 	uint16_t	mFGColor;
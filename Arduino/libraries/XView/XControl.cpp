@@ -22,6 +22,7 @@
 */
 
 #include "XControl.h"
+#include "XRootView.h"
 
 
 /********************************** XControl **********************************/
@@ -46,7 +47,16 @@ void XControl::SetState(
 	if (mState != inState)
 	{
 		mState = inState;
-		if (inUpdate)DrawSelf();
+		if (inUpdate)
+		{
+			if (XRootView::DrawingIsDeferred())
+			{
+				Invalidate();
+			} else
+			{
+				DrawSelf();
+			}
+		}
 		HandleChange(this, mState);
 	}
 }
@@ -23,6 +23,7 @@
 
 #include "XDateValueField.h"
 #include "DisplayController.h"
+#include "XRootView.h"
 
 #ifdef __MACH__
 #define _BV(bit) (1 << (bit))
@@ -81,8 +82,10 @@ XDateValueField::XDateValueField(
 	uint16_t		inFGColor,
 	uint16_t		inBGColor)
 	: XValueField(inX, inY, inWidth, inTag, inNextView, inFont, 0, inFGColor, inBGColor),
-	  mActiveField(eNoSubField), mLastValue(0)
+	  mActiveField(eNoSubField), mLastValue(0), mDrawnTextColor(inFGColor),
+	  mDrawnBGColor(inBGColor)
 {
+	memset(&mDrawnStrings, 0, sizeof(SDateStrings));
 	XFont*	xFont = MakeFontCurrent();
 	if (xFont)
 	{
@@ -170,7 +173,15 @@ void XDateValueField::DrawSelf(void)
 }
 
 /********************************* DrawFields *********************************/
-void XDateValueField::DrawFields(void)
+/*
+*	Draws the dirty sub fields.  When inChangedGlyphsOnly is set, the dirty
+*	value sub fields only draw the glyphs that differ from those displayed.
+*	This is only valid when the value changed, not the active sub field.
+*	All of the sub fields are drawn when the colors differ from the colors
+*	the sub fields were drawn with (e.g. the field was disabled.)
+*/
+void XDateValueField::DrawFields(
+	bool	inChangedGlyphsOnly)
 {
 	XFont*	xFont = MakeFontCurrent();
 	if (xFont)
@@ -180,6 +191,14 @@ void XDateValueField::DrawFields(void)
 						DisplayController::Calc565Color(mFGColor, 0, 184);
 		xFont->SetTextColor(textColor);
 		xFont->SetBGTextColor(mBGColor);
+		if (mDrawnTextColor != textColor ||
+			mDrawnBGColor != mBGColor)
+		{
+			mDrawnTextColor = textColor;
+			mDrawnBGColor = mBGColor;
+			mDirtyField = 0xFFFF;
+			inChangedGlyphsOnly = false;
+		}
 		display->SetFGColor(kSelectedFieldBGColor);
 		display->SetBGColor(mBGColor);
 		int16_t	x = 0;
@@ -192,20 +211,50 @@ void XDateValueField::DrawFields(void)
 		{
 			if (mDirtyField & mask)
 			{
-				if (mStepper)
+				/*
+				*	The value sub field strings point into mDateStrings.  The
+				*	drawn copy of each is at the same offset in mDrawnStrings.
+				*/
+				char*	drawnStr = nullptr;
+				if (i >= eSecondField &&
+					i <= eYearField)
 				{
-					if (i == mActiveField)
+					drawnStr = (char*)&mDrawnStrings +
+						(mSubFieldStrs[i] - (const char*)&mDateStrings);
+				}
+				if (inChangedGlyphsOnly &&
+					drawnStr &&
+					drawnStr[0])
+				{
+					if (mStepper &&
+						i == mActiveField)
 					{
 						xFont->SetTextColor(XFont::eWhite);
 						xFont->SetBGTextColor(kSelectedFieldBGColor);
-						display->DrawRoundedRect(x+mFieldX[i], y-3, mFieldWidth[i], mHeight+4, 3);
-					} else
+					}
+					xFont->DrawChangedGlyphs(mSubFieldStrs[i], drawnStr,
+						x+mFieldX[i], y, mFieldWidth[i], XFont::eAlignCenter);
+				} else
+				{
+					if (mStepper)
 					{
-						display->FillRect(x+mFieldX[i], y-3, mFieldWidth[i], mHeight+4, mBGColor);
+						if (i == mActiveField)
+						{
+							xFont->SetTextColor(XFont::eWhite);
+							xFont->SetBGTextColor(kSelectedFieldBGColor);
+							display->DrawRoundedRect(x+mFieldX[i], y-3, mFieldWidth[i], mHeight+4, 3);
+						} else
+						{
+							display->FillRect(x+mFieldX[i], y-3, mFieldWidth[i], mHeight+4, mBGColor);
+						}
 					}
-				}
-				xFont->DrawAligned(mSubFieldStrs[i], x+mFieldX[i], y, mFieldWidth[i],
+					xFont->DrawAligned(mSubFieldStrs[i], x+mFieldX[i], y, mFieldWidth[i],
 														XFont::eAlignCenter, false);
+				}
+				if (drawnStr)
+				{
+					strcpy(drawnStr, mSubFieldStrs[i]);
+				}
 				xFont->SetTextColor(textColor);
 				xFont->SetBGTextColor(mBGColor);
 			}
@@ -428,12 +477,16 @@ bool XDateValueField::IncDecValue(
 	{
 		UpdateStringsFromComponents();
 		mValue = UnixTime::FromComponents(mComponents);
-		DrawFields();
+		DrawFields(true);
 	}
 	return(mDirtyField != 0);
 }
 
 /******************************** ValueChanged ********************************/
+/*
+*	When drawing is deferred, the field is invalidated and the root view's
+*	Update draws all of the sub fields (DrawSelf.)
+*/
 void XDateValueField::ValueChanged(
 	bool	inUpdate)
 {
@@ -441,7 +494,13 @@ void XDateValueField::ValueChanged(
 	
 	if (inUpdate)
 	{
-		DrawFields();
+		if (XRootView::DrawingIsDeferred())
+		{
+			Invalidate();
+		} else
+		{
+			DrawFields(true);
+		}
 	}
 }
 
@@ -84,12 +84,16 @@ protected:
 	UnixTime::SComponents	mComponents;
 	const char*		mSubFieldStrs[eNumSubFields];
 	SDateStrings	mDateStrings;
+	SDateStrings	mDrawnStrings;	// The value strings currently displayed
+	uint16_t		mDrawnTextColor;	// The colors mDrawnStrings were drawn with
+	uint16_t		mDrawnBGColor;
 
 	virtual bool			ValueIsValid(
 								int32_t					inValue);
 	virtual void			UpdateStringForValue(void);
 	void					UpdateStringsFromComponents(void);
-	void					DrawFields(void);
+	void					DrawFields(
+								bool					inChangedGlyphsOnly = false);
 	bool					IncDecValue(
 								bool					inIncrement);
 };
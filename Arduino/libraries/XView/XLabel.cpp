@@ -41,11 +41,46 @@ XLabel::XLabel(
 	bool					inEnabled)
 	: XView(inX, inY, inWidth, inHeight, inTag, inNextView, nullptr,
 		inSuperView, true, inEnabled),  mString(inString), mFont(inFont),
+	  mTextLayout(nullptr),
 	  mBGColor(inBGColor), mTextColor(inTextColor),
 	  mTextAlignment(inTextAlignment), mEraseUnusedAreaAfterDraw(false)
 {
 }
 
+/********************************** SetFont ***********************************/
+void XLabel::SetFont(
+	XFont::Font*	inFont)
+{
+	mFont = inFont;
+	if (mTextLayout)
+	{
+		mTextLayout->SetFont(inFont);
+	}
+}
+
+/********************************* SetString **********************************/
+void XLabel::SetString(
+	const char*	inString)
+{
+	mString = inString;
+	if (mTextLayout)
+	{
+		mTextLayout->SetString(inString);
+	}
+}
+
+/******************************* SetTextLayout ********************************/
+void XLabel::SetTextLayout(
+	XTextLayout*	inTextLayout)
+{
+	mTextLayout = inTextLayout;
+	if (inTextLayout)
+	{
+		inTextLayout->SetString(mString);
+		inTextLayout->SetFont(mFont);
+	}
+}
+
 /****************************** MakeFontCurrent *******************************/
 XFont* XLabel::MakeFontCurrent(void)
 {
@@ -70,7 +105,49 @@ void XLabel::DrawSelf(void)
 		int16_t	x = 0;
 		int16_t	y = 0;
 		LocalToGlobal(x, y);
-		if (mTextAlignment != XFont::eAlignLeft ||
+		/*
+		*	If there's a valid layout THEN
+		*	draw from it rather than from the string.
+		*/
+		if (mTextLayout &&
+			mTextLayout->Update())
+		{
+			/*
+			*	If the layout is wrapped THEN
+			*	draw each line aligned, and only the lines that fit within
+			*	the height of the label.
+			*/
+			if (mTextLayout->GetWrapWidth())
+			{
+				uint16_t	fontRows = xFont->FontRows();
+				uint8_t		endLine = mHeight > fontRows ? mHeight/fontRows : 1;
+				if (endLine > mTextLayout->NumLines())
+				{
+					endLine = mTextLayout->NumLines();
+				}
+				if (mTextAlignment != XFont::eAlignLeft ||
+					mEraseUnusedAreaAfterDraw)
+				{
+					for (uint8_t line = 0; line < endLine; line++)
+					{
+						mTextLayout->DrawLineAligned(line, x, y, mWidth, mTextAlignment, mEraseUnusedAreaAfterDraw);
+						y += fontRows;
+					}
+				} else
+				{
+					xFont->GetDisplay()->MoveTo(y, x);
+					mTextLayout->Draw(0, endLine);
+				}
+			} else if (mTextAlignment != XFont::eAlignLeft ||
+				mEraseUnusedAreaAfterDraw)
+			{
+				mTextLayout->DrawAligned(x, y, mWidth, mTextAlignment, mEraseUnusedAreaAfterDraw);
+			} else
+			{
+				xFont->GetDisplay()->MoveTo(y, x);
+				mTextLayout->Draw();
+			}
+		} else if (mTextAlignment != XFont::eAlignLeft ||
 			mEraseUnusedAreaAfterDraw)
 		{
 			xFont->DrawAligned(mString, x, y, mWidth, mTextAlignment, mEraseUnusedAreaAfterDraw);
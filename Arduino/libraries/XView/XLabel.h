@@ -25,6 +25,7 @@
 
 #include "XView.h"
 #include "XFont.h"
+#include "XTextLayout.h"
 
 class XLabel : public XView
 {
@@ -48,8 +49,7 @@ public:
 	inline XFont::Font*		GetFont(void)
 								{return(mFont);}
 	void					SetFont(
-								XFont::Font*			inFont)
-								{mFont = inFont;}
+								XFont::Font*			inFont);
 	inline uint16_t			GetTextColor(void) const
 								{return(mTextColor);}
 	void					SetTextColor(
@@ -65,8 +65,19 @@ public:
 	bool					HasString(void) const
 								{return(mString != 0);}
 	void					SetString(
-								const char*				inString)
-								{mString = inString;}
+								const char*				inString);
+	/*
+	*	SetTextLayout: Optional layout used to draw the string without
+	*	searching for and loading each glyph on every draw.  The layout follows
+	*	the label's string and font.  If the string's contents are changed
+	*	without changing the string pointer, call GetTextLayout()->Invalidate().
+	*	If the layout has a wrap width, each line is drawn aligned within the
+	*	label, and only the lines that fit within the label's height are drawn.
+	*/
+	void					SetTextLayout(
+								XTextLayout*			inTextLayout);
+	XTextLayout*			GetTextLayout(void) const
+								{return(mTextLayout);}
 	XFont::ETextAlignment	GetTextAlignment(void) const
 								{return(mTextAlignment);}
 	void					SetTextAlignment(
@@ -78,6 +89,7 @@ public:
 protected:
 	const char*				mString;
 	XFont::Font*			mFont;
+	XTextLayout*			mTextLayout;
 	uint16_t				mBGColor;
 	uint16_t				mTextColor;
 	XFont::ETextAlignment	mTextAlignment;
@@ -25,6 +25,7 @@
 #include "XMenuItem.h"
 #include "XRootView.h"
 #include "DisplayController.h"
+#include "XTextLayout.h"
 #ifdef __MACH__
 #include <stdio.h>
 #endif
@@ -264,7 +265,19 @@ uint16_t XMenu::DrawItem(
 			xFont->SetTextColor(kSelectedItemTextColor);
 		}
 
-		xFont->DrawAligned(inItem->GetString(), mX+mTextInset, inGlobalY+mTextItemInsetY, mItemWidth);
+		XTextLayout*	textLayout = inItem->mTextLayout;
+		if (textLayout)
+		{
+			textLayout->SetFont(mFont);
+		}
+		if (textLayout &&
+			textLayout->Update())
+		{
+			textLayout->DrawAligned(mX+mTextInset, inGlobalY+mTextItemInsetY, mItemWidth);
+		} else
+		{
+			xFont->DrawAligned(inItem->GetString(), mX+mTextInset, inGlobalY+mTextItemInsetY, mItemWidth);
+		}
 		inGlobalY+=mItemHeight;
 	/*
 	*	Else draw the separator
@@ -23,6 +23,7 @@
 
 #include "XMenuItem.h"
 #include "XMenu.h"
+#include "XTextLayout.h"
 
 /********************************* XMenuItem **********************************/
 XMenuItem::XMenuItem(
@@ -30,7 +31,29 @@ XMenuItem::XMenuItem(
 	const char*		inString,
 	XMenuItem*		inNextItem,
 	XMenu*			inSubmenu)
-	: mTag(inTag), mString(inString), mNextItem(inNextItem),
-	  mState(eOff), mSubmenu(inSubmenu)
+	: mTag(inTag), mString(inString), mTextLayout(nullptr),
+	  mNextItem(inNextItem), mState(eOff), mSubmenu(inSubmenu)
 {
 }
+
+/********************************* SetString **********************************/
+void XMenuItem::SetString(
+	const char*	inString)
+{
+	mString = inString;
+	if (mTextLayout)
+	{
+		mTextLayout->SetString(inString);
+	}
+}
+
+/******************************* SetTextLayout ********************************/
+void XMenuItem::SetTextLayout(
+	XTextLayout*	inTextLayout)
+{
+	mTextLayout = inTextLayout;
+	if (inTextLayout)
+	{
+		inTextLayout->SetString(mString);
+	}
+}
@@ -29,6 +29,7 @@
 
 #include <inttypes.h>
 class XMenu;
+class XTextLayout;
 
 class XMenuItem
 {
@@ -47,8 +48,15 @@ public:
 	const char*				GetString(void) const
 								{return(mString);}
 	void					SetString(
-								const char*				inString)
-								{mString = inString;}
+								const char*				inString);
+	/*
+	*	SetTextLayout: Optional layout used by XMenu to draw the item's string
+	*	without searching for and loading each glyph on every draw.
+	*/
+	void					SetTextLayout(
+								XTextLayout*			inTextLayout);
+	XTextLayout*			GetTextLayout(void) const
+								{return(mTextLayout);}
 	inline bool				IsSeparator(void) const
 								{return(mString[0] == '-');}
 	XMenu*					GetSubmenu(void)
@@ -72,6 +80,7 @@ public:
 								{return(mState == eOn);}
 protected:
 	const char*		mString;
+	XTextLayout*	mTextLayout;
 	uint16_t		mTag;
 	XMenuItemState	mState;
 	XMenu*			mSubmenu;
@@ -23,6 +23,7 @@
 
 #include "XNumberValueField.h"
 #include "DisplayController.h"
+#include "XRootView.h"
 
 /****************************** XNumberValueField *****************************/
 XNumberValueField::XNumberValueField(
@@ -44,14 +45,53 @@ XNumberValueField::XNumberValueField(
 	XFont::ETextAlignment	inTextAlignment)
 	: XValueField(inX, inY, inWidth, inTag, inNextView, inFont,
 	  inValue, inFGColor, inBGColor, inTextAlignment),
+	  mDrawnTextColor(inFGColor), mDrawnBGColor(inBGColor),
 	  mValueFormatter(inValueFormatter), mIncrement(inIncrement),
 	  mMinimum(inMinValue), mMaximum(inMaxValue), mValueWraps(inValueWraps),
 	  mRoundToIncrement(inRoundToIncrement)
 {
+	mDrawnString[0] = 0;
 }
 
 /********************************** DrawSelf **********************************/
 void XNumberValueField::DrawSelf(void)
+{
+	DrawValue(false);
+}
+
+/******************************** ValueChanged ********************************/
+/*
+*	Only the glyphs of the value string that changed are drawn.  When drawing
+*	is deferred, the field is invalidated instead.  Other changes drawn in
+*	the same Update may draw over the field, so the root view's Update draws
+*	the entire value string (DrawSelf.)
+*/
+void XNumberValueField::ValueChanged(
+	bool	inUpdate)
+{
+	UpdateStringForValue();
+	
+	if (inUpdate)
+	{
+		if (XRootView::DrawingIsDeferred())
+		{
+			Invalidate();
+		} else
+		{
+			DrawValue(true);
+		}
+	}
+}
+
+/********************************* DrawValue **********************************/
+/*
+*	When inChangedGlyphsOnly is set, only the glyphs that differ from the
+*	string currently displayed are drawn.  mDrawnString is empty when nothing
+*	has been drawn yet.  Everything is drawn when the colors differ from the
+*	colors the string was drawn with (e.g. the field was disabled.)
+*/
+void XNumberValueField::DrawValue(
+	bool	inChangedGlyphsOnly)
 {
 	XFont*	xFont = MakeFontCurrent();
 	if (xFont && mVisible)
@@ -63,7 +103,19 @@ void XNumberValueField::DrawSelf(void)
 		int16_t	x = 0;
 		int16_t	y = 0;
 		LocalToGlobal(x, y);
-		xFont->DrawAligned(mValueString, x, y, mWidth, mTextAlignment, true);
+		if (inChangedGlyphsOnly &&
+			mDrawnString[0] &&
+			mDrawnTextColor == textColor &&
+			mDrawnBGColor == mBGColor)
+		{
+			xFont->DrawChangedGlyphs(mValueString, mDrawnString, x, y, mWidth, mTextAlignment);
+		} else
+		{
+			xFont->DrawAligned(mValueString, x, y, mWidth, mTextAlignment, true);
+		}
+		strcpy(mDrawnString, mValueString);
+		mDrawnTextColor = textColor;
+		mDrawnBGColor = mBGColor;
 	}
 }
 
@@ -145,7 +197,13 @@ void XNumberValueField::OverrideValueString(
 							// mValueString.
 	if (inUpdate)
 	{
-		DrawSelf();
+		if (XRootView::DrawingIsDeferred())
+		{
+			Invalidate();
+		} else
+		{
+			DrawSelf();
+		}
 	}
 }
 
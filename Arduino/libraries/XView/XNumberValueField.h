@@ -69,8 +69,13 @@ public:
 								{mRoundToIncrement = inRoundToIncrement;}
 	virtual bool			IncrementValue(void);
 	virtual bool			DecrementValue(void);
+	virtual void			ValueChanged(
+								bool					inUpdate = true);
 protected:
 	char				mValueString[15];
+	char				mDrawnString[15];	// The string currently displayed
+	uint16_t			mDrawnTextColor;	// The colors mDrawnString was drawn with
+	uint16_t			mDrawnBGColor;
 	ValueFormatterPtr	mValueFormatter;
 	uint32_t			mIncrement;
 	int32_t				mMinimum;
@@ -81,5 +86,7 @@ protected:
 	virtual bool			ValueIsValid(
 								int32_t					inValue);
 	virtual void			UpdateStringForValue(void);
+	void					DrawValue(
+								bool					inChangedGlyphsOnly);
 };
 #endif // XNumberValueField_h
@@ -23,6 +23,7 @@
 
 #include "XRadioButton.h"
 #include "DisplayController.h"
+#include "XRootView.h"
 
 /*
 *	I couldn't come up with a satisfactory way of scaling the radio based on
@@ -164,7 +165,16 @@ void XRadioButton::SetState(
 				}
 			}
 		}
-		if (inUpdate)DrawSelf();
+		if (inUpdate)
+		{
+			if (XRootView::DrawingIsDeferred())
+			{
+				Invalidate();
+			} else
+			{
+				DrawSelf();
+			}
+		}
 	}
 }
 
@@ -24,8 +24,12 @@
 
 #include "XRootView.h"
 #include "DisplayController.h"
+#ifndef __MACH__
+#include <Arduino.h>
+#endif
 
 XRootView*		XRootView::sInstance;
+const uint32_t	XRootView::kStoppedAnimationPeriod = 100;
 
 
 /*********************************** XRootView ***********************************/
@@ -36,7 +40,9 @@ XRootView::XRootView(
 	: XView(0, 0, 0, 0, 0, nullptr, inSubViews),
 	  mDisplay(inDisplay),
 	  mViewChangedDelegate(inViewChangedDelegate),
-	  mModalView(nullptr)
+	  mModalView(nullptr), mPixelsLastFrame(0), mAnimations(nullptr),
+	  mFrameBudget(0), mMissedDeadlines(0), mNumDirtyRects(0),
+	  mDefersDrawing(false)
 {
 	sInstance = this;
 }
@@ -72,4 +78,236 @@ XView* XRootView::HitTest(
 	return(hitView);
 }
 
+/******************************* InvalidateRect *******************************/
+/*
+*	The rectangle is merged with any dirty rectangle it overlaps or touches.
+*	Because the merged rectangle is larger, it's checked against the rest
+*	again.  If there isn't room for the result, it's merged with the dirty
+*	rectangle whose area grows the least.
+*/
+void XRootView::InvalidateRect(
+	int16_t		inX,
+	int16_t		inY,
+	uint16_t	inWidth,
+	uint16_t	inHeight)
+{
+	if (inWidth && inHeight)
+	{
+		int32_t	left = inX;
+		int32_t	top = inY;
+		int32_t	right = left + inWidth;
+		int32_t	bottom = top + inHeight;
+		bool	merged;
+		do
+		{
+			merged = false;
+			uint8_t		mergeIndex = 0;
+			uint32_t	leastGrowth = 0xFFFFFFFF;
+			for (uint8_t i = 0; i < mNumDirtyRects; i++)
+			{
+				const SDirtyRect&	dirtyRect = mDirtyRects[i];
+				int32_t	dirtyRight = dirtyRect.x + dirtyRect.width;
+				int32_t	dirtyBottom = dirtyRect.y + dirtyRect.height;
+				uint32_t	growth = 0;
+				/*
+				*	If the rectangles don't overlap or touch THEN
+				*	calculate how much the dirty rectangle would grow by
+				*	merging.  (It always grows, so 0 means they overlap.)
+				*/
+				if (dirtyRect.x > right || left > dirtyRight ||
+					dirtyRect.y > bottom || top > dirtyBottom)
+				{
+					int32_t	unionWidth = (dirtyRight > right ? dirtyRight : right) -
+										(dirtyRect.x < left ? dirtyRect.x : left);
+					int32_t	unionHeight = (dirtyBottom > bottom ? dirtyBottom : bottom) -
+										(dirtyRect.y < top ? dirtyRect.y : top);
+					growth = (uint32_t)unionWidth * unionHeight -
+								(uint32_t)dirtyRect.width * dirtyRect.height;
+				}
+				if (growth < leastGrowth)
+				{
+					leastGrowth = growth;
+					mergeIndex = i;
+				}
+			}
+			/*
+			*	If the rectangle overlaps a dirty rectangle OR
+			*	there's no room for another dirty rectangle THEN
+			*	remove the dirty rectangle and merge it with the rectangle.
+			*/
+			if (leastGrowth == 0 ||
+				mNumDirtyRects == kMaxDirtyRects)
+			{
+				const SDirtyRect&	dirtyRect = mDirtyRects[mergeIndex];
+				if (dirtyRect.x < left)
+				{
+					left = dirtyRect.x;
+				}
+				if (dirtyRect.y < top)
+				{
+					top = dirtyRect.y;
+				}
+				if (dirtyRect.x + dirtyRect.width > right)
+				{
+					right = dirtyRect.x + dirtyRect.width;
+				}
+				if (dirtyRect.y + dirtyRect.height > bottom)
+				{
+					bottom = dirtyRect.y + dirtyRect.height;
+				}
+				mNumDirtyRects--;
+				mDirtyRects[mergeIndex] = mDirtyRects[mNumDirtyRects];
+				merged = true;
+			}
+		} while (merged);
+		SDirtyRect&	dirtyRect = mDirtyRects[mNumDirtyRects++];
+		dirtyRect.x = left;
+		dirtyRect.y = top;
+		dirtyRect.width = right - left;
+		dirtyRect.height = bottom - top;
+	}
+}
+
+/*********************************** Update ***********************************/
+/*
+*	The animations run first so that the areas they invalidate are drawn in
+*	the same frame.  The dirty rectangles are copied and cleared before
+*	drawing so that any view invalidated while drawing is drawn by the next
+*	Update.
+*/
+void XRootView::Update(void)
+{
+	if (mAnimations)
+	{
+		RunAnimations();
+	}
+	if (mNumDirtyRects)
+	{
+		SDirtyRect	dirtyRects[kMaxDirtyRects];
+		uint8_t		numDirtyRects = mNumDirtyRects;
+		memcpy(dirtyRects, mDirtyRects, numDirtyRects * sizeof(SDirtyRect));
+		mNumDirtyRects = 0;
+		if (mSubViews)
+		{
+			/*
+			*	Each pass is clipped to its dirty rectangle so that the views
+			*	intersecting it only redraw the part within it.
+			*/
+			for (uint8_t i = 0; i < numDirtyRects; i++)
+			{
+				const SDirtyRect&	dirtyRect = dirtyRects[i];
+				if (mDisplay)
+				{
+					mDisplay->SetClipRect(dirtyRect.x, dirtyRect.y, dirtyRect.width, dirtyRect.height);
+				}
+				mSubViews->Draw(dirtyRect.x, dirtyRect.y, dirtyRect.width, dirtyRect.height);
+			}
+			if (mDisplay)
+			{
+				mDisplay->ClearClipRect();
+			}
+		}
+	}
+	if (mDisplay)
+	{
+		mPixelsLastFrame = mDisplay->PixelsPushed();
+		mDisplay->ResetPixelsPushed();
+	}
+}
+
+/******************************** AddAnimation ********************************/
+/*
+*	The first call to Animate is due one period from now.
+*/
+void XRootView::AddAnimation(
+	XAnimation*	inAnimation)
+{
+	RemoveAnimation(inAnimation);
+	uint32_t	period = inAnimation->AnimationPeriod();
+	inAnimation->mDeadline = millis() + (period ? period : kStoppedAnimationPeriod);
+	ScheduleAnimation(inAnimation);
+}
+
+/****************************** RemoveAnimation *******************************/
+void XRootView::RemoveAnimation(
+	XAnimation*	inAnimation)
+{
+	XAnimation**	link = &mAnimations;
+	while (*link)
+	{
+		if (*link == inAnimation)
+		{
+			*link = inAnimation->mNextAnimation;
+			inAnimation->mNextAnimation = nullptr;
+			break;
+		}
+		link = &(*link)->mNextAnimation;
+	}
+}
+
+/***************************** ScheduleAnimation ******************************/
+/*
+*	Inserts inAnimation into the chain after the animations with the same or
+*	an earlier deadline.  The deadlines are compared as a signed difference
+*	so the order is correct when millis() wraps.
+*/
+void XRootView::ScheduleAnimation(
+	XAnimation*	inAnimation)
+{
+	XAnimation**	link = &mAnimations;
+	while (*link &&
+		(int32_t)(inAnimation->mDeadline - (*link)->mDeadline) >= 0)
+	{
+		link = &(*link)->mNextAnimation;
+	}
+	inAnimation->mNextAnimation = *link;
+	*link = inAnimation;
+}
 
+/******************************* RunAnimations ********************************/
+/*
+*	Runs the animations that are due, earliest deadline first.  Each one is
+*	removed from the head of the chain, run, and rescheduled, so an animation
+*	runs at most once per call.  A stopped animation (period 0) isn't run,
+*	it's checked again in kStoppedAnimationPeriod.  Due animations left when
+*	the frame budget is used stay at the head of the chain for the next call.
+*/
+void XRootView::RunAnimations(void)
+{
+	uint32_t	now = millis();
+	uint32_t	startTime = micros();
+	bool		ranOne = false;
+	while (mAnimations &&
+		(int32_t)(now - mAnimations->mDeadline) >= 0)
+	{
+		if (ranOne &&
+			mFrameBudget &&
+			(micros() - startTime) >= mFrameBudget)
+		{
+			break;
+		}
+		XAnimation*	animation = mAnimations;
+		mAnimations = animation->mNextAnimation;
+		uint32_t	period = animation->AnimationPeriod();
+		if (period)
+		{
+			/*
+			*	If a whole period has passed since the deadline THEN
+			*	at least one frame was missed.  Reschedule from now rather
+			*	than trying to catch up.
+			*/
+			animation->mDeadline += period;
+			if ((int32_t)(now - animation->mDeadline) >= 0)
+			{
+				mMissedDeadlines++;
+				animation->mDeadline = now + period;
+			}
+			animation->Animate();
+			ranOne = true;
+		} else
+		{
+			animation->mDeadline = now + kStoppedAnimationPeriod;
+		}
+		ScheduleAnimation(animation);
+	}
+}
@@ -28,6 +28,67 @@
 
 class DisplayController;
 
+/*
+*	XAnimation is a mixin class for views that change over time.  Rather than
+*	each view polling its own timer from the sketch's loop, the animation is
+*	added to the root view which calls Animate when each period passes (see
+*	XRootView::Update.)
+*
+*	Ex: 	class foo : public XView, public XAnimation
+*			{
+*			public:
+*				virtual uint32_t AnimationPeriod(void) const;
+*				virtual void Animate(void);
+*			}
+*/
+class XAnimation
+{
+public:
+							XAnimation(void)
+								: mNextAnimation(nullptr), mDeadline(0){}
+	/*
+	*	AnimationPeriod: The time in ms between calls to Animate.  0 when
+	*	the animation is stopped.
+	*/
+	virtual uint32_t		AnimationPeriod(void) const = 0;
+	/*
+	*	Animate: Advances the animation and invalidates what changed rather
+	*	than drawing it.  The drawing is done by Update's dirty rectangle
+	*	pass with everything else that changed.
+	*/
+	virtual void			Animate(void) = 0;
+protected:
+	friend class XRootView;
+	XAnimation*		mNextAnimation;	// Next in the chain, by deadline
+	uint32_t		mDeadline;		// millis() when Animate is next due
+};
+
+/*
+*	Invalidation:
+*	By default views draw as soon as they change.  When deferred drawing is
+*	set, Show, Hide, Enable, value changes (and any view calling Invalidate)
+*	only mark their global bounds as dirty.  The dirty rectangles are coalesced as
+*	they're added: a rectangle that overlaps one already marked is merged
+*	with it, and when all kMaxDirtyRects are in use, the new rectangle is
+*	merged with the one that grows the least.  Update, called once per pass
+*	of the sketch's loop, draws the views that intersect each dirty
+*	rectangle, then clears them.
+*
+*	The views intersecting a dirty rectangle are drawn with the display's
+*	clip rect set to it, so only the part of each view within the rectangle
+*	reaches the display.  Pixels a view writes directly (FillPixels,
+*	CopyPixels) aren't clipped.  Each area is also drawn once per Update
+*	rather than once per change.
+*
+*	Animation:
+*	The root view also schedules the animations added to it.  The
+*	animations are kept in a chain ordered by deadline.  Update runs the
+*	animations that are due, earliest deadline first, till the frame budget
+*	is used, then draws the dirty rectangles, so everything that changes
+*	in a pass of the loop is drawn together.  An animation that runs a whole
+*	period or more after its deadline counts as a missed deadline.  It's
+*	rescheduled a period from then rather than running again to catch up.
+*/
 class XRootView : public XView
 {
 public:
@@ -66,15 +127,81 @@ public:
 								{return(mModalView);}
 	static XRootView*		GetInstance(void)
 								{return(sInstance);}
+	void					SetDefersDrawing(
+								bool					inDefersDrawing = true)
+								{mDefersDrawing = inDefersDrawing;}
+	static bool				DrawingIsDeferred(void)
+								{return(sInstance && sInstance->mDefersDrawing);}
+	/*
+	*	InvalidateRect: Marks the global rectangle as needing to be drawn by
+	*	the next Update.
+	*/
+	void					InvalidateRect(
+								int16_t					inX,
+								int16_t					inY,
+								uint16_t				inWidth,
+								uint16_t				inHeight);
+	/*
+	*	Update: Draws the views intersecting the dirty rectangles.  Also
+	*	saves the number of pixels pushed to the display since the last
+	*	Update (see PixelsLastFrame.)
+	*/
+	void					Update(void);
+	uint8_t					NumDirtyRects(void) const
+								{return(mNumDirtyRects);}
+	/*
+	*	PixelsLastFrame: The number of pixels pushed to the display between
+	*	the last two calls to Update, whether drawn by Update or directly.
+	*/
+	uint32_t				PixelsLastFrame(void) const
+								{return(mPixelsLastFrame);}
+	void					AddAnimation(
+								XAnimation*				inAnimation);
+	void					RemoveAnimation(
+								XAnimation*				inAnimation);
+	/*
+	*	SetFrameBudget: The time in microseconds that Update can spend
+	*	running animations.  At least one due animation is always run.
+	*	0 for no limit (the default.)
+	*/
+	void					SetFrameBudget(
+								uint32_t				inFrameBudget)
+								{mFrameBudget = inFrameBudget;}
+	uint16_t				MissedDeadlines(void) const
+								{return(mMissedDeadlines);}
+	void					ResetMissedDeadlines(void)
+								{mMissedDeadlines = 0;}
+	enum
+	{
+		kMaxDirtyRects = 4
+	};
+	static const uint32_t	kStoppedAnimationPeriod;	// ms between checks of a stopped animation
 protected:
+	struct SDirtyRect
+	{
+		int16_t		x;
+		int16_t		y;
+		uint16_t	width;
+		uint16_t	height;
+	};
 	DisplayController*		mDisplay;
 	XViewChangedDelegate*	mViewChangedDelegate;
 	XView*					mModalView;
+	uint32_t				mPixelsLastFrame;
+	XAnimation*				mAnimations;	// Chain ordered by deadline
+	uint32_t				mFrameBudget;
+	uint16_t				mMissedDeadlines;
+	SDirtyRect				mDirtyRects[kMaxDirtyRects];
+	uint8_t					mNumDirtyRects;
+	bool					mDefersDrawing;
 	static XRootView*		sInstance;
 
 	virtual	void			HandleChange(
 							XView*						inView,
 							uint16_t					inAction = 0);
+	void					ScheduleAnimation(
+								XAnimation*				inAnimation);
+	void					RunAnimations(void);
 };
 
 #endif // XRootView_h
@@ -23,6 +23,7 @@
 
 #include "XValueField.h"
 #include "XStepper.h"
+#include "XRootView.h"
 
 /******************************** XValueField *********************************/
 XValueField::XValueField(
@@ -99,6 +100,8 @@ bool XValueField::SetValue(
 /*
 *	Called when the displayed value via ValueFormatter has changed or the value
 *	itself changed. (e.g. the displayed value unit has changed, etc.)
+*	When drawing is deferred, the field is invalidated and drawn by the root
+*	view's Update.
 */
 void XValueField::ValueChanged(
 	bool	inUpdate)
@@ -107,7 +110,13 @@ void XValueField::ValueChanged(
 	
 	if (inUpdate)
 	{
-		DrawSelf();
+		if (XRootView::DrawingIsDeferred())
+		{
+			Invalidate();
+		} else
+		{
+			DrawSelf();
+		}
 	}
 }
 
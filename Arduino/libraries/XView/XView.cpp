@@ -308,7 +308,13 @@ void XView::Show(void)
 	if (!mVisible)
 	{
 		mVisible = true;
-		DrawSelf();
+		if (XRootView::DrawingIsDeferred())
+		{
+			Invalidate();
+		} else
+		{
+			DrawSelf();
+		}
 	}
 }
 
@@ -325,27 +331,33 @@ void XView::Hide(void)
 		{
 			mSuperView->LocalToGlobal(x, y);
 		}
-		XView*	encompasingView = XRootView::GetInstance();
-		/*
-		*	Find the root view subview that completely encompasses this view.
-		*	In some cases this may be the root view itself.
-		*	The purpose of this is to limit the number of views that draw when
-		*	a view is hidden.
-		*/
-		for (XView* thisView = XRootView::GetInstance()->mSubViews; thisView;
-				thisView = thisView->mNextView)
+		if (XRootView::DrawingIsDeferred())
+		{
+			XRootView::GetInstance()->InvalidateRect(x, y, mWidth, mHeight);
+		} else
 		{
-			if (!thisView->IsVisible() ||
-				x < thisView->mX ||
-				y < thisView->mY ||
-				(x+mWidth) > (thisView->mX+thisView->mWidth) ||
-				(y+mHeight) > (thisView->mY+thisView->mHeight))
+			XView*	encompasingView = XRootView::GetInstance();
+			/*
+			*	Find the root view subview that completely encompasses this
+			*	view.  In some cases this may be the root view itself.
+			*	The purpose of this is to limit the number of views that draw
+			*	when a view is hidden.
+			*/
+			for (XView* thisView = XRootView::GetInstance()->mSubViews; thisView;
+					thisView = thisView->mNextView)
 			{
-				continue;
+				if (!thisView->IsVisible() ||
+					x < thisView->mX ||
+					y < thisView->mY ||
+					(x+mWidth) > (thisView->mX+thisView->mWidth) ||
+					(y+mHeight) > (thisView->mY+thisView->mHeight))
+				{
+					continue;
+				}
+				encompasingView = thisView;
 			}
-			encompasingView = thisView;
+			encompasingView->Draw(x, y, mWidth, mHeight);
 		}
-		encompasingView->Draw(x, y, mWidth, mHeight);
 	}
 }
 
@@ -355,7 +367,39 @@ void XView::Enable(
 	bool	inUpdate)
 {
 	mEnabled = inEnabled;
-	if (inUpdate)DrawSelf();
+	if (inUpdate)
+	{
+		if (XRootView::DrawingIsDeferred())
+		{
+			Invalidate();
+		} else
+		{
+			DrawSelf();
+		}
+	}
+}
+
+/********************************* Invalidate *********************************/
+void XView::Invalidate(void)
+{
+	Invalidate(0, 0, mWidth, mHeight);
+}
+
+/********************************* Invalidate *********************************/
+void XView::Invalidate(
+	int16_t		inLocalX,
+	int16_t		inLocalY,
+	uint16_t	inWidth,
+	uint16_t	inHeight)
+{
+	XRootView*	rootView = XRootView::GetInstance();
+	if (rootView)
+	{
+		int16_t	x = inLocalX;
+		int16_t	y = inLocalY;
+		LocalToGlobal(x, y);
+		rootView->InvalidateRect(x, y, inWidth, inHeight);
+	}
 }
 
 /******************************** ViewWithTag *********************************/
@@ -143,6 +143,18 @@ public:
 	virtual void			Enable(
 								bool					inEnabled=true,
 								bool					inUpdate=true);
+	/*
+	*	Invalidate: Marks the bounds of this view as needing to be drawn by
+	*	the next XRootView::Update.  Every view that intersects the bounds is
+	*	drawn, not just this view.  The second version marks a rectangle
+	*	local to this view.
+	*/
+	void					Invalidate(void);
+	void					Invalidate(
+								int16_t					inLocalX,
+								int16_t					inLocalY,
+								uint16_t				inWidth,
+								uint16_t				inHeight);
 protected:
 	bool			mEnabled;
 	bool			mVisible;
@@ -169,16 +169,37 @@ uint16_t EntryIndexFor(
 			std::string	errorStr, warningStr, infoStr;
 			BOOL	suppFontOK = [[NSFileManager defaultManager] fileExistsAtPath:inSupplementalFontURL.path isDirectory:&isDirectory] &&
 										isDirectory == NO;
-			if (suppFontOK == NO)
+			FallbackFaces	fallbackFaces;
+			if (suppFontOK)
+			{
+				fallbackFaces.push_back(FallbackFace(inSupplementalFontURL.path.UTF8String, inSupplementalFaceIndex));
+			} else
 			{
 				warningStr.append("Supplemental font not found.\n");
 			}
+			size_t	warningLen = warningStr.length();
 			createErr = SubsetFontCreator::CreateXfntFile(inFontURL.path.UTF8String,
 								xfntFile, xfntFile, (int32_t)inPointSize, (int)inOptions,
-								charcodeItr, inFaceIndex,
-								inSupplementalFontURL.path.UTF8String,
-								inSupplementalFaceIndex,
+								charcodeItr, inFaceIndex, fallbackFaces,
 								&errorStr, &warningStr, &infoStr);
+			/*
+			*	If a glyph's metrics are too large for 8 bits THEN start
+			*	over using 16 bit metrics (as SubsetFontCreator::CreateFile
+			*	does.)
+			*/
+			if (createErr == eMetricsTooLargeErr)
+			{
+				errorStr.clear();
+				warningStr.resize(warningLen);
+				infoStr.clear();
+				fseek(xfntFile, 0, SEEK_SET);
+				charcodeItr.MoveToStart();
+				createErr = SubsetFontCreator::CreateXfntFile(inFontURL.path.UTF8String,
+								xfntFile, xfntFile, (int32_t)inPointSize,
+								(int)inOptions | SubsetFontCreator::e16BitMetrics,
+								charcodeItr, inFaceIndex, fallbackFaces,
+								&errorStr, &warningStr, &infoStr);
+			}
 			fclose(xfntFile);
 		#ifndef DEBUG_ARDUINO
 			_bitmapIsRotated = (inOptions & SubsetFontCreator::eRotated) != 0;
@@ -258,9 +279,26 @@ uint8_t CalcOneBitHeight(
 	const CharcodeRun* charCodeRun = (const CharcodeRun*)&fontHeader[1];
 
 #ifdef DEBUG_ARDUINO
-	const uint16_t*	glyphDataOffset = (const uint16_t*)&charCodeRun[fontHeader->numCharcodeRuns];
-	DataStream_S	glyphDataStream((const uint8_t*)&glyphDataOffset[fontHeader->numCharCodes +1],
-										glyphDataOffset[fontHeader->numCharCodes]);
+	// Version 3 fonts start with a FontHeader16 (16 bit metrics)
+	uint16_t	numCharcodeRuns = fontHeader->numCharcodeRuns;
+	uint16_t	numCharCodes = fontHeader->numCharCodes;
+	if (fontHeader->version >= 3)
+	{
+		const FontHeader16*	fontHeader16 = (const FontHeader16*)inXFntData.bytes;
+		charCodeRun = (const CharcodeRun*)&fontHeader16[1];
+		numCharcodeRuns = fontHeader16->numCharcodeRuns;
+		numCharCodes = fontHeader16->numCharCodes;
+	}
+	// Version 2 and 3 fonts have a CharcodePlanes array following the runs.
+	const CharcodePlane*	charcodePlane = (const CharcodePlane*)&charCodeRun[numCharcodeRuns];
+	uint32_t	numCharcodePlanes = 0;
+	if (fontHeader->version >= 2)
+	{
+		while (charcodePlane[numCharcodePlanes++].plane != 0xFFFF){}
+	}
+	const uint16_t*	glyphDataOffset = (const uint16_t*)&charcodePlane[numCharcodePlanes];
+	DataStream_S	glyphDataStream((const uint8_t*)&glyphDataOffset[numCharCodes +1],
+										glyphDataOffset[numCharCodes]);
 	XFont	xFont;
 	XFontR1BitDataStream*	oneBitDataStream = NULL;
 	XFontRH1BitDataStream*	oneBitHDataStream = NULL;
@@ -284,7 +322,8 @@ uint8_t CalcOneBitHeight(
 		}
 	}
 	XFont16BitDataStream xFontDataStream(&xFont, dataStream);
-	XFont::Font	xFontFont(fontHeader, charCodeRun, glyphDataOffset, &xFontDataStream);
+	XFont::Font	xFontFont(fontHeader, charCodeRun, glyphDataOffset, &xFontDataStream,
+							nullptr, nullptr, numCharcodePlanes ? charcodePlane : nullptr);
 	xFont.SetTextColor([ArduinoDisplayView to565Color:inTextColor]);
 	xFont.SetBGTextColor([ArduinoDisplayView to565Color:inTextBGColor]);
 	// Because there is no display yet, set the font so that measurements can
@@ -147,6 +147,7 @@ void BitmapDisplayController::FillPixels(
 	uint32_t	inPixelsToFill,
 	uint16_t	inFillColor)
 {
+	mPixelsPushed += inPixelsToFill;
 	uint32_t*	current = mCurrent;
 	uint32_t	fillColor = Pixel16To24(inFillColor);
 	while (inPixelsToFill)
@@ -264,6 +265,7 @@ void BitmapDisplayController::WritePixels(
 	const uint16_t*	inPixels,
 	uint16_t		inPixelsToWrite)
 {
+	mPixelsPushed += inPixelsToWrite;
 	uint32_t*	current = mCurrent;
 	if (mAddressingMode == eHorizontal)
 	{
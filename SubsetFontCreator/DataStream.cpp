@@ -122,6 +122,26 @@ uint32_t DataStream_S::Write(
 	return(bytesWritten);
 }
 
+/************************************ Peek ************************************/
+uint32_t DataStream_S::Peek(
+	const uint8_t*&	outPtr,
+	uint32_t		inMaxLen) const
+{
+	outPtr = mCurrent;
+	return(Clip(inMaxLen));
+}
+
+/********************************** Acquire ***********************************/
+uint32_t DataStream_S::Acquire(
+	const uint8_t*&	outPtr,
+	uint32_t		inMaxLen)
+{
+	uint32_t	bytesAcquired = Clip(inMaxLen);
+	outPtr = mCurrent;
+	mCurrent += bytesAcquired;
+	return(bytesAcquired);
+}
+
 /******************************** DataStream_P ********************************/
 DataStream_P::DataStream_P(
 	const void*	inStartAddress,
@@ -150,6 +170,40 @@ uint32_t DataStream_P::Write(
 	return(Clip(inLength));
 }
 
+/************************************ Peek ************************************/
+/*
+*	On AVR PROGMEM is in a separate address space and can only be accessed via
+*	the pgm_read/memcpy_P functions, so direct access isn't supported.  On
+*	targets where flash is memory mapped (and on the Mac), PROGMEM can be
+*	accessed directly.
+*/
+uint32_t DataStream_P::Peek(
+	const uint8_t*&	outPtr,
+	uint32_t		inMaxLen) const
+{
+#ifdef __AVR__
+	return(0);
+#else
+	outPtr = mCurrent;
+	return(Clip(inMaxLen));
+#endif
+}
+
+/********************************** Acquire ***********************************/
+uint32_t DataStream_P::Acquire(
+	const uint8_t*&	outPtr,
+	uint32_t		inMaxLen)
+{
+#ifdef __AVR__
+	return(0);
+#else
+	uint32_t	bytesAcquired = Clip(inMaxLen);
+	outPtr = mCurrent;
+	mCurrent += bytesAcquired;
+	return(bytesAcquired);
+#endif
+}
+
 /****************************** DataStream_E *******************************/
 DataStream_E::DataStream_E(
 	const void*	inStartAddress,
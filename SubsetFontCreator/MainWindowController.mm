@@ -796,22 +796,22 @@ SMenuItemDesc	menuItems[] = {
 			{
 				pointSize = 4;
 			/*
-			*	The max font size is limited by the FontHeader struct where the
-			*	FontHeader.height must be less than 255.  Note that even if this
-			*	limitation is removed by changing the FontHeader to use uint16_t rather
-			*	than uint8_t, there would still be issues with other structures such as
-			*	CharcodeRun where CharcodeRun.start could overrun after several glyphs
-			*	due to the increased size of each glyph.  Also glyphDataOffset in the
-			*	generated header file would also eventually overrun depending on the
-			*	number of glyphs.
+			*	Fonts with metrics greater than 255 use 16 bit metrics (FontHeader16)
+			*	and glyph data larger than 64KB uses segmented data offsets, so the
+			*	max font size is only limited to keep the glyph data within reason.
 			*/
-			} else if (pointSize > 212)
+			} else if (pointSize > 1000)
 			{
-				pointSize = 212;
+				pointSize = 1000;
 			}
 			BOOL	suppFontOK = [[NSFileManager defaultManager] fileExistsAtPath:suppFontPathControl.URL.path isDirectory:&isDirectory] &&
 																		isDirectory == NO;
-			if (!suppFontOK)
+			FallbackFaces	fallbackFaces;
+			if (suppFontOK)
+			{
+				fallbackFaces.push_back(FallbackFace(suppFontPathControl.URL.path.UTF8String,
+											suppFacePopupButton.indexOfSelectedItem));
+			} else
 			{
 				warningStr.append("Supplemental Font not found.\n");
 			}
@@ -824,8 +824,7 @@ SMenuItemDesc	menuItems[] = {
 				inOptions,
 				subsetTextField.stringValue.UTF8String,
 				facePopupButton.indexOfSelectedItem,
-				suppFontOK ? suppFontPathControl.URL.path.UTF8String : nil,
-				suppFacePopupButton.indexOfSelectedItem,
+				fallbackFaces,
 				&errorStr,
 				&warningStr,
 				&infoStr);
@@ -854,18 +853,13 @@ SMenuItemDesc	menuItems[] = {
 	{
 		pointSize = 4;
 	/*
-	*	The max font size is limited by the FontHeader struct where the
-	*	FontHeader.height must be less than 255.  Note that even if this
-	*	limitation is removed by changing the FontHeader to use uint16_t rather
-	*	than uint8_t, there would still be issues with other structures such as
-	*	CharcodeRun where CharcodeRun.start could overrun after several glyphs
-	*	due to the increased size of each glyph.  Also glyphDataOffset in the
-	*	generated header file would also eventually overrun depending on the
-	*	number of glyphs.
+	*	Fonts with metrics greater than 255 use 16 bit metrics (FontHeader16)
+	*	and glyph data larger than 64KB uses segmented data offsets, so the
+	*	max font size is only limited to keep the glyph data within reason.
 	*/
-	} else if (pointSize > 212)
+	} else if (pointSize > 1000)
 	{
-		pointSize = 212;
+		pointSize = 1000;
 	}
 	[_logViewController clear:self];
 	BOOL	isColor = sampleCSPopupButton.indexOfSelectedItem == 1;
@@ -30,10 +30,13 @@
 
 #include "SubsetFontCreator.h"
 #include "TabbedFileStream.h"
+#include "XFont.h"
 #include <string>
+#include <algorithm>
 #include <ft2build.h>
 
 #include FT_FREETYPE_H
+#include FT_OUTLINE_H
 /********************************* DumpBinary *********************************/
 void DumpBinaryX(
 	uint8_t		inValue)
@@ -172,15 +175,32 @@ int SubsetFontCreator::CreateFile(
 	int				inOptions,
 	const char*		inSubset,
 	long			inFontFaceIndex,
-	const char*		inSupplementalFontFilePath,
-	long			inSupplementalFontFaceIndex,
+	const FallbackFaces&	inFallbackFaces,
 	std::string*	outErrorStr,
 	std::string*	outWarningStr,
-	std::string*	outInfoStr)
+	std::string*	outInfoStr,
+	const char*		inUsageProfilePath,
+	FontSession*	inSession,
+	const StaticStrings*	inStaticStrings)
 {
 	SubsetCharcodeIterator	charcodeIterator(inSubset, outErrorStr);
+	GlyphUsageProfile	usageProfile;
 	int	createFileError = eSubsetNoErr;
 	bool	success = charcodeIterator.IsValid();
+	if (success &&
+		inUsageProfilePath &&
+		inUsageProfilePath[0])
+	{
+		success = usageProfile.Load(inUsageProfilePath);
+		if (!success)
+		{
+			createFileError = eUsageProfileReadErr;
+			if (outErrorStr)
+			{
+				outErrorStr->assign("Unable to read the usage profile.");
+			}
+		}
+	}
 	if (success)
 	{
 		std::string utf8ExportPath(inExportPath);
@@ -203,10 +223,24 @@ int SubsetFontCreator::CreateFile(
 				}
 				if (glyphDataFile)
 				{
-					createFileError = CreateXfntFile(inFontFilePath, file, glyphDataFile,
+					createFileError = CreateXfntFileAndRetry(inFontFilePath, file, glyphDataFile,
 										inPointSize, inOptions, charcodeIterator, inFontFaceIndex,
-										inSupplementalFontFilePath, inSupplementalFontFaceIndex,
-											outErrorStr, outWarningStr, outInfoStr);
+											inFallbackFaces, outErrorStr, outWarningStr, outInfoStr,
+												usageProfile.IsEmpty() ? NULL : &usageProfile, inSession,
+													inStaticStrings);
+					/*
+					*	32 bit offsets are only supported in the binary format.
+					*/
+					if (inExportFormat != eBinaryXfntFormat &&
+						createFileError == eSubsetNoErr &&
+						(inOptions & e32BitDataOffsets))
+					{
+						createFileError = eDataOffsetTooLargeErr;
+						if (outErrorStr)
+						{
+							outErrorStr->assign("Glyph data within a 256 glyph segment exceeds 64KB - 32 bit offsets are only supported by the binary format.");
+						}
+					}
 					if (inExportFormat != eBinaryXfntFormat &&
 						createFileError == eSubsetNoErr)
 					{
@@ -217,7 +251,7 @@ int SubsetFontCreator::CreateFile(
 							{
 								std::string	subsetStr;
 								charcodeIterator.GetSubset(subsetStr);
-								createFileError = XFntToC_Header(file, utf8ExportPath.c_str(), exportFile, subsetStr, !glyphDataSeparately, inOptions);
+								createFileError = XFntToC_Header(file, utf8ExportPath.c_str(), exportFile, subsetStr, !glyphDataSeparately, inOptions, NULL, inStaticStrings);
 								break;
 							}
 							default:
@@ -233,13 +267,85 @@ int SubsetFontCreator::CreateFile(
 				fclose(file);
 			}
 		}
-	} else
+	} else if (createFileError == eSubsetNoErr)
 	{
 		createFileError = charcodeIterator.GetError();
 	}
 	return(createFileError);
 }
 
+/*************************** CreateXfntFileAndRetry ***************************/
+/*
+*	Calls CreateXfntFile.  If the glyph data is too large for 16 bit offsets
+*	THEN start over using segmented offsets, and if a 256 glyph segment is
+*	too large for segmented offsets THEN start over using 32 bit offsets.  If
+*	a glyph's metrics are too large for 8 bits THEN start over using 16 bit
+*	metrics.  None are smaller than what they replace so the files don't need
+*	to be truncated.  (16 bit metrics may then need wider offsets.)
+*	On return ioOptions contains the options the file was created with.
+*/
+int SubsetFontCreator::CreateXfntFileAndRetry(
+	const char*				inFontFilePath,
+	FILE*					inExportFile,
+	FILE*					inGlyphDataExportFile,
+	int32_t					inPointSize,
+	int&					ioOptions,
+	SubsetCharcodeIterator&	inCharcodeItr,
+	long					inFontFaceIndex,
+	const FallbackFaces&	inFallbackFaces,
+	std::string*			outErrorStr,
+	std::string*			outWarningStr,
+	std::string*			outInfoStr,
+	const GlyphUsageProfile*	inUsageProfile,
+	FontSession*			inSession,
+	const StaticStrings*	inStaticStrings)
+{
+	size_t	warningLen = outWarningStr ? outWarningStr->length() : 0;
+	size_t	infoLen = outInfoStr ? outInfoStr->length() : 0;
+	int	createFileError = CreateXfntFile(inFontFilePath, inExportFile,
+							inGlyphDataExportFile, inPointSize, ioOptions,
+							inCharcodeItr, inFontFaceIndex, inFallbackFaces,
+							outErrorStr, outWarningStr, outInfoStr,
+							inUsageProfile, inSession, inStaticStrings);
+	while ((createFileError == eDataOffsetTooLargeErr &&
+			(ioOptions & e32BitDataOffsets) == 0) ||
+		(createFileError == eMetricsTooLargeErr &&
+			(ioOptions & e16BitMetrics) == 0))
+	{
+		if (createFileError == eMetricsTooLargeErr)
+		{
+			ioOptions |= e16BitMetrics;
+		} else if (ioOptions & eSegmentedDataOffsets)
+		{
+			ioOptions = (ioOptions & ~eSegmentedDataOffsets) | e32BitDataOffsets;
+		} else
+		{
+			ioOptions |= eSegmentedDataOffsets;
+		}
+		if (outErrorStr)
+		{
+			outErrorStr->clear();
+		}
+		if (outWarningStr)
+		{
+			outWarningStr->resize(warningLen);
+		}
+		if (outInfoStr)
+		{
+			outInfoStr->resize(infoLen);
+		}
+		fseek(inExportFile, 0, SEEK_SET);
+		fseek(inGlyphDataExportFile, 0, SEEK_SET);
+		inCharcodeItr.MoveToStart();
+		createFileError = CreateXfntFile(inFontFilePath, inExportFile,
+							inGlyphDataExportFile, inPointSize, ioOptions,
+							inCharcodeItr, inFontFaceIndex, inFallbackFaces,
+							outErrorStr, outWarningStr, outInfoStr,
+							inUsageProfile, inSession, inStaticStrings);
+	}
+	return(createFileError);
+}
+
 /******************************** GetFaceNames ********************************/
 int SubsetFontCreator::GetFaceNames(
 	const char*					inFontFilePath,
@@ -308,6 +414,510 @@ int SubsetFontCreator::GetFaceNames(
 	return(success);
 }
 
+/***************************** WriteKerningPairs ******************************/
+/*
+*	Writes the KerningLefts and KerningPairs arrays (see XFontGlyph.h) for
+*	every pair of glyphs in inEntryGlyphIndexes that inFace kerns.  The
+*	arrays are always written, even when there are no kerning pairs.
+*	Returns the number of kerning pairs.
+*/
+static uint32_t WriteKerningPairs(
+	FT_Face						inFace,
+	const std::vector<FT_UInt>&	inEntryGlyphIndexes,
+	FILE*						inExportFile,
+	std::string*				outWarningStr)
+{
+	std::vector<KerningLeft>	kerningLefts;
+	std::vector<KerningPair>	kerningPairs;
+	uint32_t	numEntries = (uint32_t)inEntryGlyphIndexes.size();
+	if (FT_HAS_KERNING(inFace))
+	{
+		for (uint32_t left = 0; left < numEntries; left++)
+		{
+			if (inEntryGlyphIndexes[left] == 0)
+			{
+				continue;
+			}
+			/*
+			*	pairIndex is 16 bit.  Stop if this glyph's pairs could
+			*	overflow it.
+			*/
+			if (kerningPairs.size() + numEntries > 0xFFFF)
+			{
+				if (outWarningStr)
+				{
+					outWarningStr->append("Too many kerning pairs, some were not exported.\n");
+				}
+				break;
+			}
+			KerningLeft	kerningLeft;
+			kerningLeft.entryIndex = (uint16_t)left;
+			kerningLeft.pairIndex = (uint16_t)kerningPairs.size();
+			for (uint32_t right = 0; right < numEntries; right++)
+			{
+				FT_Vector	delta;
+				if (inEntryGlyphIndexes[right] &&
+					FT_Get_Kerning(inFace, inEntryGlyphIndexes[left],
+						inEntryGlyphIndexes[right], FT_KERNING_DEFAULT, &delta) == 0 &&
+					delta.x/64 != 0)
+				{
+					KerningPair	kerningPair;
+					kerningPair.entryIndex = (uint16_t)right;
+					kerningPair.adjust = (int16_t)(delta.x/64);
+					kerningPairs.push_back(kerningPair);
+				}
+			}
+			if (kerningPairs.size() > kerningLeft.pairIndex)
+			{
+				kerningLefts.push_back(kerningLeft);
+			}
+		}
+	} else if (outWarningStr)
+	{
+		outWarningStr->append("This font has no kerning pairs (kern table.)\n");
+	}
+	// Add the last KerningLeft used to end the search and get the pair count.
+	KerningLeft	lastKerningLeft;
+	lastKerningLeft.entryIndex = 0xFFFF;
+	lastKerningLeft.pairIndex = (uint16_t)kerningPairs.size();
+	kerningLefts.push_back(lastKerningLeft);
+	fwrite(kerningLefts.data(), sizeof(KerningLeft), kerningLefts.size(), inExportFile);
+	if (kerningPairs.size())
+	{
+		fwrite(kerningPairs.data(), sizeof(KerningPair), kerningPairs.size(), inExportFile);
+	}
+	return((uint32_t)kerningPairs.size());
+}
+
+/********************************* FontSession ********************************/
+/*
+*	FontSession opens the FreeType library, the font face and its fallback
+*	faces once so that they can be shared by more than one size (see
+*	CreateFamilyFile.)  library is NULL if FreeType couldn't be initialized,
+*	face is NULL if the font couldn't be opened.  Fallback faces that can't
+*	be opened are skipped with a warning.
+*
+*	When singleRasterization is set, each glyph of the current size is
+*	rendered once as grayscale and cached, and 1 bit glyphs are derived from
+*	the cached grayscale bitmap (see LoadGlyph.)  This allows several formats
+*	of the same size to be created from one rasterization (see
+*	CreateMultiFormatFiles.)
+*/
+struct GlyphBitmap
+{
+	int32_t			rows;
+	int32_t			width;		// In pixels
+	int32_t			pitch;		// Bytes per row
+	int32_t			bitmapLeft;
+	int32_t			bitmapTop;
+	int32_t			advanceX;	// 26.6 fixed point, as FT_GlyphSlot.advance.x
+	const uint8_t*	buffer;		// 1 bit rows are 16 bit word aligned
+};
+
+struct FontSession
+{
+	FT_Library				library;
+	FT_Face					face;
+	std::vector<FT_Face>	openFallbackFaces;
+	// The fallback faces that support the current size (see SetCharSize)
+	std::vector<FT_Face>	fallbackFaces;
+	bool					singleRasterization;
+	uint8_t					monoThreshold;	// Grayscale values >= are set
+	bool					monoRerender;
+	uint32_t				numMonoRerendered;
+	int32_t					pointSize;
+	struct CachedGlyph
+	{
+		GlyphBitmap				bitmap;
+		std::vector<uint8_t>	data;
+	};
+	// The grayscale glyphs of pointSize by charcode
+	std::map<uint32_t, CachedGlyph>	grayscaleGlyphs;
+	std::vector<uint8_t>	monoData;	// Last 1 bit glyph derived
+							FontSession(
+								const char*				inFontFilePath,
+								long					inFontFaceIndex,
+								const FallbackFaces&	inFallbackFaces,
+								std::string*			outWarningStr);
+							~FontSession(void);
+	FT_Error				SetCharSize(
+								int32_t					inPointSize,
+								std::string*			outWarningStr);
+	FT_Error				LoadGlyph(
+								FT_Face					inFace,
+								FT_UInt					inGlyphIndex,
+								uint32_t				inCharcode,
+								bool					inOneBit,
+								GlyphBitmap&			outBitmap);
+protected:
+	static void				SetFromSlot(
+								FT_GlyphSlot			inSlot,
+								GlyphBitmap&			outBitmap);
+	bool					MonoHintingDiffers(
+								FT_Face					inFace,
+								FT_UInt					inGlyphIndex,
+								const GlyphBitmap&		inGrayscale);
+};
+
+/********************************* FontSession ********************************/
+FontSession::FontSession(
+	const char*				inFontFilePath,
+	long					inFontFaceIndex,
+	const FallbackFaces&	inFallbackFaces,
+	std::string*			outWarningStr)
+	: library(NULL), face(NULL), singleRasterization(false),
+	  monoThreshold(128), monoRerender(false), numMonoRerendered(0),
+	  pointSize(0)
+{
+	if (FT_Init_FreeType(&library) == 0)
+	{
+		if (FT_New_Face(library, inFontFilePath, inFontFaceIndex, &face))
+		{
+			face = NULL;
+		}
+		FallbackFaces::const_iterator	itr = inFallbackFaces.begin();
+		FallbackFaces::const_iterator	itrEnd = inFallbackFaces.end();
+		for (; itr != itrEnd; ++itr)
+		{
+			FT_Face	fallbackFace = NULL;
+			if (FT_New_Face(library, itr->path.c_str(), itr->faceIndex, &fallbackFace) == 0)
+			{
+				openFallbackFaces.push_back(fallbackFace);
+			} else if (outWarningStr)
+			{
+				outWarningStr->append("Unable to open fallback font ");
+				outWarningStr->append(itr->path);
+				outWarningStr->append(", skipped.\n");
+			}
+		}
+	} else
+	{
+		library = NULL;
+	}
+}
+
+/******************************** ~FontSession ********************************/
+FontSession::~FontSession(void)
+{
+	if (library)
+	{
+		for (size_t i = 0; i < openFallbackFaces.size(); i++)
+		{
+			FT_Done_Face(openFallbackFaces[i]);
+		}
+		if (face)
+		{
+			FT_Done_Face(face);
+		}
+		FT_Done_FreeType(library);
+	}
+}
+
+/********************************* SetCharSize ********************************/
+/*
+*	Sets the size of the face and the fallback faces.  Fallback faces that
+*	don't support inPointSize are left out of fallbackFaces with a warning.
+*	Returns the error from setting the size of the face.
+*/
+FT_Error FontSession::SetCharSize(
+	int32_t			inPointSize,
+	std::string*	outWarningStr)
+{
+	FT_Error error = FT_Set_Char_Size(
+				face,	/* handle to face object           */
+				0,		/* char_width in 1/64th of points  */
+				inPointSize*64,	/* char_height in 1/64th of points */
+				72,		/* horizontal device resolution    */
+				72);	/* vertical device resolution      */
+	if (pointSize != inPointSize)
+	{
+		pointSize = inPointSize;
+		grayscaleGlyphs.clear();
+	}
+	fallbackFaces.clear();
+	for (size_t i = 0; i < openFallbackFaces.size(); i++)
+	{
+		if (FT_Set_Char_Size(openFallbackFaces[i], 0, inPointSize*64, 72, 72) == 0)
+		{
+			fallbackFaces.push_back(openFallbackFaces[i]);
+		} else if (outWarningStr)
+		{
+			char warningBuff[256];
+			outWarningStr->append(warningBuff, snprintf(warningBuff, 256,
+				"Fallback font %s doesn't support %d points, skipped.\n",
+				openFallbackFaces[i]->family_name ? openFallbackFaces[i]->family_name : "?",
+				(int)inPointSize));
+		}
+	}
+	return(error);
+}
+
+/********************************** LoadGlyph *********************************/
+/*
+*	Renders the glyph inGlyphIndex of inFace, one of the session's faces.
+*	inCharcode identifies the glyph in the grayscale cache.  outBitmap is
+*	only valid until the next call to LoadGlyph.
+*
+*	Unless singleRasterization, the glyph is rendered by FreeType as either
+*	mono or grayscale.  When singleRasterization, the grayscale rendering is
+*	cached, and a 1 bit glyph sets the pixels of the grayscale bitmap that
+*	are >= monoThreshold.  If monoRerender, glyphs whose mono hinting
+*	produces a different bitmap size or advance than the grayscale
+*	rendering are rendered by FreeType as mono instead.
+*/
+FT_Error FontSession::LoadGlyph(
+	FT_Face			inFace,
+	FT_UInt			inGlyphIndex,
+	uint32_t		inCharcode,
+	bool			inOneBit,
+	GlyphBitmap&	outBitmap)
+{
+	FT_Error	error = 0;
+	if (!singleRasterization)
+	{
+		error = FT_Load_Glyph(inFace, inGlyphIndex,
+					inOneBit ? (FT_LOAD_RENDER | FT_LOAD_TARGET_MONO) : FT_LOAD_RENDER);
+		if (error == 0)
+		{
+			SetFromSlot(inFace->glyph, outBitmap);
+		}
+	} else
+	{
+		std::map<uint32_t, CachedGlyph>::iterator	itr = grayscaleGlyphs.find(inCharcode);
+		if (itr == grayscaleGlyphs.end())
+		{
+			error = FT_Load_Glyph(inFace, inGlyphIndex, FT_LOAD_RENDER);
+			if (error == 0)
+			{
+				/*
+				*	The cached copy has no row padding, as expected by the
+				*	grayscale run length encoder.
+				*/
+				CachedGlyph&	cachedGlyph = grayscaleGlyphs[inCharcode];
+				FT_Bitmap&		bitmap = inFace->glyph->bitmap;
+				SetFromSlot(inFace->glyph, cachedGlyph.bitmap);
+				cachedGlyph.data.resize(bitmap.rows * bitmap.width + 1);
+				for (uint32_t row = 0; row < bitmap.rows; row++)
+				{
+					memcpy(&cachedGlyph.data[row * bitmap.width],
+							&bitmap.buffer[row * bitmap.pitch], bitmap.width);
+				}
+				cachedGlyph.bitmap.pitch = bitmap.width;
+				cachedGlyph.bitmap.buffer = cachedGlyph.data.data();
+				itr = grayscaleGlyphs.find(inCharcode);
+			}
+		}
+		if (error == 0)
+		{
+			const GlyphBitmap&	grayscale = itr->second.bitmap;
+			if (!inOneBit)
+			{
+				outBitmap = grayscale;
+			} else if (monoRerender &&
+				MonoHintingDiffers(inFace, inGlyphIndex, grayscale))
+			{
+				error = FT_Render_Glyph(inFace->glyph, FT_RENDER_MODE_MONO);
+				if (error == 0)
+				{
+					numMonoRerendered++;
+					SetFromSlot(inFace->glyph, outBitmap);
+				}
+			} else
+			{
+				outBitmap = grayscale;
+				outBitmap.pitch = ((grayscale.width + 15)/16) * 2;
+				monoData.assign(outBitmap.pitch * grayscale.rows + 1, 0);
+				const uint8_t*	grayPtr = grayscale.buffer;
+				for (int32_t row = 0; row < grayscale.rows; row++)
+				{
+					uint8_t*	monoRowPtr = &monoData[row * outBitmap.pitch];
+					for (int32_t col = 0; col < grayscale.width; col++)
+					{
+						if (*(grayPtr++) >= monoThreshold)
+						{
+							monoRowPtr[col >> 3] |= (0x80 >> (col & 7));
+						}
+					}
+				}
+				outBitmap.buffer = monoData.data();
+			}
+		}
+	}
+	return(error);
+}
+
+/********************************* SetFromSlot ********************************/
+void FontSession::SetFromSlot(
+	FT_GlyphSlot	inSlot,
+	GlyphBitmap&	outBitmap)
+{
+	outBitmap.rows = inSlot->bitmap.rows;
+	outBitmap.width = inSlot->bitmap.width;
+	outBitmap.pitch = inSlot->bitmap.pitch;
+	outBitmap.bitmapLeft = inSlot->bitmap_left;
+	outBitmap.bitmapTop = inSlot->bitmap_top;
+	outBitmap.advanceX = (int32_t)inSlot->advance.x;
+	outBitmap.buffer = inSlot->bitmap.buffer;
+}
+
+/***************************** MonoHintingDiffers *****************************/
+/*
+*	Loads the mono hinted outline of the glyph, without rendering it, and
+*	compares its advance and pixel bounds with inGrayscale.  When true, the
+*	outline remains loaded in the glyph slot to be rendered.
+*/
+bool FontSession::MonoHintingDiffers(
+	FT_Face				inFace,
+	FT_UInt				inGlyphIndex,
+	const GlyphBitmap&	inGrayscale)
+{
+	bool	differs = false;
+	if (FT_Load_Glyph(inFace, inGlyphIndex, FT_LOAD_TARGET_MONO) == 0 &&
+		inFace->glyph->format == FT_GLYPH_FORMAT_OUTLINE)
+	{
+		FT_BBox	cbox;
+		FT_Outline_Get_CBox(&inFace->glyph->outline, &cbox);
+		FT_Pos	left = cbox.xMin >> 6;				// floor
+		FT_Pos	top = (cbox.yMax + 63) >> 6;		// ceiling
+		FT_Pos	right = (cbox.xMax + 63) >> 6;
+		FT_Pos	bottom = cbox.yMin >> 6;
+		differs = inFace->glyph->advance.x != inGrayscale.advanceX ||
+					left != inGrayscale.bitmapLeft ||
+					top != inGrayscale.bitmapTop ||
+					(right - left) != inGrayscale.width ||
+					(top - bottom) != inGrayscale.rows;
+	}
+	return(differs);
+}
+
+/***************************** CreateFaceCoverage *****************************/
+/*
+*	Assigns each charcode of inSubset to the first face that has a glyph for
+*	it, inFace followed by inFallbackFaces.  outCoverage[0] is inFace's
+*	charcodes, outCoverage[n] is inFallbackFaces[n-1]'s charcodes.  Charcodes
+*	that aren't in any face are returned in outMissing.
+*	Each face is only probed for the charcodes not in the faces before it.
+*/
+static void CreateFaceCoverage(
+	FT_Face						inFace,
+	const std::vector<FT_Face>&	inFallbackFaces,
+	const IndexVec&				inSubset,
+	std::vector<IndexVec>&		outCoverage,
+	IndexVec&					outMissing)
+{
+	outCoverage.assign(inFallbackFaces.size() + 1, IndexVec());
+	outMissing = inSubset;
+	for (size_t faceIndex = 0; faceIndex < outCoverage.size(); faceIndex++)
+	{
+		FT_Face	thisFace = faceIndex ? inFallbackFaces[faceIndex-1] : inFace;
+		IndexVec&	coverage = outCoverage[faceIndex];
+		IndexVecIterator	itr(&outMissing);
+		/*
+		*	The charcodes are visited in order, so the charcodes this face
+		*	has are accumulated as runs.
+		*/
+		size_t	runStart = IndexVecIterator::end;
+		size_t	runEnd = IndexVecIterator::end;
+		for (size_t charcode = itr.Current(); charcode != IndexVecIterator::end;
+												charcode = itr.Next())
+		{
+			if (FT_Get_Char_Index(thisFace, (FT_ULong)charcode) == 0)
+			{
+				continue;
+			}
+			if (charcode != runEnd)
+			{
+				if (runStart != IndexVecIterator::end)
+				{
+					coverage.SetRun((uint32_t)runStart, (uint32_t)runEnd, 1);
+				}
+				runStart = charcode;
+			}
+			runEnd = charcode + 1;
+		}
+		if (runStart != IndexVecIterator::end)
+		{
+			coverage.SetRun((uint32_t)runStart, (uint32_t)runEnd, 1);
+		}
+		outMissing.Diff(coverage);
+	}
+}
+
+/******************************* FaceForCharcode ******************************/
+/*
+*	Returns the index within inCoverage of the face assigned inCharcode by
+*	CreateFaceCoverage.  0 is the font, n is the nth fallback face.
+*	Charcodes that aren't in any face are assigned to the font (its missing
+*	glyph.)
+*/
+static size_t FaceForCharcode(
+	std::vector<IndexVec>&	inCoverage,
+	uint32_t				inCharcode)
+{
+	size_t	faceIndex = inCoverage.size() - 1;
+	for (; faceIndex > 0; faceIndex--)
+	{
+		if (inCoverage[faceIndex].Contains(inCharcode))
+		{
+			break;
+		}
+	}
+	return(faceIndex);
+}
+
+/***************************** AppendFaceCoverage *****************************/
+/*
+*	Appends the charcode ranges supplied by each face, and the charcodes not
+*	in any face, to outInfoStr.
+*/
+static void AppendFaceCoverage(
+	FT_Face						inFace,
+	const std::vector<FT_Face>&	inFallbackFaces,
+	const std::vector<IndexVec>&	inCoverage,
+	const IndexVec&				inMissing,
+	std::string&				outInfoStr)
+{
+	char	rangeBuff[32];
+	for (size_t faceIndex = 0; faceIndex <= inCoverage.size(); faceIndex++)
+	{
+		const IndexVec&	coverage = faceIndex < inCoverage.size() ? inCoverage[faceIndex] : inMissing;
+		if (faceIndex < inCoverage.size())
+		{
+			FT_Face	thisFace = faceIndex ? inFallbackFaces[faceIndex-1] : inFace;
+			outInfoStr.append(faceIndex ? "Fallback font " : "Font ");
+			outInfoStr.append(thisFace->family_name ? thisFace->family_name : "?");
+			if (thisFace->style_name)
+			{
+				outInfoStr.append(" ");
+				outInfoStr.append(thisFace->style_name);
+			}
+			outInfoStr.append(" supplied:");
+		} else
+		{
+			outInfoStr.append("Not in any font:");
+		}
+		Runs::const_iterator	itr = coverage.GetRuns().begin();
+		Runs::const_iterator	itrEnd = coverage.GetRuns().end();
+		if (coverage.GetFirstRunValue() == 0)
+		{
+			++itr;
+		}
+		if (itr == itrEnd)
+		{
+			outInfoStr.append(" none");
+		}
+		while (itr != itrEnd)
+		{
+			uint32_t	start = *(itr++);
+			uint32_t	end = *(itr++) -1;
+			outInfoStr.append(rangeBuff, start == end ?
+				snprintf(rangeBuff, sizeof(rangeBuff), " %04X", start) :
+				snprintf(rangeBuff, sizeof(rangeBuff), " %04X-%04X", start, end));
+		}
+		outInfoStr.append("\n");
+	}
+}
+
 /******************************* CreateXfntFile *******************************/
 int SubsetFontCreator::CreateXfntFile(
 	const char*				inFontFilePath,
@@ -317,11 +927,13 @@ int SubsetFontCreator::CreateXfntFile(
 	int						inOptions,
 	SubsetCharcodeIterator&	inCharcodeItr,
 	long					inFontFaceIndex,
-	const char*				inSupplementalFontFilePath,
-	long					inSupplementalFontFaceIndex,
+	const FallbackFaces&	inFallbackFaces,
 	std::string*			outErrorStr,
 	std::string*			outWarningStr,
-	std::string*			outInfoStr)
+	std::string*			outInfoStr,
+	const GlyphUsageProfile*	inUsageProfile,
+	FontSession*			inSession,
+	const StaticStrings*	inStaticStrings)
 {
 	int	createFileError = eSubsetNoErr;
 	bool	success = inCharcodeItr.IsValid();
@@ -332,16 +944,48 @@ int SubsetFontCreator::CreateXfntFile(
 		bool	horizontal = (inOptions & eHorizontal) != 0;
 		bool	oneBitPerPixel = (inOptions & e1BitPerPixel) != 0;
 		bool	wideOffsets = (inOptions & e32BitDataOffsets) != 0;
+		bool	segmentedOffsets = !wideOffsets && (inOptions & eSegmentedDataOffsets) != 0;
+		bool	offsets32 = wideOffsets || segmentedOffsets;	// While being created
 		bool	minimizeHeight = (inOptions & eMinimizeHeight) != 0;
-		GlyphHeader	xGlyphHeader;
+		uint32_t	pageSize = (inOptions & ePageAlignMask) ? (16 << ((inOptions & ePageAlignMask) >> 6)) : 0;
+		/*
+		*	Only ePageAlign32 to ePageAlign256 are defined.
+		*/
+		if (pageSize > 256)
+		{
+			pageSize = 0;
+			if (outWarningStr)
+			{
+				outWarningStr->append("Unsupported page alignment, ignored.\n");
+			}
+		}
+		/*
+		*	The glyph offsets are relative to the start of the glyph data.
+		*	Page alignment only lines up with the EEPROM pages when the glyph
+		*	data starts on a page boundary, which can only be arranged when
+		*	the glyph data is stored separately.
+		*/
+		if (pageSize &&
+			(inOptions & eGlyphDataSeparately) == 0)
+		{
+			pageSize = 0;
+			if (outWarningStr)
+			{
+				outWarningStr->append("Page alignment requires the glyph data to be stored separately, ignored.\n");
+			}
+		}
+		bool	accumulateEntries = pageSize || (inUsageProfile && !inUsageProfile->IsEmpty());
+		bool	metrics16 = (inOptions & e16BitMetrics) != 0;
+		bool	kerningPairs = (inOptions & eKerningPairs) != 0;
+		bool	adaptiveEncoding = (inOptions & eAdaptiveEncoding) != 0;
+		GlyphHeader16	xGlyphHeader;
 		
 		if (minimizeHeight)
 		{
-			FontHeader			xFontHeader;
+			FontHeader16		xFontHeader;
 			int errorCode = PreviewFont(inFontFilePath, inPointSize, inOptions,
-								inCharcodeItr, inFontFaceIndex, inSupplementalFontFilePath,
-								inSupplementalFontFaceIndex, xFontHeader, xGlyphHeader,
-								outErrorStr);
+								inCharcodeItr, inFontFaceIndex, inFallbackFaces,
+								xFontHeader, xGlyphHeader, outErrorStr, inSession);
 			if (errorCode)
 			{
 				minimizeHeight = false;
@@ -362,46 +1006,40 @@ int SubsetFontCreator::CreateXfntFile(
 			}*/
 		}
 		
-		std::string utf8FontPath(inFontFilePath);
-		std::string utf8SupplementalFontPath(inSupplementalFontFilePath);
 		if (inExportFile && inGlyphDataExportFile)
 		{
-			std::vector<std::string>	faceNameVec;
-			GetFaceNames(utf8FontPath.c_str(), faceNameVec);
-			
-			FT_Library ftLibrary = NULL;
-			if (FT_Init_FreeType(&ftLibrary) == 0)
+			/*
+			*	Unless passed a session, the font is opened just for this
+			*	size.
+			*/
+			FontSession*	localSession = inSession ? NULL :
+								new FontSession(inFontFilePath, inFontFaceIndex,
+												inFallbackFaces, outWarningStr);
+			FontSession*	session = inSession ? inSession : localSession;
+			if (session->library)
 			{
-				FT_Face	face = NULL;
-				FT_Face	supplementalFace = NULL;
-				if (inSupplementalFontFilePath)
-				{
-					FT_New_Face(ftLibrary, utf8SupplementalFontPath.c_str(), inSupplementalFontFaceIndex, &supplementalFace);
-					if (FT_Set_Char_Size(
-								supplementalFace,	/* handle to face object           */
-								0,		/* char_width in 1/64th of points  */
-								inPointSize*64,	/* char_height in 1/64th of points */
-								72,		/* horizontal device resolution    */
-								72))
-					{
-						supplementalFace = NULL;
-					}
-				}
-				bool success = FT_New_Face(ftLibrary, utf8FontPath.c_str(), inFontFaceIndex, &face) == 0;
-				if (success)
+				FT_Face	face = session->face;
+				if (face)
 				{
-					
-					FT_Error error = FT_Set_Char_Size(
-								face,	/* handle to face object           */
-								0,		/* char_width in 1/64th of points  */
-								inPointSize*64,	/* char_height in 1/64th of points */
-								72,		/* horizontal device resolution    */
-								72);	/* vertical device resolution      */
+					FT_Error error = session->SetCharSize(inPointSize, outWarningStr);
+					std::vector<FT_Face>&	fallbackFaces = session->fallbackFaces;
 					
 					uint32_t	numCharCodes = inCharcodeItr.GetNumCharCodes();
 					FT_Face	charCodeFace = NULL;
-					FontHeader fontHeader;
-					fontHeader.version = 1;
+					/*
+					*	The face of every charcode is determined before any
+					*	glyphs are rendered (see CreateFaceCoverage.)
+					*/
+					std::vector<IndexVec>	faceCoverage;
+					IndexVec	missingCharcodes;
+					CreateFaceCoverage(face, fallbackFaces, inCharcodeItr.GetIndexVec(),
+										faceCoverage, missingCharcodes);
+					/*
+					*	The header and glyph headers are created 16 bit and
+					*	narrowed when written unless metrics16.
+					*/
+					FontHeader16 fontHeader;
+					fontHeader.flags = 0;
 					//fontHeader.wideOffsets = wideOffsets ? 1:0;
 					fontHeader.horizontal = (rotated && horizontal) ? 1:0;
 					fontHeader.oneBit = oneBitPerPixel ? 1:0;
@@ -421,60 +1059,74 @@ int SubsetFontCreator::CreateXfntFile(
 						fontHeader.descent = fontHeader.ascent - actualFontHeight;
 					}
 					fontHeader.height = actualFontHeight;
-					fontHeader.numCharcodeRuns = inCharcodeItr.GetNumRuns() +1;
+					/*
+					*	Use 16 bit metrics when the font metrics don't fit in
+					*	8 bits.  If only a glyph's metrics don't fit,
+					*	eMetricsTooLargeErr is returned and CreateFile starts
+					*	over with e16BitMetrics.
+					*/
+					if (actualFontHeight > 255 ||
+						fontHeader.ascent > 255 ||
+						fontHeader.descent < -128 ||
+						face->size->metrics.max_advance/64 > 255)
+					{
+						metrics16 = true;
+					}
+					std::vector<CharcodeRun>	charcodeRuns;
+					std::vector<CharcodePlane>	charcodePlanes;
+					fontHeader.version = CreateCharcodeRuns(inCharcodeItr.GetIndexVec(),
+											charcodeRuns, charcodePlanes, metrics16);
+					if (metrics16)
+					{
+						fontHeader.version = 3;	// Always has CharcodePlanes
+					}
+					size_t	fontHeaderSize = metrics16 ? sizeof(FontHeader16) : sizeof(FontHeader);
+					size_t	glyphHeaderSize = metrics16 ? sizeof(GlyphHeader16) : sizeof(GlyphHeader);
+					numCharCodes = charcodeRuns.back().entryIndex;
+					fontHeader.numCharcodeRuns = (uint16_t)charcodeRuns.size();
 					fontHeader.numCharCodes = numCharCodes;
 					FT_ULong	maxCharCode = 0;
 					uint32_t	maxEntrySize = 0;
 					size_t glyphDataOffsetsSize = (numCharCodes + 1) * (wideOffsets ? sizeof(uint32_t) : sizeof(uint16_t));
-					uint32_t*	glyphDataOffsets = new uint32_t[numCharCodes+1];
+					uint32_t	numSegments = segmentedOffsets ? (numCharCodes + 256)/256 : 0;
+					glyphDataOffsetsSize += numSegments * sizeof(uint32_t);
+					uint32_t*	glyphDataOffsets = new uint32_t[numCharCodes+1+numSegments];
 					uint32_t*	glyphDataOffsets32Ptr = glyphDataOffsets;
 					uint16_t*	glyphDataOffsets16Ptr = (uint16_t*)glyphDataOffsets;
-					uint8_t		widestGlyph = 0;
-					uint8_t		tallestGlyph = 0;
-					uint8_t		minGlyphY = 255;
+					uint16_t	widestGlyph = 0;
+					uint16_t	tallestGlyph = 0;
+					int16_t		minGlyphY = 0x7FFF;
 					uint8_t		isMonospaced = 1;
 					bool		containsKerning = false;
+					uint32_t	numRawGlyphs = 0;
+					/*
+					*	When page aligning or ordering by usage, the glyph
+					*	entries are accumulated in entryData rather than being
+					*	written as they're created.  entryOffsets are the
+					*	offsets of each entry within entryData.
+					*/
+					std::vector<uint8_t>	entryData;
+					std::vector<uint32_t>	entryOffsets;
+					std::vector<uint32_t>	entryCharcodes;
+					/*
+					*	For kerning, the face glyph index of each entry, 0 if
+					*	the glyph is from a fallback face.
+					*/
+					std::vector<FT_UInt>	entryGlyphIndexes;
 					// Reserve space for the header
-					fseek(inExportFile, sizeof(FontHeader), SEEK_CUR);
-					size_t charcodeRunsSize;
+					fseek(inExportFile, fontHeaderSize, SEEK_CUR);
 					/*
-					*	Create and write the CharcodeRuns array.
+					*	Write the CharcodeRuns array followed by the
+					*	CharcodePlanes array, if any (version 2 and 3.)
+					*	charcodeRunsSize includes the CharcodePlanes array.
 					*/
+					size_t charcodeRunsSize = sizeof(CharcodeRun) * charcodeRuns.size();
+					fwrite(charcodeRuns.data(), charcodeRunsSize, 1, inExportFile);
+					if (charcodePlanes.size())
 					{
-						const IndexVec&	indexVec = inCharcodeItr.GetIndexVec();
-						const Runs&	charCodeRuns = indexVec.GetRuns();
-						// The size of the charCodeRuns array is either odd or even.
-						// Either way dividing by 2 gives you the number of runs.
-						// (see IndexVec.h for more info)
-						size_t	numRuns = (charCodeRuns.size()/2) + 1;  // +1 accounts for the null last run used for sanity checking (see header).
-						CharcodeRun*	charcodeRuns = new CharcodeRun[numRuns];
-						CharcodeRun*	charcodeRunsPtr = charcodeRuns;
-					
-						{
-							uint16_t	entryIndex = 0;
-							Runs::const_iterator	itr = charCodeRuns.begin();
-							Runs::const_iterator	itrEnd = charCodeRuns.end();
-
-							if (indexVec.GetFirstRunValue() == 0)
-							{
-								++itr;
-							}
-							
-							for (; itr != itrEnd; ++itr)
-							{
-								charcodeRunsPtr->start = *itr;
-								++itr;
-								charcodeRunsPtr->entryIndex = entryIndex;
-								entryIndex += (*itr - charcodeRunsPtr->start);
-								charcodeRunsPtr++;
-							}
-							// Add the null last run used for sanity checking (see header).
-							charcodeRunsPtr->start = 0xFFFF;
-							charcodeRunsPtr->entryIndex = entryIndex;
-						}
-						charcodeRunsSize = sizeof(CharcodeRun) * numRuns;
-						fwrite(charcodeRuns, charcodeRunsSize, 1, inExportFile);
-						delete [] charcodeRuns;
+						size_t	charcodePlanesSize = sizeof(CharcodePlane) * charcodePlanes.size();
+						fwrite(charcodePlanes.data(), charcodePlanesSize, 1, inExportFile);
+						charcodeRunsSize += charcodePlanesSize;
 					}
 					// Reserve space for the glyph data offsets
 					fseek(inExportFile, glyphDataOffsetsSize, SEEK_CUR);
@@ -482,38 +1134,32 @@ int SubsetFontCreator::CreateXfntFile(
 
 					if (error == 0)
 					{
-						GlyphHeader	glyphHdr;
+						GlyphHeader16	glyphHdr;
+						GlyphHeader		glyphHdr8;
+						const uint8_t*	glyphHdrPtr = metrics16 ? (const uint8_t*)&glyphHdr : (const uint8_t*)&glyphHdr8;
 						FT_ULong	charcode;
-						FT_Int32	loadFlags = FT_LOAD_RENDER;
-						if (oneBitPerPixel)
-						{
-							loadFlags |= FT_LOAD_TARGET_MONO;
-						}	// else grayscale
+						GlyphBitmap	bitmap;
 						charcode = inCharcodeItr.Current();
 						while (inCharcodeItr.IsValid() &&
 							createFileError == eSubsetNoErr)
 						{
-							if (charcode > 0 && charcode < 0xFFFF)
+							if (charcode > 0 && (charcode & 0xFFFF) != 0xFFFF)
 							{
-								FT_UInt	glyphIndex = FT_Get_Char_Index(face, charcode);
-								if (glyphIndex ||
-									supplementalFace == NULL)
-								{
-									error = FT_Load_Glyph(face, glyphIndex, loadFlags);
-									charCodeFace = face;
-								} else
-								{
-									error = FT_Load_Char(supplementalFace, charcode, loadFlags);
-									charCodeFace = supplementalFace;
-								}
-								if (error == 0)
+								size_t	faceIndex = FaceForCharcode(faceCoverage, (uint32_t)charcode);
+								charCodeFace = faceIndex ? fallbackFaces[faceIndex-1] : face;
+								FT_UInt	glyphIndex = FT_Get_Char_Index(charCodeFace, charcode);
+								error = session->LoadGlyph(charCodeFace, glyphIndex,
+											(uint32_t)charcode, oneBitPerPixel, bitmap);
+								if (error == 0)
 								{
 									if (maxCharCode < charcode)
 									{
 										maxCharCode = charcode;
 									}
-									FT_GlyphSlot	slot = charCodeFace->glyph;
-									FT_Bitmap&		bitmap = slot->bitmap;
+									if (kerningPairs)
+									{
+										entryGlyphIndexes.push_back(faceIndex ? 0 : glyphIndex);
+									}
 									int32_t			rows = bitmap.rows;
 									int32_t			width = 0;
 									int32_t			linePadding = 0;
@@ -526,7 +1172,7 @@ int SubsetFontCreator::CreateXfntFile(
 										{
 											size_t	rotatedDataLen;
 											// Rotated data is created with MSB bottom for use by SSD1306 and PCD8544 controllers.
-											glyphData = CreateRotatedData(bufferPtr, rows, bitmap.width, ascent - slot->bitmap_top, false, horizontal, rotatedDataLen);
+											glyphData = CreateRotatedData(bufferPtr, rows, bitmap.width, ascent - bitmap.bitmapTop, false, horizontal, rotatedDataLen);
 											if (glyphData)
 											{
 												glyphDataPtr = &glyphData[rotatedDataLen];
@@ -553,10 +1199,10 @@ int SubsetFontCreator::CreateXfntFile(
 										glyphData = new uint8_t[glyphDataMaxSize];	// worst case size.
 										glyphDataPtr = glyphData;
 									}
-									uint8_t		advanceX = slot->advance.x/64;
+									uint16_t	advanceX = bitmap.advanceX/64;
 									glyphHdr.advanceX = advanceX;
-									glyphHdr.x = slot->bitmap_left;
-									glyphHdr.y = ascent - slot->bitmap_top;
+									glyphHdr.x = bitmap.bitmapLeft;
+									glyphHdr.y = ascent - bitmap.bitmapTop;
 									if (minimizeHeight)
 									{
 										glyphHdr.y -= xGlyphHeader.y;
@@ -593,8 +1239,36 @@ int SubsetFontCreator::CreateXfntFile(
 											widestGlyph = advanceX;
 										}
 									}
+									if (!metrics16)
+									{
+										if (glyphHdr.advanceX > 255 ||
+											glyphHdr.x < -128 || glyphHdr.x > 127 ||
+											glyphHdr.y < -128 || glyphHdr.y > 127 ||
+											glyphHdr.rows > 255 ||
+											glyphHdr.columns > 255)
+										{
+											createFileError = eMetricsTooLargeErr;
+											if (outErrorStr)
+											{
+												outErrorStr->assign("Glyph metrics too large - needs 16 bit metrics.");
+											}
+										}
+										glyphHdr8.advanceX = (uint8_t)glyphHdr.advanceX;
+										glyphHdr8.x = (int8_t)glyphHdr.x;
+										glyphHdr8.y = (int8_t)glyphHdr.y;
+										glyphHdr8.rows = (uint8_t)glyphHdr.rows;
+										glyphHdr8.columns = (uint8_t)glyphHdr.columns;
+									}
 									// Write the glyph header (but don't increment glyphDataOffset till after the runs are written)
-									fwrite(&glyphHdr, sizeof(GlyphHeader), 1, inGlyphDataExportFile);
+									if (accumulateEntries)
+									{
+										entryOffsets.push_back(glyphDataOffset);
+										entryCharcodes.push_back((uint32_t)charcode);
+										entryData.insert(entryData.end(), glyphHdrPtr, &glyphHdrPtr[glyphHeaderSize]);
+									} else
+									{
+										fwrite(glyphHdrPtr, glyphHeaderSize, 1, inGlyphDataExportFile);
+									}
 									
 									if (rows)
 									{
@@ -727,129 +1401,51 @@ int SubsetFontCreator::CreateXfntFile(
 												}
 											}
 										/*
-										*	Else run length encode.  Runs of the same value have a positve run length
+										*	Else run length encode.  Runs of the same value have a positive run length
 										*	between 3 and 127.  Runs of unique values have a negative run length between
 										*	-1 and -128.
 										*/
 										} else
 										{
-											uint8_t		pixel;
-											uint8_t		runPixel;
-											int32_t		runLen;
-											int32_t		uniqueRunLen;
-											uint8_t*	runLenPtr;
-											//for (int row = 0; row < rows; row++)	<< uncomment if the runs need to break at the end of each row
+											glyphDataPtr = &glyphData[RunLengthEncode(bufferPtr, rows * width, glyphData)];
+											if (glyphDataPtr == glyphData)
 											{
-												runPixel = *(bufferPtr++);
-												runLen = 1;
-												uniqueRunLen = 1;
-												runLenPtr = glyphDataPtr;
-												glyphDataPtr++;
-												*(glyphDataPtr++) = runPixel;
-												int		dataLen = rows * width;
-												for (int dataIndex = 1; dataIndex < dataLen; dataIndex++)
-												//for (int col = 1; col < width; col++)	<< uncomment if the runs need to break at the end of each row
+												createFileError = eUnexpectedEndOfRunErr;
+												if (outErrorStr)
 												{
-													pixel = *(bufferPtr++);
-													if (runPixel == pixel)
-													{
-														runLen++;
-														switch(runLen)
-														{
-															/*
-															*	Until the runLen is 3 it can still be treated as
-															*	a run of unique pixels, so keep appending and counting pixels.
-															*/
-															case 2:
-																*(glyphDataPtr++) = runPixel;
-																uniqueRunLen++;
-																break;
-															/*
-															*	Once the runLen is 3 the unique run is terminated, if any.
-															*/
-															case 3:
-																uniqueRunLen++;
-																if (uniqueRunLen > runLen)
-																{
-																	uniqueRunLen -= runLen;
-																	*runLenPtr = -uniqueRunLen; // write a negative value
-																	runLenPtr += (uniqueRunLen +1);
-																	uniqueRunLen = 0;	// not needed, for debugging.
-																}
-																break;
-															/*
-															*	The maximum length of a run is 127.  Start a new run at 128
-															*/
-															case 128:
-																*runLenPtr = 127;
-																runLenPtr += 2;
-																glyphDataPtr = runLenPtr + 1;
-																*(glyphDataPtr++) = runPixel;
-																runLen = 1;
-																uniqueRunLen = 1;
-																break;
-															default:
-																break;
-														}
-													/*
-													*	Else the run just ended.
-													*	If the runLen is more than 2 THEN
-													*	record the run length and start a new run.
-													*/
-													} else
-													{
-														if (runLen > 2)
-														{
-															*runLenPtr = runLen;
-															runLenPtr += 2;
-															glyphDataPtr = runLenPtr + 1;
-															runLen = 1;
-															uniqueRunLen = 1;
-														} else
-														{
-															runLen = 1;
-															if (uniqueRunLen != 128)
-															{
-																uniqueRunLen++;
-															} else
-															{
-																*runLenPtr = -128;
-																runLenPtr = glyphDataPtr;
-																glyphDataPtr++;
-																uniqueRunLen = 1;
-															}
-														}
-														*(glyphDataPtr++) = pixel;
-														runPixel = pixel;
-													}
-												}
-												if (runLen > 2)
-												{
-													*runLenPtr = runLen;
-													glyphDataPtr = runLenPtr + 2;
-													*glyphDataPtr = 0xFF;
-												} else if (uniqueRunLen)
-												{
-													*runLenPtr = -uniqueRunLen;
-												} else
-												{
-													createFileError = eUnexpectedEndOfRunErr;
-													if (outErrorStr)
-													{
-														outErrorStr->assign("Unexpected end of run");
-													}
+													outErrorStr->assign("Unexpected end of run");
 												}
-												
-												if (linePadding)
+											}
+											/*
+											*	If adaptive encoding and the runs aren't smaller
+											*	than the raw pixels THEN store the glyph raw, a
+											*	zero run length followed by the pixels.
+											*/
+											if (adaptiveEncoding &&
+												(glyphDataPtr - glyphData) >= (1 + rows * width))
+											{
+												bufferPtr = bitmap.buffer;
+												glyphDataPtr = glyphData;
+												*(glyphDataPtr++) = 0;
+												for (int row = 0; row < rows; row++)
 												{
-													bufferPtr += linePadding;
+													memcpy(glyphDataPtr, bufferPtr, width);
+													bufferPtr += bitmap.pitch;
+													glyphDataPtr += width;
 												}
+												numRawGlyphs++;
 											}
 										}
 									}
 									uint32_t bytesWritten = (uint32_t)(glyphDataPtr - glyphData);
-									fwrite(glyphData, bytesWritten, 1, inGlyphDataExportFile);
-									if (wideOffsets)
+									if (accumulateEntries)
+									{
+										entryData.insert(entryData.end(), glyphData, glyphDataPtr);
+									} else
+									{
+										fwrite(glyphData, bytesWritten, 1, inGlyphDataExportFile);
+									}
+									if (offsets32)
 									{
 										*(glyphDataOffsets32Ptr++) = glyphDataOffset;
 									} else if (glyphDataOffset < 0x10000)
@@ -860,11 +1456,11 @@ int SubsetFontCreator::CreateXfntFile(
 										createFileError = eDataOffsetTooLargeErr;
 										if (outErrorStr)
 										{
-											outErrorStr->assign("Data offset too wide - needs 32 bit.");
+											outErrorStr->assign("Data offset too wide - needs segmented offsets.");
 										}
 									}
 									{
-										uint32_t thisEntrySize = bytesWritten + sizeof(GlyphHeader);
+										uint32_t thisEntrySize = bytesWritten + (uint32_t)glyphHeaderSize;
 										glyphDataOffset += thisEntrySize;
 										if (thisEntrySize > maxEntrySize)
 										{
@@ -887,7 +1483,7 @@ int SubsetFontCreator::CreateXfntFile(
 							}
 							charcode = inCharcodeItr.Next();
 						}
-						if (wideOffsets)
+						if (offsets32)
 						{
 							*glyphDataOffsets32Ptr = glyphDataOffset;	// offset of the end of all glyph data
 						} else if (glyphDataOffset < 0x10000)
@@ -898,9 +1494,205 @@ int SubsetFontCreator::CreateXfntFile(
 							createFileError = eDataOffsetTooLargeErr;
 							if (outErrorStr)
 							{
-								outErrorStr->assign("Data offset too wide - needs 32 bit.");
+								outErrorStr->assign("Data offset too wide - needs segmented offsets.");
 							}
 						}
+						/*
+						*	If page aligning or ordering by usage THEN
+						*	layout the accumulated glyph entries, write them
+						*	with any padding, and replace the glyph data offsets.
+						*/
+						if (accumulateEntries &&
+							createFileError == eSubsetNoErr)
+						{
+							std::vector<uint32_t>	alignedOffsets;
+							std::vector<uint32_t>	entryOrder;
+							uint32_t	numEntries = (uint32_t)entryOffsets.size();
+							/*
+							*	The preferred order is charcode order unless
+							*	there's a usage profile, in which case the most
+							*	used glyphs are placed first.  Glyphs with equal
+							*	usage (including unused) remain in charcode
+							*	order.
+							*/
+							std::vector<uint32_t>	preferredOrder(numEntries);
+							uint32_t	usedEntries = 0;
+							for (uint32_t i = 0; i < numEntries; i++)
+							{
+								preferredOrder[i] = i;
+							}
+							if (inUsageProfile)
+							{
+								std::vector<uint32_t>	usage(numEntries);
+								for (uint32_t i = 0; i < numEntries; i++)
+								{
+									usage[i] = inUsageProfile->GetCount(entryCharcodes[i]);
+									if (usage[i])
+									{
+										usedEntries++;
+									}
+								}
+								std::stable_sort(preferredOrder.begin(), preferredOrder.end(),
+									[&usage](uint32_t inA, uint32_t inB)
+									{
+										return(usage[inA] > usage[inB]);
+									});
+							}
+							uint32_t	alignedDataLen = LayoutGlyphEntries(
+											entryOffsets.data(), numEntries,
+											glyphDataOffset, pageSize,
+											preferredOrder, alignedOffsets, entryOrder);
+							uint32_t	usedDataLen = 0;
+							uint32_t	transactionsBefore = 0;
+							uint32_t	transactionsAfter = 0;
+							uint32_t	maxTransactionsBefore = 0;
+							uint32_t	maxTransactionsAfter = 0;
+							uint32_t	offset = 0;
+							const uint8_t	padding[256] = {0};
+							std::vector<uint32_t>::const_iterator	itr = entryOrder.begin();
+							std::vector<uint32_t>::const_iterator	itrEnd = entryOrder.end();
+							for (; itr != itrEnd; ++itr)
+							{
+								uint32_t	entryIndex = *itr;
+								uint32_t	entrySize = (entryIndex+1 < numEntries ?
+												entryOffsets[entryIndex+1] : glyphDataOffset) - entryOffsets[entryIndex];
+								/*
+								*	A gap is less than a page.  It's written in
+								*	chunks so that the size of the padding
+								*	array doesn't limit the page size.
+								*/
+								for (uint32_t padLen = alignedOffsets[entryIndex] - offset; padLen;)
+								{
+									uint32_t	chunkLen = padLen < sizeof(padding) ? padLen : sizeof(padding);
+									fwrite(padding, chunkLen, 1, inGlyphDataExportFile);
+									padLen -= chunkLen;
+								}
+								fwrite(&entryData[entryOffsets[entryIndex]], entrySize, 1, inGlyphDataExportFile);
+								offset = alignedOffsets[entryIndex] + entrySize;
+								if (usedEntries &&
+									inUsageProfile->GetCount(entryCharcodes[entryIndex]))
+								{
+									usedDataLen = offset;
+								}
+								if (offsets32)
+								{
+									glyphDataOffsets[entryIndex] = alignedOffsets[entryIndex];
+								} else
+								{
+									((uint16_t*)glyphDataOffsets)[entryIndex] = (uint16_t)alignedOffsets[entryIndex];
+								}
+								if (pageSize == 0)
+								{
+									continue;
+								}
+								uint32_t	transactions = BusTransactionsForGlyph(entryOffsets[entryIndex], entrySize, pageSize);
+								transactionsBefore += transactions;
+								if (maxTransactionsBefore < transactions)
+								{
+									maxTransactionsBefore = transactions;
+								}
+								transactions = BusTransactionsForGlyph(alignedOffsets[entryIndex], entrySize, pageSize);
+								transactionsAfter += transactions;
+								if (maxTransactionsAfter < transactions)
+								{
+									maxTransactionsAfter = transactions;
+								}
+							}
+							if (offsets32)
+							{
+								glyphDataOffsets[numEntries] = alignedDataLen;
+							} else if (alignedDataLen < 0x10000)
+							{
+								((uint16_t*)glyphDataOffsets)[numEntries] = (uint16_t)alignedDataLen;
+							} else
+							{
+								createFileError = eDataOffsetTooLargeErr;
+								if (outErrorStr)
+								{
+									outErrorStr->assign("Data offset too wide after page alignment - needs segmented offsets.");
+								}
+							}
+							if (outInfoStr &&
+								usedEntries)
+							{
+								char infoBuff[256];
+								outInfoStr->append(infoBuff, snprintf(infoBuff, 256,
+									"\nUsage profile glyphs = %d of %d\n"
+									"Usage profile glyph data = first %d bytes\n",
+									usedEntries, numEntries, usedDataLen));
+							}
+							if (outInfoStr &&
+								pageSize &&
+								numEntries)
+							{
+								char infoBuff[512];
+								outInfoStr->append(infoBuff, snprintf(infoBuff, 512,
+									"\nPage size = %d\n"
+									"Page alignment padding = %d bytes\n"
+									"Bus transactions per glyph, before alignment: avg %.2f, max %d\n"
+									"Bus transactions per glyph, after alignment: avg %.2f, max %d\n"
+									"The glyph data must be written at a page aligned EEPROM address.\n",
+									pageSize,
+									alignedDataLen - glyphDataOffset,
+									(double)transactionsBefore/numEntries, maxTransactionsBefore,
+									(double)transactionsAfter/numEntries, maxTransactionsAfter));
+							}
+							glyphDataOffset = alignedDataLen;
+						}
+						/*
+						*	If segmented THEN
+						*	replace the 32 bit offsets with 16 bit offsets
+						*	relative to the base of each 256 entry segment,
+						*	followed by the segment bases.  The base of a
+						*	segment is the lowest offset within the segment.
+						*/
+						if (segmentedOffsets &&
+							createFileError == eSubsetNoErr)
+						{
+							uint16_t*	localOffsets = (uint16_t*)glyphDataOffsets;
+							uint32_t*	segmentBases = new uint32_t[numSegments];
+							for (uint32_t segment = 0; segment < numSegments; segment++)
+							{
+								uint32_t	entryIndex = segment * 256;
+								uint32_t	entryEnd = entryIndex + 256;
+								if (entryEnd > numCharCodes + 1)
+								{
+									entryEnd = numCharCodes + 1;
+								}
+								uint32_t	base = glyphDataOffsets[entryIndex];
+								for (uint32_t i = entryIndex+1; i < entryEnd; i++)
+								{
+									if (base > glyphDataOffsets[i])
+									{
+										base = glyphDataOffsets[i];
+									}
+								}
+								segmentBases[segment] = base;
+								/*
+								*	The 16 bit offsets overwrite the 32 bit
+								*	offsets as they're converted.  Because the
+								*	16 bit offsets are half the size, this never
+								*	overwrites an unconverted 32 bit offset.
+								*/
+								for (; entryIndex < entryEnd; entryIndex++)
+								{
+									uint32_t	localOffset = glyphDataOffsets[entryIndex] - base;
+									if (localOffset < 0x10000)
+									{
+										localOffsets[entryIndex] = (uint16_t)localOffset;
+									} else
+									{
+										createFileError = eDataOffsetTooLargeErr;
+										if (outErrorStr)
+										{
+											outErrorStr->assign("Glyph data within a 256 glyph segment exceeds 64KB - needs 32 bit.");
+										}
+									}
+								}
+							}
+							memcpy(&localOffsets[numCharCodes+1], segmentBases, numSegments * sizeof(uint32_t));
+							delete [] segmentBases;
+						}
 					} else
 					{
 						createFileError = eFTSetCharSizeFailedErr;
@@ -914,11 +1706,219 @@ int SubsetFontCreator::CreateXfntFile(
 					fseek(inExportFile, 0, SEEK_SET);
 					fontHeader.width = widestGlyph;	// Used to simulate monospace on non-monospace fonts
 					fontHeader.monospaced = isMonospaced;	// Entire subset has same width+advanceX
-					fwrite(&fontHeader, sizeof(FontHeader), 1, inExportFile);
+					if (numRawGlyphs)
+					{
+						fontHeader.flags |= eRawGlyphsFlag;
+					}
+					if (kerningPairs)
+					{
+						fontHeader.flags |= eKerningPairsFlag;
+					}
+					if (inStaticStrings &&
+						inStaticStrings->size())
+					{
+						fontHeader.flags |= eStaticStringsFlag;
+					}
+					if (segmentedOffsets)
+					{
+						fontHeader.flags |= eSegmentedOffsetsFlag;
+					} else if (wideOffsets)
+					{
+						fontHeader.flags |= e32BitOffsetsFlag;
+					}
+					if (metrics16)
+					{
+						fwrite(&fontHeader, sizeof(FontHeader16), 1, inExportFile);
+					} else
+					{
+						/*
+						*	The flags are stored in the FontHeader's padding
+						*	byte (see XFontGlyph.h)
+						*/
+						uint8_t		fontHeaderBuf[sizeof(FontHeader)];
+						FontHeader	fontHeader8;
+						memset(&fontHeader8, 0, sizeof(FontHeader));
+						fontHeader8.version = fontHeader.version;
+						fontHeader8.oneBit = fontHeader.oneBit;
+						fontHeader8.rotated = fontHeader.rotated;
+						fontHeader8.horizontal = fontHeader.horizontal;
+						fontHeader8.monospaced = fontHeader.monospaced;
+						fontHeader8.ascent = (uint8_t)fontHeader.ascent;
+						fontHeader8.descent = (int8_t)fontHeader.descent;
+						fontHeader8.height = (uint8_t)fontHeader.height;
+						fontHeader8.width = (uint8_t)fontHeader.width;
+						fontHeader8.numCharcodeRuns = fontHeader.numCharcodeRuns;
+						fontHeader8.numCharCodes = fontHeader.numCharCodes;
+						memcpy(fontHeaderBuf, &fontHeader8, sizeof(FontHeader));
+						fontHeaderBuf[kFontHeaderFlagsOffset] = fontHeader.flags;
+						fwrite(fontHeaderBuf, sizeof(FontHeader), 1, inExportFile);
+					}
 					// Write the glyph data offsets
-					fseek(inExportFile, sizeof(FontHeader)+charcodeRunsSize, SEEK_SET);
+					fseek(inExportFile, fontHeaderSize+charcodeRunsSize, SEEK_SET);
 					fwrite(glyphDataOffsets, glyphDataOffsetsSize, 1, inExportFile);
 					fseek(inExportFile, 0, SEEK_END);
+					uint32_t	numKerningPairs = 0;
+					if (kerningPairs &&
+						createFileError == eSubsetNoErr)
+					{
+						/*
+						*	The kerning arrays follow the glyph data, or the
+						*	offsets when the glyph data is stored separately.
+						*/
+						if (inGlyphDataExportFile == inExportFile)
+						{
+							fseek(inExportFile, fontHeaderSize + charcodeRunsSize +
+									glyphDataOffsetsSize + glyphDataOffset, SEEK_SET);
+						}
+						numKerningPairs = WriteKerningPairs(face, entryGlyphIndexes,
+											inExportFile, outWarningStr);
+					}
+					/*
+					*	Each static string is written as a glyph entry following
+					*	the glyph data, and the kerning arrays when they're in
+					*	the same file.  The offset of each entry within the
+					*	glyph data, plus the offset of the end, followed by the
+					*	uint16_t number of strings, are appended to the export
+					*	file.
+					*/
+					uint32_t	numStaticStrings = 0;
+					uint32_t	staticStringsLen = 0;
+					if (inStaticStrings &&
+						inStaticStrings->size() &&
+						createFileError == eSubsetNoErr)
+					{
+						uint32_t	glyphDataStart = 0;
+						uint32_t	staticStringOffset = glyphDataOffset;
+						if (inGlyphDataExportFile == inExportFile)
+						{
+							glyphDataStart = (uint32_t)(fontHeaderSize + charcodeRunsSize + glyphDataOffsetsSize);
+							if (kerningPairs)
+							{
+								staticStringOffset = (uint32_t)ftell(inExportFile) - glyphDataStart;
+							}
+						}
+						fseek(inGlyphDataExportFile, glyphDataStart + staticStringOffset, SEEK_SET);
+						std::vector<uint32_t>	staticStringOffsets;
+						std::vector<uint8_t>	pixels;
+						int32_t		top = ascent - (minimizeHeight ? xGlyphHeader.y : 0);
+						int32_t		height = (int32_t)actualFontHeight;
+						GlyphHeader16	glyphHdr;
+						GlyphHeader		glyphHdr8;
+						const uint8_t*	glyphHdrPtr = metrics16 ? (const uint8_t*)&glyphHdr : (const uint8_t*)&glyphHdr8;
+						StaticStrings::const_iterator	itr = inStaticStrings->begin();
+						StaticStrings::const_iterator	itrEnd = inStaticStrings->end();
+						for (; itr != itrEnd && createFileError == eSubsetNoErr; ++itr)
+						{
+							uint32_t	columns;
+							if (RenderStaticString(session, faceCoverage, *itr,
+									oneBitPerPixel, kerningPairs, top, height, columns, pixels))
+							{
+								createFileError = eFTLoadCharFailedErr;
+								if (outErrorStr)
+								{
+									outErrorStr->assign("FT_Load_Char failed rendering a static string.");
+								}
+								break;
+							}
+							/*
+							*	The string is encoded the same way as a glyph with
+							*	an x and y of 0.
+							*/
+							uint32_t	numPixels = columns * height;
+							uint8_t*	glyphData = NULL;
+							size_t		glyphDataLen = 0;
+							if (numPixels)
+							{
+								if (oneBitPerPixel)
+								{
+									if (rotated)
+									{
+										// CreateRotatedData expects 16 bit word aligned rows.
+										uint32_t	bytesPerRow = ((columns + 15)/16) * 2;
+										std::vector<uint8_t>	monoBitmap(bytesPerRow * height);
+										for (uint32_t i = 0; i < numPixels; i++)
+										{
+											if (pixels[i])
+											{
+												uint32_t	col = i % columns;
+												monoBitmap[((i / columns) * bytesPerRow) + (col >> 3)] |= (0x80 >> (col & 7));
+											}
+										}
+										glyphData = CreateRotatedData(monoBitmap.data(), height, columns, 0, false, horizontal, glyphDataLen);
+									} else
+									{
+										// A continuous string of bits, same as the packed glyphs.
+										glyphDataLen = (numPixels + 7)/8;
+										glyphData = new uint8_t[glyphDataLen];
+										memset(glyphData, 0, glyphDataLen);
+										for (uint32_t i = 0; i < numPixels; i++)
+										{
+											if (pixels[i])
+											{
+												glyphData[i >> 3] |= (0x80 >> (i & 7));
+											}
+										}
+									}
+								} else
+								{
+									glyphData = new uint8_t[(numPixels * 2) + 2];
+									glyphDataLen = RunLengthEncode(pixels.data(), numPixels, glyphData);
+									if (glyphDataLen == 0)
+									{
+										createFileError = eUnexpectedEndOfRunErr;
+										if (outErrorStr)
+										{
+											outErrorStr->assign("Unexpected end of run");
+										}
+									} else if (adaptiveEncoding &&
+										glyphDataLen >= (1 + numPixels))
+									{
+										glyphData[0] = 0;
+										memcpy(&glyphData[1], pixels.data(), numPixels);
+										glyphDataLen = 1 + numPixels;
+									}
+								}
+							}
+							glyphHdr.advanceX = columns;
+							glyphHdr.x = 0;
+							glyphHdr.y = 0;
+							glyphHdr.rows = numPixels ? height : 0;
+							glyphHdr.columns = columns;
+							if (!metrics16)
+							{
+								if (columns > 255)
+								{
+									createFileError = eMetricsTooLargeErr;
+									if (outErrorStr)
+									{
+										outErrorStr->assign("Static string too wide - needs 16 bit metrics.");
+									}
+								}
+								glyphHdr8.advanceX = (uint8_t)glyphHdr.advanceX;
+								glyphHdr8.x = 0;
+								glyphHdr8.y = 0;
+								glyphHdr8.rows = (uint8_t)glyphHdr.rows;
+								glyphHdr8.columns = (uint8_t)glyphHdr.columns;
+							}
+							if (createFileError == eSubsetNoErr)
+							{
+								staticStringOffsets.push_back(staticStringOffset);
+								fwrite(glyphHdrPtr, glyphHeaderSize, 1, inGlyphDataExportFile);
+								fwrite(glyphData, glyphDataLen, 1, inGlyphDataExportFile);
+								staticStringOffset += (uint32_t)(glyphHeaderSize + glyphDataLen);
+							}
+							delete [] glyphData;
+						}
+						if (createFileError == eSubsetNoErr)
+						{
+							uint16_t	staticStringCount = (uint16_t)staticStringOffsets.size();
+							numStaticStrings = staticStringCount;
+							staticStringsLen = staticStringOffset - staticStringOffsets[0];
+							staticStringOffsets.push_back(staticStringOffset);
+							fwrite(staticStringOffsets.data(), sizeof(uint32_t), staticStringOffsets.size(), inExportFile);
+							fwrite(&staticStringCount, sizeof(uint16_t), 1, inExportFile);
+						}
+					}
 					if (outInfoStr)
 					{
 						char infoBuff[1024];
@@ -936,7 +1936,9 @@ int SubsetFontCreator::CreateXfntFile(
 							"Min glyph.y = %d\n"
 							"Height = %dpx, or %d 1-bit rows\n"
 							"Glyph data length = %d\n"
-							"Largest glyph length = %d\n",
+							"Largest glyph length = %d\n"
+							"Glyph data offset segments = %d\n"
+							"Kerning pairs = %d\n",
 							subsetStr.c_str(),
 							numCharCodes,
 							inCharcodeItr.GetNumRuns(),
@@ -948,10 +1950,36 @@ int SubsetFontCreator::CreateXfntFile(
 							(int)fontHeader.height,
 							(int)(fontHeader.height + 7)/8,
 							(uint32_t)glyphDataOffset,
-							maxEntrySize));
+							maxEntrySize,
+							numSegments,
+							numKerningPairs));
+						if (adaptiveEncoding)
+						{
+							outInfoStr->append(infoBuff, snprintf(infoBuff, 1024,
+								"Raw glyphs = %d\n", (int)numRawGlyphs));
+						}
+						if (numStaticStrings)
+						{
+							outInfoStr->append(infoBuff, snprintf(infoBuff, 1024,
+								"Static strings = %d (%d bytes)\n",
+								(int)numStaticStrings, (int)staticStringsLen));
+						}
+						if (fallbackFaces.size())
+						{
+							AppendFaceCoverage(face, fallbackFaces, faceCoverage,
+												missingCharcodes, *outInfoStr);
+						}
 					}
 					if (outWarningStr)
 					{
+						if (!missingCharcodes.Empty())
+						{
+							char warningBuff[128];
+							outWarningStr->append(warningBuff, snprintf(warningBuff, 128,
+								"%d charcodes are not in the font or any fallback font, "
+								"the font's missing glyph is used.\n",
+								(int)missingCharcodes.GetCount()));
+						}
 						if (containsKerning)
 						{
 							outWarningStr->append(
@@ -960,17 +1988,7 @@ int SubsetFontCreator::CreateXfntFile(
 								"XFont handles kerning by zeroing the x and/or increasing the advance X.");
 						}
 					}
-					if (outErrorStr)
-					{
-						if (fontHeader.height != actualFontHeight)
-						{
-							outErrorStr->assign("Font size too large.  "
-								"Resulting font height is greater than 255.  "
-								"Choose a smaller font size.");
-						}
-					}
 					delete [] glyphDataOffsets;
-					FT_Done_Face(face);
 				} else
 				{
 					createFileError = eFTNewFaceFailedErr;
@@ -979,11 +1997,6 @@ int SubsetFontCreator::CreateXfntFile(
 						outErrorStr->assign("FT_New_Face() failed.");
 					}
 				}
-				if (supplementalFace)
-				{
-					FT_Done_Face(supplementalFace);
-				}
-				FT_Done_FreeType(ftLibrary);
 			} else
 			{
 				createFileError = eFTInitFreeTypeFailedErr;
@@ -992,6 +2005,7 @@ int SubsetFontCreator::CreateXfntFile(
 					outErrorStr->assign("FT_Init_FreeType() failed.");
 				}
 			}
+			delete localSession;
 		}
 	} else
 	{
@@ -1000,6 +2014,431 @@ int SubsetFontCreator::CreateXfntFile(
 	return(createFileError);
 }
 
+/****************************** RunLengthEncode *******************************/
+/*
+*	Run length encodes inPixelCount 8 bit pixels.  Runs of the same value have
+*	a positive run length between 3 and 127.  Runs of unique values have a
+*	negative run length between -1 and -128.  outData needs to be at least
+*	(inPixelCount * 2) + 2 bytes (the worst case size plus 2 bytes at the
+*	end.)  Returns the length of the runs, 0 if the runs ended unexpectedly.
+*/
+uint32_t SubsetFontCreator::RunLengthEncode(
+	const uint8_t*	inPixels,
+	int32_t			inPixelCount,
+	uint8_t*		outData)
+{
+	const uint8_t*	bufferPtr = inPixels;
+	uint8_t*	glyphDataPtr = outData;
+	uint8_t		pixel;
+	uint8_t		runPixel;
+	int32_t		runLen;
+	int32_t		uniqueRunLen;
+	uint8_t*	runLenPtr;
+	runPixel = *(bufferPtr++);
+	runLen = 1;
+	uniqueRunLen = 1;
+	runLenPtr = glyphDataPtr;
+	glyphDataPtr++;
+	*(glyphDataPtr++) = runPixel;
+	int32_t		dataLen = inPixelCount;
+	for (int dataIndex = 1; dataIndex < dataLen; dataIndex++)
+	{
+		pixel = *(bufferPtr++);
+		if (runPixel == pixel)
+		{
+			runLen++;
+			switch(runLen)
+			{
+				/*
+				*	Until the runLen is 3 it can still be treated as
+				*	a run of unique pixels, so keep appending and counting pixels.
+				*/
+				case 2:
+					*(glyphDataPtr++) = runPixel;
+					uniqueRunLen++;
+					break;
+				/*
+				*	Once the runLen is 3 the unique run is terminated, if any.
+				*/
+				case 3:
+					uniqueRunLen++;
+					if (uniqueRunLen > runLen)
+					{
+						uniqueRunLen -= runLen;
+						*runLenPtr = -uniqueRunLen; // write a negative value
+						runLenPtr += (uniqueRunLen +1);
+						uniqueRunLen = 0;	// not needed, for debugging.
+					}
+					break;
+				/*
+				*	The maximum length of a run is 127.  Start a new run at 128
+				*/
+				case 128:
+					*runLenPtr = 127;
+					runLenPtr += 2;
+					glyphDataPtr = runLenPtr + 1;
+					*(glyphDataPtr++) = runPixel;
+					runLen = 1;
+					uniqueRunLen = 1;
+					break;
+				default:
+					break;
+			}
+		/*
+		*	Else the run just ended.
+		*	If the runLen is more than 2 THEN
+		*	record the run length and start a new run.
+		*/
+		} else
+		{
+			if (runLen > 2)
+			{
+				*runLenPtr = runLen;
+				runLenPtr += 2;
+				glyphDataPtr = runLenPtr + 1;
+				runLen = 1;
+				uniqueRunLen = 1;
+			} else
+			{
+				runLen = 1;
+				if (uniqueRunLen != 128)
+				{
+					uniqueRunLen++;
+				} else
+				{
+					*runLenPtr = -128;
+					runLenPtr = glyphDataPtr;
+					glyphDataPtr++;
+					uniqueRunLen = 1;
+				}
+			}
+			*(glyphDataPtr++) = pixel;
+			runPixel = pixel;
+		}
+	}
+	if (runLen > 2)
+	{
+		*runLenPtr = runLen;
+		glyphDataPtr = runLenPtr + 2;
+		*glyphDataPtr = 0xFF;
+	} else if (uniqueRunLen)
+	{
+		*runLenPtr = -uniqueRunLen;
+	} else
+	{
+		glyphDataPtr = outData;
+	}
+	return((uint32_t)(glyphDataPtr - outData));
+}
+
+/***************************** RenderStaticString *****************************/
+/*
+*	Renders inString into outPixels the same way as XFont::DrawStr would draw
+*	it, one byte per pixel (1 bit pixels are 0 or 0xFF), inHeight rows of
+*	outColumns.  Each glyph is placed as a block of its advance with the
+*	glyph's y being inTop - bitmapTop.  Control characters are ignored.
+*	When inKerningPairs, kerning between glyphs of the font (not the fallback
+*	faces) is applied and limited the same way as XFont::KerningWithLeft.
+*/
+int SubsetFontCreator::RenderStaticString(
+	FontSession*			inSession,
+	std::vector<IndexVec>&	inFaceCoverage,
+	const std::string&		inString,
+	bool					inOneBit,
+	bool					inKerningPairs,
+	int32_t					inTop,
+	int32_t					inHeight,
+	uint32_t&				outColumns,
+	std::vector<uint8_t>&	outPixels)
+{
+	FT_Error	error = 0;
+	/*
+	*	The width isn't known till the end so the pixels are composed in
+	*	column order, then copied to outPixels in row order.
+	*/
+	std::vector<uint8_t>	columnPixels;
+	int32_t		column = 0;
+	FT_UInt		leftGlyphIndex = 0;	// For kerning, 0 if none
+	int32_t		leftTrailing = 0;
+	GlyphBitmap	bitmap;
+	XFont::UTF8Reader	reader(inString.c_str());
+	for (uint32_t charcode = reader.Next(); charcode && error == 0;
+											charcode = reader.Next())
+	{
+		if (charcode < ' ')
+		{
+			continue;	// Ignore control characters
+		}
+		size_t	faceIndex = FaceForCharcode(inFaceCoverage, charcode);
+		FT_Face	charcodeFace = faceIndex ? inSession->fallbackFaces[faceIndex-1] : inSession->face;
+		FT_UInt	glyphIndex = FT_Get_Char_Index(charcodeFace, charcode);
+		error = inSession->LoadGlyph(charcodeFace, glyphIndex, charcode, inOneBit, bitmap);
+		if (error == 0)
+		{
+			// Same as XFont::LoadGlyphHeader
+			int32_t	x = bitmap.bitmapLeft > 0 ? bitmap.bitmapLeft : 0;
+			int32_t	advanceX = bitmap.advanceX/64;
+			if (advanceX < (x + bitmap.width))
+			{
+				advanceX = x + bitmap.width;
+			}
+			if (inKerningPairs)
+			{
+				FT_Vector	delta;
+				if (leftGlyphIndex &&
+					faceIndex == 0 &&
+					FT_Get_Kerning(charcodeFace, leftGlyphIndex, glyphIndex,
+									FT_KERNING_DEFAULT, &delta) == 0 &&
+					delta.x/64 != 0)
+				{
+					int32_t	kerning = (int32_t)(delta.x/64);
+					if (kerning < -(leftTrailing + x))
+					{
+						kerning = -(leftTrailing + x);
+					}
+					if ((x + kerning) < 0)
+					{
+						column += (x + kerning);
+						advanceX -= x;
+						x = 0;
+					} else
+					{
+						advanceX += kerning;
+						x += kerning;
+					}
+				}
+				leftGlyphIndex = faceIndex ? 0 : glyphIndex;
+				leftTrailing = advanceX - x - bitmap.width;
+			}
+			size_t	blockEnd = (size_t)(column + advanceX) * inHeight;
+			if (columnPixels.size() < blockEnd)
+			{
+				columnPixels.resize(blockEnd);
+			}
+			// The glyph block replaces whatever it overlaps, as when drawn.
+			memset(&columnPixels[column * inHeight], 0, advanceX * inHeight);
+			int32_t	y = inTop - bitmap.bitmapTop;
+			for (int32_t row = 0; row < bitmap.rows; row++)
+			{
+				if ((y + row) < 0 ||
+					(y + row) >= inHeight)
+				{
+					continue;
+				}
+				const uint8_t*	rowPtr = &bitmap.buffer[row * bitmap.pitch];
+				uint8_t*	pixelPtr = &columnPixels[((column + x) * inHeight) + y + row];
+				for (int32_t col = 0; col < bitmap.width; col++)
+				{
+					*pixelPtr = inOneBit ?
+						((rowPtr[col >> 3] & (0x80 >> (col & 7))) ? 0xFF : 0) : rowPtr[col];
+					pixelPtr += inHeight;
+				}
+			}
+			column += advanceX;
+		}
+	}
+	outColumns = (uint32_t)(columnPixels.size() / inHeight);
+	outPixels.resize(columnPixels.size());
+	for (uint32_t col = 0; col < outColumns; col++)
+	{
+		for (int32_t row = 0; row < inHeight; row++)
+		{
+			outPixels[(row * outColumns) + col] = columnPixels[(col * inHeight) + row];
+		}
+	}
+	return(error);
+}
+
+/***************************** LayoutGlyphEntries *****************************/
+/*
+*	Lays out the glyph entries in inPreferredOrder.  When inPageSize is
+*	non-zero, each entry that's no larger than inPageSize sits within a single
+*	page, and larger entries touch no more pages than necessary.  When an
+*	entry would straddle a page boundary, the gap up to the boundary is filled
+*	with entries that fit from later in inPreferredOrder, and whatever remains
+*	is padded.  Padding is only added when it reduces the number of pages the
+*	entry touches.  When inPageSize is 0 the entries are packed.
+*
+*	inEntryOffsets are the unaligned (packed) offsets of each entry.
+*	inGlyphDataLen is the unaligned length of all entries.
+*	outEntryOffsets are the aligned offsets, indexed by entry.
+*	outEntryOrder is the order in which the entries are to be written.
+*	Returns the aligned length of all entries, including padding.
+*/
+uint32_t SubsetFontCreator::LayoutGlyphEntries(
+	const uint32_t*					inEntryOffsets,
+	uint32_t						inNumEntries,
+	uint32_t						inGlyphDataLen,
+	uint32_t						inPageSize,
+	const std::vector<uint32_t>&	inPreferredOrder,
+	std::vector<uint32_t>&			outEntryOffsets,
+	std::vector<uint32_t>&			outEntryOrder)
+{
+	std::vector<uint32_t>	entrySizes(inNumEntries);
+	std::vector<bool>		placed(inNumEntries, false);
+	outEntryOffsets.assign(inNumEntries, 0);
+	outEntryOrder.clear();
+	outEntryOrder.reserve(inNumEntries);
+	for (uint32_t i = 0; i < inNumEntries; i++)
+	{
+		entrySizes[i] = (i+1 < inNumEntries ? inEntryOffsets[i+1] : inGlyphDataLen) - inEntryOffsets[i];
+	}
+	uint32_t	offset = 0;
+	for (uint32_t orderIndex = 0; orderIndex < inNumEntries; orderIndex++)
+	{
+		uint32_t	entryIndex = inPreferredOrder[orderIndex];
+		if (placed[entryIndex])
+		{
+			continue;
+		}
+		uint32_t	entrySize = entrySizes[entryIndex];
+		uint32_t	offsetInPage = inPageSize ? (offset % inPageSize) : 0;
+		/*
+		*	If the entry would touch more pages than it would if it started
+		*	on a page boundary THEN
+		*	fill the gap with later entries that fit, then pad what remains.
+		*/
+		if (offsetInPage &&
+			((offsetInPage + entrySize + inPageSize - 1)/inPageSize) >
+				((entrySize + inPageSize - 1)/inPageSize))
+		{
+			uint32_t	gap = inPageSize - offsetInPage;
+			for (uint32_t j = orderIndex+1; gap && j < inNumEntries; j++)
+			{
+				uint32_t	fillerIndex = inPreferredOrder[j];
+				if (!placed[fillerIndex] &&
+					entrySizes[fillerIndex] <= gap)
+				{
+					placed[fillerIndex] = true;
+					outEntryOffsets[fillerIndex] = offset;
+					outEntryOrder.push_back(fillerIndex);
+					offset += entrySizes[fillerIndex];
+					gap -= entrySizes[fillerIndex];
+				}
+			}
+			offset += gap;
+		}
+		placed[entryIndex] = true;
+		outEntryOffsets[entryIndex] = offset;
+		outEntryOrder.push_back(entryIndex);
+		offset += entrySize;
+	}
+	return(offset);
+}
+
+/************************** BusTransactionsForGlyph ***************************/
+/*
+*	Returns the expected number of I2C transactions needed to load a glyph
+*	entry stored on an AT24C and read via AT24CDataStream's page aligned
+*	read-ahead lines.  Each page touched is one line load: one transaction to
+*	set the data address plus one per 32 bytes (the Wire buffer limit.)
+*/
+uint32_t SubsetFontCreator::BusTransactionsForGlyph(
+	uint32_t	inEntryOffset,
+	uint32_t	inEntrySize,
+	uint32_t	inPageSize)
+{
+	uint32_t	pagesTouched = inEntrySize ?
+		((inEntryOffset + inEntrySize - 1)/inPageSize) - (inEntryOffset/inPageSize) + 1 : 0;
+	return(pagesTouched * (1 + (inPageSize + 31)/32));
+}
+
+/***************************** CreateCharcodeRuns *****************************/
+/*
+*	Creates the CharcodeRuns array for the charcodes in inIndexVec, including
+*	the sanity check run(s).  When all of the charcodes are 0xFFFF or less, the
+*	runs are version 1 and outCharcodePlanes is empty.  Otherwise the runs are
+*	split by plane, and outCharcodePlanes indexes the runs of each plane
+*	(see XFontGlyph.h)  inUsePlanes splits the runs by plane even when all of
+*	the charcodes are 0xFFFF or less (needed by version 3.)
+*	Charcodes whose low 16 bits are 0xFFFF are excluded, so the entryIndex of
+*	the last sanity check run is the number of glyph entries.
+*	Returns the FontHeader version.
+*/
+uint8_t SubsetFontCreator::CreateCharcodeRuns(
+	const IndexVec&				inIndexVec,
+	std::vector<CharcodeRun>&	outCharcodeRuns,
+	std::vector<CharcodePlane>&	outCharcodePlanes,
+	bool						inUsePlanes)
+{
+	outCharcodeRuns.clear();
+	outCharcodePlanes.clear();
+	const Runs&	charCodeRuns = inIndexVec.GetRuns();
+	// The last run ends after the max charcode (see IndexVec.h for more info)
+	bool		hasPlanes = inUsePlanes || charCodeRuns.back() > 0x10000;
+	uint32_t	plane = 0xFFFFFFFF;
+	uint16_t	entryIndex = 0;
+	CharcodeRun	charcodeRun;
+	CharcodePlane	charcodePlane;
+	Runs::const_iterator	itr = charCodeRuns.begin();
+	Runs::const_iterator	itrEnd = charCodeRuns.end();
+
+	if (inIndexVec.GetFirstRunValue() == 0)
+	{
+		++itr;
+	}
+	
+	for (; itr != itrEnd; ++itr)
+	{
+		uint32_t	start = *itr;
+		++itr;
+		uint32_t	end = *itr;
+		/*
+		*	A run that crosses a plane boundary is split into a run per plane.
+		*/
+		while (start < end)
+		{
+			uint32_t	runEnd = (start | 0xFFFF) + 1;
+			uint32_t	runLength;
+			if (runEnd > end)
+			{
+				runEnd = end;
+				runLength = runEnd - start;
+			} else
+			{
+				// U+xFFFF are noncharacters, they're skipped (not in the runs)
+				runLength = runEnd - start - 1;
+			}
+			if (runLength == 0)
+			{
+				start = runEnd;
+				continue;
+			}
+			if (hasPlanes &&
+				(start >> 16) != plane)
+			{
+				if (plane != 0xFFFFFFFF)
+				{
+					// The sanity check run of the previous plane
+					charcodeRun.start = 0xFFFF;
+					charcodeRun.entryIndex = entryIndex;
+					outCharcodeRuns.push_back(charcodeRun);
+				}
+				plane = start >> 16;
+				charcodePlane.plane = (uint16_t)plane;
+				charcodePlane.runIndex = (uint16_t)outCharcodeRuns.size();
+				outCharcodePlanes.push_back(charcodePlane);
+			}
+			charcodeRun.start = (uint16_t)start;
+			charcodeRun.entryIndex = entryIndex;
+			outCharcodeRuns.push_back(charcodeRun);
+			entryIndex += runLength;
+			start = runEnd;
+		}
+	}
+	// Add the null last run used for sanity checking (see header).
+	charcodeRun.start = 0xFFFF;
+	charcodeRun.entryIndex = entryIndex;
+	outCharcodeRuns.push_back(charcodeRun);
+	if (hasPlanes)
+	{
+		charcodePlane.plane = 0xFFFF;
+		charcodePlane.runIndex = (uint16_t)outCharcodeRuns.size();
+		outCharcodePlanes.push_back(charcodePlane);
+	}
+	return(hasPlanes ? 2 : 1);
+}
+
 /**************************** CleanStrForMacroName ****************************/
 /*
 *	This routine assumes a valid UTF-8 string is passed.
@@ -1096,7 +2535,9 @@ int SubsetFontCreator::XFntToC_Header(
 	FILE*			inOutputFile,
 	std::string&	inSubsetStr,
 	bool			inIncludeGlyphData,
-	int				inOptions)
+	int				inOptions,
+	const char*		inFamilySizeName,	// Not NULL when a member of a family
+	const StaticStrings*	inStaticStrings)
 {
 	TabbedFileStream	tabbedStream(25, inOutputFile);
 	fseek(inXFntFile, 0, SEEK_END);
@@ -1104,54 +2545,149 @@ int SubsetFontCreator::XFntToC_Header(
 	uint8_t*	xfntBuf = new uint8_t[fileSize];
 	fseek(inXFntFile, 0, SEEK_SET);
 	fread(xfntBuf, 1, fileSize, inXFntFile);
-	FontHeader* 	fontHeader;
-	fontHeader = (FontHeader*)xfntBuf;
+	/*
+	*	Version 3 (16 bit metrics) starts with a FontHeader16.  The
+	*	FontHeader of older versions is widened to a FontHeader16.
+	*/
+	FontHeader16	wideFontHeader;
+	FontHeader16* 	fontHeader = &wideFontHeader;
+	size_t			fontHeaderSize = sizeof(FontHeader16);
+	if (((FontHeader*)xfntBuf)->version >= 3)
+	{
+		fontHeader = (FontHeader16*)xfntBuf;
+	} else
+	{
+		const FontHeader*	fontHeader8 = (FontHeader*)xfntBuf;
+		fontHeaderSize = sizeof(FontHeader);
+		wideFontHeader.version = fontHeader8->version;
+		wideFontHeader.oneBit = fontHeader8->oneBit;
+		wideFontHeader.rotated = fontHeader8->rotated;
+		wideFontHeader.horizontal = fontHeader8->horizontal;
+		wideFontHeader.monospaced = fontHeader8->monospaced;
+		wideFontHeader.flags = xfntBuf[kFontHeaderFlagsOffset];
+		wideFontHeader.ascent = fontHeader8->ascent;
+		wideFontHeader.descent = fontHeader8->descent;
+		wideFontHeader.height = fontHeader8->height;
+		wideFontHeader.width = fontHeader8->width;
+		wideFontHeader.numCharcodeRuns = fontHeader8->numCharcodeRuns;
+		wideFontHeader.numCharCodes = fontHeader8->numCharCodes;
+	}
+	bool	metrics16 = fontHeader->version >= 3;
 	std::string	headerMacro;
 	const char*	exportFilename = GetLastPathComponent(inExportPath);
 	uint32_t	glyphDataLen = 0;
 	CleanStrForMacroName(exportFilename, headerMacro);
 	bool	minimizeHeight = (inOptions & eMinimizeHeight) != 0;
+	/*
+	*	The features are identified by the font header flags.  The options
+	*	and inStaticStrings are also checked for xfnt files created before
+	*	the flags were added.
+	*/
+	bool	segmentedOffsets = (fontHeader->flags & eSegmentedOffsetsFlag) != 0 ||
+				(inOptions & (eSegmentedDataOffsets + e32BitDataOffsets)) == eSegmentedDataOffsets;
+	bool	deltaOffsets = false;
+	bool	kerningPairs = (fontHeader->flags & eKerningPairsFlag) != 0 ||
+				(inOptions & eKerningPairs) != 0;
+	bool	staticStrings = (fontHeader->flags & eStaticStringsFlag) != 0 ||
+				(inStaticStrings && inStaticStrings->size());
+	/*
+	*	Version 2 and 3 fonts have a CharcodePlanes array following the
+	*	CharcodeRuns array.  The last plane is 0xFFFF.
+	*/
+	const CharcodePlane*	charcodePlanes = (const CharcodePlane*)&xfntBuf[fontHeaderSize +
+							(fontHeader->numCharcodeRuns * sizeof(CharcodeRun))];
+	uint32_t	numCharcodePlanes = 0;
+	if (fontHeader->version >= 2)
+	{
+		while (charcodePlanes[numCharcodePlanes++].plane != 0xFFFF){}
+	}
+	size_t	charcodeRunsSize = (fontHeader->numCharcodeRuns * sizeof(CharcodeRun)) +
+							(numCharcodePlanes * sizeof(CharcodePlane));
+	uint16_t*	dataOffsets = (uint16_t*)&xfntBuf[fontHeaderSize + charcodeRunsSize];
+	uint32_t	numCheckpoints = (fontHeader->numCharCodes >> kGlyphDataCheckpointShift) + 1;
+	if (!segmentedOffsets &&
+		(inOptions & (eFixedDataOffsets + e32BitDataOffsets)) == 0 &&
+		(numCheckpoints * sizeof(uint16_t)) + fontHeader->numCharCodes <
+			(fontHeader->numCharCodes + 1) * sizeof(uint16_t))
+	{
+		/*
+		*	Delta encoding is only possible when the glyph data is in entry
+		*	order (no usage profile ordering or page aligned gap filling) and
+		*	every entry is less than 256 bytes.
+		*/
+		deltaOffsets = true;
+		for (uint32_t i = 0; i < fontHeader->numCharCodes; i++)
+		{
+			if (dataOffsets[i+1] >= dataOffsets[i] &&
+				(dataOffsets[i+1] - dataOffsets[i]) <= 0xFF)
+			{
+				continue;
+			}
+			deltaOffsets = false;
+			break;
+		}
+	}
 	// For the namespace name, strip off _h if it exists (it should always exist)
 	std::string	namespaceName(headerMacro, 0, headerMacro.length() - 2);
 	std::string	xFontStreamClassName(fontHeader->rotated ?
 		(fontHeader->horizontal ? "XFontRH1BitDataStream" : "XFontR1BitDataStream") :
 			"XFont16BitDataStream");
+	if (!inFamilySizeName)
+	{
+		tabbedStream.Write(
+			"// Subset font created by SubsetFontCreator"
+			"\n// For subset: \"%s\"%s"
+			"\n\n#ifndef %s"
+			"\n#define %s"
+			"\n\n#include \"XFontGlyph.h\""
+			"\n#include \"%s.h\""
+			"\n\nnamespace %s"
+			"\n{", inSubsetStr.c_str(), minimizeHeight ? " (Height minimized)":"",
+					 headerMacro.c_str(),
+					 headerMacro.c_str(),
+					 xFontStreamClassName.c_str(),
+					 namespaceName.c_str());
+	} else
+	{
+		/*
+		*	The prologue, the CharcodeRuns and the CharcodePlanes are written
+		*	once for the family by CreateFamilyFile.
+		*/
+		tabbedStream++;
+		tabbedStream.Write(
+			"\n\nnamespace %s"
+			"\n{", inFamilySizeName);
+	}
 	tabbedStream.Write(
-		"// Subset font created by SubsetFontCreator"
-		"\n// For subset: \"%s\"%s"
-		"\n\n#ifndef %s"
-		"\n#define %s"
-		"\n\n#include \"XFontGlyph.h\""
-		"\n#include \"%s.h\""
-		"\n\nnamespace %s"
-		"\n{"
-		"\n\tconst FontHeader\tfontHeader PROGMEM ="
-		"\n\t{", inSubsetStr.c_str(), minimizeHeight ? " (Height minimized)":"",
-				 headerMacro.c_str(),
-				 headerMacro.c_str(),
-				 xFontStreamClassName.c_str(),
-				 namespaceName.c_str());
+		"\n\tconst %s\tfontHeader PROGMEM ="
+		"\n\t{", metrics16 ? "FontHeader16" : "FontHeader");
 	tabbedStream+=2;
 		//	32 bit offsets are not supported in C headers.
 		//"\n%d,%2t// wideOffsets, 1 = 32 bit, 0 = 16 bit glyph data offsets"
 		//(int)fontHeader->wideOffsets,
 	tabbedStream.Write(
-		"\n%d,%2t// version, currently version = 1"
+		"\n%d,%2t// version, 1 = 16 bit charcodes, 2 = charcode planes, 3 = 16 bit metrics"
 		"\n%d,%2t// oneBit, 1 = 1 bit per pixel, 0 = 8 bit (antialiased)"
 		"\n%d,%2t// rotated, glyph data is rotated (applies to 1 bit only)"
 		"\n%d,%2t// horizontal, addressing for rotated data, else vertical"
-		"\n%d,%2t// monospaced, fixed width font (for this subset)"
+		"\n%d,%2t// monospaced, fixed width font (for this subset)",
+		(int)fontHeader->version,
+		(int)fontHeader->oneBit,
+		(int)fontHeader->rotated,
+		(int)fontHeader->horizontal,
+		(int)fontHeader->monospaced);
+	if (metrics16)
+	{
+		tabbedStream.Write(
+			"\n%d,%2t// flags, see EFontFlags", (int)fontHeader->flags);
+	}
+	tabbedStream.Write(
 		"\n%d,%2t// ascent, font in pixels"
 		"\n%d,%2t// descent, font in pixels"
 		"\n%d,%2t// height, font height (ascent+descent+leading) in pixels"
 		"\n%d,%2t// width, widest glyph advanceX within subset in pixels"
 		"\n%d,%2t// numCharcodeRuns"
 		"\n%d%2t// numCharCodes",
-		(int)fontHeader->version,
-		(int)fontHeader->oneBit,
-		(int)fontHeader->rotated,
-		(int)fontHeader->horizontal,
-		(int)fontHeader->monospaced,
 		(int)fontHeader->ascent,
 		(int)fontHeader->descent,
 		(int)fontHeader->height,
@@ -1160,73 +2696,286 @@ int SubsetFontCreator::XFntToC_Header(
 		(int)fontHeader->numCharCodes);
 	tabbedStream--;
 	tabbedStream.Write(
-		"\n};"
-		"\n\nconst CharcodeRun\tcharcodeRun[] PROGMEM = // {start, entryIndex}, ..."
-		"\n{");
-	tabbedStream++;
-	uint8_t*	currOffset = &xfntBuf[sizeof(FontHeader)];
+		"\n};");
+	if (!inFamilySizeName)
 	{
-		CharcodeRun*	runPtr = (CharcodeRun*)currOffset;
-		CharcodeRun*	runEnd = &runPtr[fontHeader->numCharcodeRuns];
-		currOffset = (uint8_t*)runEnd;
-		
-		int	runsOnRow = 0;
-		while (runPtr != runEnd)
+		WriteCharcodeRuns(tabbedStream, (const CharcodeRun*)&xfntBuf[fontHeaderSize],
+			fontHeader->numCharcodeRuns, charcodePlanes, numCharcodePlanes);
+	}
+	uint8_t*	currOffset = &xfntBuf[fontHeaderSize + charcodeRunsSize];
+	if (deltaOffsets)
+	{
+		/*
+		*	The checkpoint array is deliberately not named glyphDataOffset so
+		*	that code constructing an XFont::Font without the deltas won't
+		*	compile.
+		*/
+		tabbedStream.Write(
+			"\n\nconst uint16_t\tglyphDataCheckpoint[] PROGMEM = // offset of every 16th entry"
+			"\n{");
+		tabbedStream++;
+		uint32_t	checkpointsOnRow = 0;
+		for (uint32_t i = 0; i < numCheckpoints; i++)
 		{
-			if (runsOnRow == 0)
+			if (checkpointsOnRow == 0)
 			{
 				tabbedStream.Write("\n");
 			}
 			
-			fprintf(inOutputFile, "{0x%04hX, %hd}", runPtr->start, runPtr->entryIndex);
-			runPtr++;
-			runsOnRow++;
-			if (runsOnRow == 5)	// runs per row
+			fprintf(inOutputFile, "0x%04hX", dataOffsets[i << kGlyphDataCheckpointShift]);
+			checkpointsOnRow++;
+			if (checkpointsOnRow == 8)	// checkpoints per row
 			{
-				runsOnRow = 0;
+				checkpointsOnRow = 0;
 			}
-			if (runPtr != runEnd)
+			if ((i+1) != numCheckpoints)
+			{
+				fprintf(inOutputFile, checkpointsOnRow != 0 ? ", " : ",");
+			}
+		}
+		tabbedStream--;
+		tabbedStream.Write(
+			"\n};"
+			"\n\nconst uint8_t\tglyphDataDelta[] PROGMEM = // size of each entry"
+			"\n{");
+		tabbedStream++;
+		uint32_t	deltasOnRow = 0;
+		for (uint32_t i = 0; i < fontHeader->numCharCodes; i++)
+		{
+			if (deltasOnRow == 0)
+			{
+				tabbedStream.Write("\n");
+			}
+			
+			fprintf(inOutputFile, "0x%02X", (int)(dataOffsets[i+1] - dataOffsets[i]));
+			deltasOnRow++;
+			if (deltasOnRow == 12)	// deltas per row
+			{
+				deltasOnRow = 0;
+			}
+			if ((i+1) != fontHeader->numCharCodes)
+			{
+				fprintf(inOutputFile, deltasOnRow != 0 ? ", " : ",");
+			}
+		}
+		currOffset = (uint8_t*)&dataOffsets[fontHeader->numCharCodes+1];
+		glyphDataLen = dataOffsets[fontHeader->numCharCodes];
+	} else
+	{
+		tabbedStream.Write(
+			"\n\nconst uint16_t\tglyphDataOffset[] PROGMEM ="
+			"\n{");
+		tabbedStream++;
+		{
+			uint16_t*	dataOffsetPtr = (uint16_t*)currOffset;
+			uint16_t*	dataOffsetEnd = &dataOffsetPtr[fontHeader->numCharCodes+1];
+			currOffset = (uint8_t*)dataOffsetEnd;
+			glyphDataLen = dataOffsetEnd[-1];
+			if (segmentedOffsets)
+			{
+				const uint32_t*	segmentBase = (const uint32_t*)currOffset;
+				uint32_t	numSegments = (fontHeader->numCharCodes + 256)/256;
+				currOffset += numSegments * sizeof(uint32_t);
+				glyphDataLen += segmentBase[numSegments-1];
+			}
+		
+			int	offsetsOnRow = 0;
+			while (dataOffsetPtr != dataOffsetEnd)
 			{
-				fprintf(inOutputFile, runsOnRow != 0 ? ", " : ",");
+				if (offsetsOnRow == 0)
+				{
+					tabbedStream.Write("\n");
+				}
+			
+				fprintf(inOutputFile, "0x%04hX", *dataOffsetPtr);
+				dataOffsetPtr++;
+				offsetsOnRow++;
+				if (offsetsOnRow == 8)	// offsets per row
+				{
+					offsetsOnRow = 0;
+				}
+				if (dataOffsetPtr != dataOffsetEnd)
+				{
+					fprintf(inOutputFile, offsetsOnRow != 0 ? ", " : ",");
+				}
 			}
 		}
 	}
 	tabbedStream--;
 	tabbedStream.Write(
-		"\n};"
-		"\n\nconst uint16_t\tglyphDataOffset[] PROGMEM ="
-		"\n{");
-	tabbedStream++;
+		"\n};");
+	if (segmentedOffsets)
 	{
-		uint16_t*	dataOffsetPtr = (uint16_t*)currOffset;
-		uint16_t*	dataOffsetEnd = &dataOffsetPtr[fontHeader->numCharCodes+1];
-		currOffset = (uint8_t*)dataOffsetEnd;
-		glyphDataLen = dataOffsetEnd[-1];
-		
-		int	offsetsOnRow = 0;
-		while (dataOffsetPtr != dataOffsetEnd)
+		tabbedStream.Write(
+			"\n\nconst uint32_t\tglyphDataSegment[] PROGMEM = // base offset per 256 glyphDataOffset entries"
+			"\n{");
+		tabbedStream++;
+		const uint32_t*	segmentPtr = (const uint32_t*)&dataOffsets[fontHeader->numCharCodes+1];
+		const uint32_t*	segmentEnd = (const uint32_t*)currOffset;
+		int	segmentsOnRow = 0;
+		while (segmentPtr != segmentEnd)
 		{
-			if (offsetsOnRow == 0)
+			if (segmentsOnRow == 0)
 			{
 				tabbedStream.Write("\n");
 			}
 			
-			fprintf(inOutputFile, "0x%04hX", *dataOffsetPtr);
-			dataOffsetPtr++;
-			offsetsOnRow++;
-			if (offsetsOnRow == 8)	// offsets per row
+			fprintf(inOutputFile, "0x%08X", *segmentPtr);
+			segmentPtr++;
+			segmentsOnRow++;
+			if (segmentsOnRow == 6)	// segments per row
+			{
+				segmentsOnRow = 0;
+			}
+			if (segmentPtr != segmentEnd)
+			{
+				fprintf(inOutputFile, segmentsOnRow != 0 ? ", " : ",");
+			}
+		}
+		tabbedStream--;
+		tabbedStream.Write(
+			"\n};");
+	}
+	/*
+	*	The kerning arrays, when present, follow the glyph data, or the
+	*	offsets when the glyph data is stored separately.
+	*/
+	uint8_t*	glyphDataEnd = &xfntBuf[fileSize];
+	uint32_t	numKerningPairs = 0;
+	/*
+	*	The static string table, when present, is at the end of the file.  It's
+	*	the offset of each static string entry within the glyph data plus the
+	*	offset of the end, followed by the number of strings.
+	*/
+	uint16_t	numStaticStrings = 0;
+	const uint32_t*	staticStringOffsets = NULL;
+	if (staticStrings)
+	{
+		memcpy(&numStaticStrings, &xfntBuf[fileSize - sizeof(uint16_t)], sizeof(uint16_t));
+		staticStringOffsets = (const uint32_t*)&xfntBuf[fileSize - sizeof(uint16_t) -
+								((numStaticStrings + 1) * sizeof(uint32_t))];
+		glyphDataEnd = inIncludeGlyphData ? &currOffset[glyphDataLen] : currOffset;
+	}
+	if (kerningPairs)
+	{
+		glyphDataEnd = inIncludeGlyphData ? &currOffset[glyphDataLen] : currOffset;
+		const KerningLeft*	kerningLeftPtr = (const KerningLeft*)glyphDataEnd;
+		const KerningLeft*	kerningLeftEnd = kerningLeftPtr;
+		while ((kerningLeftEnd++)->entryIndex != 0xFFFF){}
+		numKerningPairs = kerningLeftEnd[-1].pairIndex;
+		if (numKerningPairs)
+		{
+			tabbedStream.Write(
+				"\n\nconst KerningLeft\tkerningLeft[] PROGMEM = // {entryIndex, pairIndex}, ..."
+				"\n{");
+			tabbedStream++;
+			int	leftsOnRow = 0;
+			while (kerningLeftPtr != kerningLeftEnd)
 			{
-				offsetsOnRow = 0;
+				if (leftsOnRow == 0)
+				{
+					tabbedStream.Write("\n");
+				}
+				
+				fprintf(inOutputFile, "{0x%04hX, %hu}", kerningLeftPtr->entryIndex, kerningLeftPtr->pairIndex);
+				kerningLeftPtr++;
+				leftsOnRow++;
+				if (leftsOnRow == 5)	// lefts per row
+				{
+					leftsOnRow = 0;
+				}
+				if (kerningLeftPtr != kerningLeftEnd)
+				{
+					fprintf(inOutputFile, leftsOnRow != 0 ? ", " : ",");
+				}
 			}
-			if (dataOffsetPtr != dataOffsetEnd)
+			tabbedStream--;
+			tabbedStream.Write(
+				"\n};"
+				"\n\nconst KerningPair\tkerningPair[] PROGMEM = // {entryIndex, adjust}, ..."
+				"\n{");
+			tabbedStream++;
+			const KerningPair*	kerningPairPtr = (const KerningPair*)kerningLeftEnd;
+			const KerningPair*	kerningPairEnd = &kerningPairPtr[numKerningPairs];
+			int	pairsOnRow = 0;
+			while (kerningPairPtr != kerningPairEnd)
 			{
-				fprintf(inOutputFile, offsetsOnRow != 0 ? ", " : ",");
+				if (pairsOnRow == 0)
+				{
+					tabbedStream.Write("\n");
+				}
+				
+				fprintf(inOutputFile, "{%hu, %hd}", kerningPairPtr->entryIndex, kerningPairPtr->adjust);
+				kerningPairPtr++;
+				pairsOnRow++;
+				if (pairsOnRow == 6)	// pairs per row
+				{
+					pairsOnRow = 0;
+				}
+				if (kerningPairPtr != kerningPairEnd)
+				{
+					fprintf(inOutputFile, pairsOnRow != 0 ? ", " : ",");
+				}
 			}
+			tabbedStream--;
+			tabbedStream.Write(
+				"\n};");
 		}
 	}
-	tabbedStream--;
-	tabbedStream.Write(
-		"\n};");
+	/*
+	*	The static strings are copied to the end of the glyph data so their
+	*	offsets follow glyphDataLen, with or without the glyph data included.
+	*/
+	uint32_t	staticStringsLen = 0;
+	if (numStaticStrings)
+	{
+		staticStringsLen = staticStringOffsets[numStaticStrings] - staticStringOffsets[0];
+		tabbedStream.Write(
+			"\n\nconst uint32_t\tstaticString[] PROGMEM = // glyph data offset, see XFont::DrawStaticString"
+			"\n{");
+		tabbedStream++;
+		for (uint16_t i = 0; i < numStaticStrings; i++)
+		{
+			// Control characters are replaced so the comment stays on one line.
+			std::string	text(inStaticStrings && i < inStaticStrings->size() ? (*inStaticStrings)[i] : "");
+			std::replace_if(text.begin(), text.end(),
+				[](char inChar){return(inChar >= 0 && inChar < ' ');}, ' ');
+			tabbedStream.Write("\n0x%08X%s%4t// %d \"%s\"",
+				glyphDataLen + staticStringOffsets[i] - staticStringOffsets[0],
+				(i+1) != numStaticStrings ? "," : "",
+				(int)i, text.c_str());
+		}
+		tabbedStream--;
+		tabbedStream.Write(
+			"\n};");
+	}
+	/*
+	*	The optional XFont::Font constructor arguments following the glyph
+	*	data stream, trailing unused arguments are omitted.
+	*/
+	std::string	fontArgs;
+	// A FontHeader16 is passed as a FontHeader (see XFont::Font)
+	const char*	fontHeaderArg = metrics16 ? "(const FontHeader*)&fontHeader" : "&fontHeader";
+	if (numStaticStrings)
+	{
+		fontArgs.assign(", staticString");
+	}
+	if (numKerningPairs || fontArgs.length())
+	{
+		fontArgs.insert(0, numKerningPairs ? ", kerningLeft, kerningPair" : ", nullptr, nullptr");
+	}
+	if (numCharcodePlanes || fontArgs.length())
+	{
+		fontArgs.insert(0, numCharcodePlanes ? ", charcodePlane" : ", nullptr");
+	}
+	if (deltaOffsets || fontArgs.length())
+	{
+		fontArgs.insert(0, deltaOffsets ? ", glyphDataDelta" : ", nullptr");
+	}
+	if (segmentedOffsets || fontArgs.length())
+	{
+		fontArgs.insert(0, segmentedOffsets ? ", glyphDataSegment" : ", nullptr");
+	}
 	if (inIncludeGlyphData)
 	{
 		tabbedStream.Write(
@@ -1235,7 +2984,7 @@ int SubsetFontCreator::XFntToC_Header(
 		tabbedStream++;
 		{
 			const uint8_t*	dataPtr = currOffset;
-			const uint8_t*	endData = (uint8_t*)&xfntBuf[fileSize];
+			const uint8_t*	endData = glyphDataEnd;
 			int	valuesOnRow = 0;
 			while (dataPtr != endData)
 			{
@@ -1246,6 +2995,14 @@ int SubsetFontCreator::XFntToC_Header(
 				
 				fprintf(inOutputFile, "0x%02hhX", *dataPtr);
 				dataPtr++;
+				// The static strings follow the glyph data, skipping any kerning.
+				if (dataPtr == endData &&
+					staticStringsLen &&
+					endData != &currOffset[staticStringOffsets[numStaticStrings]])
+				{
+					dataPtr = &currOffset[staticStringOffsets[0]];
+					endData = &currOffset[staticStringOffsets[numStaticStrings]];
+				}
 				valuesOnRow++;
 				if (valuesOnRow == 12)	// bytes per row
 				{
@@ -1313,38 +3070,404 @@ int SubsetFontCreator::XFntToC_Header(
 		tabbedStream--;
 		tabbedStream.Write(
 			"\n};");
-	tabbedStream.Write(
-		"\n\n// Usage: Copy the 3 commented lines to your code, removing the comments."
-		"\n//#include \"XFont.h\""
-		"\n//XFont xFont;"
-		"\n//#include \"%s\""
-		"\n\n// Leave the next 3 lines here, as is."
-		"\nDataStream_P\tdataStream(glyphData, sizeof(glyphData));"
-		"\n%s xFontDataStream(&xFont, &dataStream);"
-		"\nXFont::Font font(&fontHeader, charcodeRun, glyphDataOffset, &xFontDataStream);"
-		"\n\n// The display needs to be set before using xFont.  This only needs"
-		"\n// to be done once at the beginning of the program."
-		"\n// Use xFont.SetDisplay(&display, &%s::font); to do this."
-		"\n// To change to this font anywhere after setting the display,"
-		"\n// use: xFont.SetFont(&%s::font);",
-		exportFilename,
-		xFontStreamClassName.c_str(),
-		namespaceName.c_str(),
-		namespaceName.c_str());
+		// A family's usage is written once by CreateFamilyFile.
+		if (!inFamilySizeName)
+		{
+			tabbedStream.Write(
+				"\n\n// Usage: Copy the 3 commented lines to your code, removing the comments."
+				"\n//#include \"XFont.h\""
+				"\n//XFont xFont;"
+				"\n//#include \"%s\""
+				"\n\n// Leave the next 3 lines here, as is.",
+				exportFilename);
+		} else
+		{
+			tabbedStream.Write(
+				"\n");
+		}
+		tabbedStream.Write(
+			"\nDataStream_P\tdataStream(glyphData, sizeof(glyphData));"
+			"\n%s xFontDataStream(&xFont, &dataStream);"
+			"\nXFont::Font font(%s, charcodeRun, %s, &xFontDataStream%s);",
+			xFontStreamClassName.c_str(),
+			fontHeaderArg,
+			deltaOffsets ? "glyphDataCheckpoint" : "glyphDataOffset",
+			fontArgs.c_str());
+		if (!inFamilySizeName)
+		{
+			tabbedStream.Write(
+				"\n\n// The display needs to be set before using xFont.  This only needs"
+				"\n// to be done once at the beginning of the program."
+				"\n// Use xFont.SetDisplay(&display, &%s::font); to do this."
+				"\n// To change to this font anywhere after setting the display,"
+				"\n// use: xFont.SetFont(&%s::font);",
+				namespaceName.c_str(),
+				namespaceName.c_str());
+		}
 	} else
 	{
 		tabbedStream.Write(
-			"\n\nconst uint32_t\tkGlyphDataLength = %d;", glyphDataLen);
+			"\n\nconst uint32_t\tkGlyphDataLength = %d;", glyphDataLen + staticStringsLen);
+		if (fontArgs.length())
+		{
+			tabbedStream.Write(
+				"\n\n// Construct the font using:"
+				"\n// XFont::Font font(%s, charcodeRun, %s,"
+				"\n//\t\t&xFontDataStream%s);",
+				fontHeaderArg,
+				deltaOffsets ? "glyphDataCheckpoint" : "glyphDataOffset",
+				fontArgs.c_str());
+		}
 	}
 	tabbedStream--;
-	tabbedStream.Write(
-		"\n}"
-		"\n\n#endif // %s\n\n",
-		headerMacro.c_str());
+	if (inFamilySizeName)
+	{
+		tabbedStream.Write(
+			"\n}");
+	} else
+	{
+		tabbedStream.Write(
+			"\n}"
+			"\n\n#endif // %s\n\n",
+			headerMacro.c_str());
+	}
 	delete [] xfntBuf;
 	return(0);
 }
 
+/***************************** WriteCharcodeRuns ******************************/
+/*
+*	Writes the charcodeRun array and, when inNumCharcodePlanes isn't zero,
+*	the charcodePlane array.
+*/
+void SubsetFontCreator::WriteCharcodeRuns(
+	TabbedFileStream&		inTabbedStream,
+	const CharcodeRun*		inCharcodeRuns,
+	uint32_t				inNumCharcodeRuns,
+	const CharcodePlane*	inCharcodePlanes,
+	uint32_t				inNumCharcodePlanes)
+{
+	FILE*	outputFile = inTabbedStream.GetStream();
+	inTabbedStream.Write(
+		"\n\nconst CharcodeRun\tcharcodeRun[] PROGMEM = // {start, entryIndex}, ..."
+		"\n{");
+	inTabbedStream++;
+	{
+		const CharcodeRun*	runPtr = inCharcodeRuns;
+		const CharcodeRun*	runEnd = &runPtr[inNumCharcodeRuns];
+		
+		int	runsOnRow = 0;
+		while (runPtr != runEnd)
+		{
+			if (runsOnRow == 0)
+			{
+				inTabbedStream.Write("\n");
+			}
+			
+			fprintf(outputFile, "{0x%04hX, %hd}", runPtr->start, runPtr->entryIndex);
+			runPtr++;
+			runsOnRow++;
+			if (runsOnRow == 5)	// runs per row
+			{
+				runsOnRow = 0;
+			}
+			if (runPtr != runEnd)
+			{
+				fprintf(outputFile, runsOnRow != 0 ? ", " : ",");
+			}
+		}
+	}
+	inTabbedStream--;
+	inTabbedStream.Write(
+		"\n};");
+	if (inNumCharcodePlanes)
+	{
+		inTabbedStream.Write(
+			"\n\nconst CharcodePlane\tcharcodePlane[] PROGMEM = // {plane, runIndex}, ..."
+			"\n{");
+		inTabbedStream++;
+		const CharcodePlane*	planePtr = inCharcodePlanes;
+		const CharcodePlane*	planeEnd = &inCharcodePlanes[inNumCharcodePlanes];
+		
+		int	planesOnRow = 0;
+		while (planePtr != planeEnd)
+		{
+			if (planesOnRow == 0)
+			{
+				inTabbedStream.Write("\n");
+			}
+			
+			fprintf(outputFile, "{0x%04hX, %hd}", planePtr->plane, planePtr->runIndex);
+			planePtr++;
+			planesOnRow++;
+			if (planesOnRow == 5)	// planes per row
+			{
+				planesOnRow = 0;
+			}
+			if (planePtr != planeEnd)
+			{
+				fprintf(outputFile, planesOnRow != 0 ? ", " : ",");
+			}
+		}
+		inTabbedStream--;
+		inTabbedStream.Write(
+			"\n};");
+	}
+}
+
+/****************************** CreateFamilyFile ******************************/
+/*
+*	All of the sizes are rendered using a single FontSession, so the font
+*	and its fallback fonts are only opened once.  Each size is created as a
+*	temporary xfnt file, then written as a namespace within the family's
+*	namespace by XFntToC_Header.
+*	The CharcodeRuns only depend on the subset, so they're the same for every
+*	size.  The CharcodePlanes are only used by version 2 and 3 sizes.
+*/
+int SubsetFontCreator::CreateFamilyFile(
+	const char*		inFontFilePath,
+	const char*		inExportPath,
+	const std::vector<int32_t>&	inPointSizes,
+	int				inOptions,
+	const char*		inSubset,
+	long			inFontFaceIndex,
+	const FallbackFaces&	inFallbackFaces,
+	std::string*	outErrorStr,
+	std::string*	outWarningStr,
+	std::string*	outInfoStr,
+	const char*		inUsageProfilePath)
+{
+	SubsetCharcodeIterator	charcodeIterator(inSubset, outErrorStr);
+	GlyphUsageProfile	usageProfile;
+	int	createFileError = eSubsetNoErr;
+	bool	success = charcodeIterator.IsValid();
+	if (success &&
+		inUsageProfilePath &&
+		inUsageProfilePath[0])
+	{
+		success = usageProfile.Load(inUsageProfilePath);
+		if (!success)
+		{
+			createFileError = eUsageProfileReadErr;
+			if (outErrorStr)
+			{
+				outErrorStr->assign("Unable to read the usage profile.");
+			}
+		}
+	}
+	if (success &&
+		inPointSizes.size())
+	{
+		// The glyph data of a family can't be stored separately.
+		inOptions &= ~eGlyphDataSeparately;
+		std::vector<int32_t>	pointSizes(inPointSizes);
+		std::sort(pointSizes.begin(), pointSizes.end());
+		pointSizes.erase(std::unique(pointSizes.begin(), pointSizes.end()), pointSizes.end());
+		std::vector<FILE*>	sizeFiles;
+		std::vector<int>	sizeOptions;
+		bool	usesPlanes = false;
+		{
+			FontSession	session(inFontFilePath, inFontFaceIndex, inFallbackFaces, outWarningStr);
+			for (size_t i = 0; i < pointSizes.size(); i++)
+			{
+				FILE*	file = tmpfile();
+				if (!file)
+				{
+					break;
+				}
+				sizeFiles.push_back(file);
+				if (outInfoStr)
+				{
+					char infoBuff[64];
+					outInfoStr->append(infoBuff, snprintf(infoBuff, 64,
+						"\n%d points:", (int)pointSizes[i]));
+				}
+				int	options = inOptions;
+				charcodeIterator.MoveToStart();
+				createFileError = CreateXfntFileAndRetry(inFontFilePath, file, file,
+									pointSizes[i], options, charcodeIterator, inFontFaceIndex,
+										inFallbackFaces, outErrorStr, outWarningStr, outInfoStr,
+											usageProfile.IsEmpty() ? NULL : &usageProfile, &session);
+				sizeOptions.push_back(options);
+				/*
+				*	32 bit offsets are only supported in the binary format.
+				*/
+				if (createFileError == eSubsetNoErr &&
+					(options & e32BitDataOffsets))
+				{
+					createFileError = eDataOffsetTooLargeErr;
+					if (outErrorStr)
+					{
+						outErrorStr->assign("Glyph data within a 256 glyph segment exceeds 64KB - 32 bit offsets are only supported by the binary format.");
+					}
+				}
+				if (createFileError != eSubsetNoErr)
+				{
+					break;
+				}
+				FontHeader	fontHeader;
+				fseek(file, 0, SEEK_SET);
+				fread(&fontHeader, sizeof(FontHeader), 1, file);
+				usesPlanes = usesPlanes || fontHeader.version >= 2;
+			}
+		}
+		std::string utf8ExportPath(inExportPath);
+		if (createFileError == eSubsetNoErr &&
+			sizeFiles.size() == pointSizes.size() &&
+			utf8ExportPath.size())
+		{
+			FILE*	exportFile = fopen(utf8ExportPath.c_str(), "w+");
+			if (exportFile)
+			{
+				TabbedFileStream	tabbedStream(25, exportFile);
+				std::string	headerMacro;
+				const char*	exportFilename = GetLastPathComponent(utf8ExportPath.c_str());
+				CleanStrForMacroName(exportFilename, headerMacro);
+				// For the namespace name, strip off _h if it exists (it should always exist)
+				std::string	namespaceName(headerMacro, 0, headerMacro.length() - 2);
+				bool	rotated = (inOptions & (e1BitPerPixel+eRotated)) == e1BitPerPixel+eRotated;
+				std::string	xFontStreamClassName(rotated ?
+					((inOptions & eHorizontal) ? "XFontRH1BitDataStream" : "XFontR1BitDataStream") :
+						"XFont16BitDataStream");
+				std::string	subsetStr;
+				charcodeIterator.GetSubset(subsetStr);
+				std::string	sizesStr;
+				std::vector<std::string>	sizeNames;
+				for (size_t i = 0; i < pointSizes.size(); i++)
+				{
+					char	sizeName[32];
+					snprintf(sizeName, sizeof(sizeName), "Size%d", (int)pointSizes[i]);
+					sizeNames.push_back(sizeName);
+					sizesStr.append(sizeName + 4);
+					if ((i+1) < pointSizes.size())
+					{
+						sizesStr.append(", ");
+					}
+				}
+				tabbedStream.Write(
+					"// Subset font family created by SubsetFontCreator"
+					"\n// For subset: \"%s\"%s"
+					"\n// Point sizes: %s"
+					"\n\n#ifndef %s"
+					"\n#define %s"
+					"\n\n#include \"XFontGlyph.h\""
+					"\n#include \"%s.h\""
+					"\n\n// Usage: Copy the 3 commented lines to your code, removing the comments."
+					"\n//#include \"XFont.h\""
+					"\n//XFont xFont;"
+					"\n//#include \"%s\""
+					"\n\n// The display needs to be set before using xFont.  This only needs"
+					"\n// to be done once at the beginning of the program."
+					"\n// Use xFont.SetDisplay(&display, &%s::%s::font); to do this."
+					"\n// To change to a size anywhere after setting the display,"
+					"\n// use: xFont.SetFont(&%s::%s::font);"
+					"\n\nnamespace %s"
+					"\n{", subsetStr.c_str(),
+							(inOptions & eMinimizeHeight) ? " (Height minimized)":"",
+							sizesStr.c_str(),
+							headerMacro.c_str(),
+							headerMacro.c_str(),
+							xFontStreamClassName.c_str(),
+							exportFilename,
+							namespaceName.c_str(), sizeNames[0].c_str(),
+							namespaceName.c_str(), sizeNames[0].c_str(),
+							namespaceName.c_str());
+				tabbedStream++;
+				{
+					std::vector<CharcodeRun>	charcodeRuns;
+					std::vector<CharcodePlane>	charcodePlanes;
+					CreateCharcodeRuns(charcodeIterator.GetIndexVec(),
+										charcodeRuns, charcodePlanes, usesPlanes);
+					WriteCharcodeRuns(tabbedStream, charcodeRuns.data(),
+										(uint32_t)charcodeRuns.size(), charcodePlanes.data(),
+											(uint32_t)charcodePlanes.size());
+				}
+				for (size_t i = 0; i < sizeFiles.size() &&
+						createFileError == eSubsetNoErr; i++)
+				{
+					createFileError = XFntToC_Header(sizeFiles[i], utf8ExportPath.c_str(),
+										exportFile, subsetStr, true, sizeOptions[i],
+											sizeNames[i].c_str());
+				}
+				tabbedStream--;
+				tabbedStream.Write(
+					"\n}"
+					"\n\n#endif // %s\n\n",
+					headerMacro.c_str());
+				fclose(exportFile);
+			}
+		}
+		for (size_t i = 0; i < sizeFiles.size(); i++)
+		{
+			fclose(sizeFiles[i]);
+		}
+	} else if (createFileError == eSubsetNoErr)
+	{
+		createFileError = charcodeIterator.IsValid() ? eEmptySubsetErr : charcodeIterator.GetError();
+	}
+	return(createFileError);
+}
+
+/*************************** CreateMultiFormatFiles ***************************/
+/*
+*	The targets are created using a single FontSession with
+*	singleRasterization set, so each glyph is rendered as grayscale by the
+*	first target and the following targets use the cached rendering.  Each
+*	target is then encoded by CreateFile as usual (packed, rotated or run
+*	length encoded.)
+*/
+int SubsetFontCreator::CreateMultiFormatFiles(
+	const char*				inFontFilePath,
+	const ExportTargets&	inTargets,
+	int32_t					inPointSize,
+	const char*				inSubset,
+	long					inFontFaceIndex,
+	const FallbackFaces&	inFallbackFaces,
+	uint8_t					inMonoThreshold,
+	bool					inMonoRerender,
+	std::string*			outErrorStr,
+	std::string*			outWarningStr,
+	std::string*			outInfoStr,
+	const char*				inUsageProfilePath)
+{
+	int	createFileError = eSubsetNoErr;
+	if (inTargets.size())
+	{
+		FontSession	session(inFontFilePath, inFontFaceIndex, inFallbackFaces, outWarningStr);
+		session.singleRasterization = true;
+		session.monoThreshold = inMonoThreshold;
+		session.monoRerender = inMonoRerender;
+		ExportTargets::const_iterator	itr = inTargets.begin();
+		ExportTargets::const_iterator	itrEnd = inTargets.end();
+		for (; itr != itrEnd && createFileError == eSubsetNoErr; ++itr)
+		{
+			if (outInfoStr)
+			{
+				outInfoStr->append("\n");
+				outInfoStr->append(GetLastPathComponent(itr->path.c_str()));
+				outInfoStr->append(":");
+			}
+			createFileError = CreateFile(itr->format, inFontFilePath,
+								itr->path.c_str(), inPointSize, itr->options, inSubset,
+									inFontFaceIndex, inFallbackFaces, outErrorStr,
+										outWarningStr, outInfoStr, inUsageProfilePath, &session);
+		}
+		if (outInfoStr &&
+			inMonoRerender &&
+			createFileError == eSubsetNoErr)
+		{
+			char infoBuff[128];
+			outInfoStr->append(infoBuff, snprintf(infoBuff, 128,
+				"\n1 bit glyphs rendered as mono = %d\n",
+				(int)session.numMonoRerendered));
+		}
+	} else
+	{
+		createFileError = eEmptySubsetErr;
+	}
+	return(createFileError);
+}
+
 /******************************** PreviewFont *********************************/
 /*
 *	This routine was implemented to support the Minimize Height feature. When
@@ -1364,18 +3487,18 @@ int SubsetFontCreator::PreviewFont(
 	int						inOptions,
 	SubsetCharcodeIterator&	inCharcodeItr,
 	long					inFontFaceIndex,
-	const char*				inSupplementalFontFilePath,
-	long					inSupplementalFontFaceIndex,
-	FontHeader&				outFontHeader,
-	GlyphHeader&			outGlyphHeader,
-	std::string*			outErrorStr)
+	const FallbackFaces&	inFallbackFaces,
+	FontHeader16&			outFontHeader,
+	GlyphHeader16&			outGlyphHeader,
+	std::string*			outErrorStr,
+	FontSession*			inSession)
 {
 	int	createFileError = eSubsetNoErr;
 	bool	success = inCharcodeItr.IsValid();
 	
 	outGlyphHeader.advanceX = 0;
 	outGlyphHeader.x = 0;
-	outGlyphHeader.y = 127;
+	outGlyphHeader.y = 0x7FFF;
 	outGlyphHeader.rows = 0;
 	outGlyphHeader.columns = 0;
 	
@@ -1384,51 +3507,44 @@ int SubsetFontCreator::PreviewFont(
 		bool	rotated = (inOptions & (e1BitPerPixel+eRotated)) == e1BitPerPixel+eRotated;
 		bool	horizontal = (inOptions & eHorizontal) != 0;
 		bool	oneBitPerPixel = (inOptions & e1BitPerPixel) != 0;
-		std::string utf8FontPath(inFontFilePath);
-		std::string utf8SupplementalFontPath(inSupplementalFontFilePath);
 		{
-			std::vector<std::string>	faceNameVec;
-			GetFaceNames(utf8FontPath.c_str(), faceNameVec);
-			
-			FT_Library ftLibrary = NULL;
-			if (FT_Init_FreeType(&ftLibrary) == 0)
+			/*
+			*	Unless passed a session, the font is opened just for this
+			*	size.
+			*/
+			FontSession*	localSession = inSession ? NULL :
+								new FontSession(inFontFilePath, inFontFaceIndex,
+												inFallbackFaces, NULL);
+			FontSession*	session = inSession ? inSession : localSession;
+			if (session->library)
 			{
-				FT_Face	face = NULL;
-				FT_Face	supplementalFace = NULL;
-				if (inSupplementalFontFilePath)
-				{
-					FT_New_Face(ftLibrary, utf8SupplementalFontPath.c_str(), inSupplementalFontFaceIndex, &supplementalFace);
-					if (FT_Set_Char_Size(
-								supplementalFace,	/* handle to face object           */
-								0,		/* char_width in 1/64th of points  */
-								inPointSize*64,	/* char_height in 1/64th of points */
-								72,		/* horizontal device resolution    */
-								72))
-					{
-						supplementalFace = NULL;
-					}
-				}
-				bool success = FT_New_Face(ftLibrary, utf8FontPath.c_str(), inFontFaceIndex, &face) == 0;
-				if (success)
+				FT_Face	face = session->face;
+				if (face)
 				{
-					
-					FT_Error error = FT_Set_Char_Size(
-								face,	/* handle to face object           */
-								0,		/* char_width in 1/64th of points  */
-								inPointSize*64,	/* char_height in 1/64th of points */
-								72,		/* horizontal device resolution    */
-								72);	/* vertical device resolution      */
+					FT_Error error = session->SetCharSize(inPointSize, NULL);
+					std::vector<FT_Face>&	fallbackFaces = session->fallbackFaces;
 					
 					uint32_t	numCharCodes = inCharcodeItr.GetNumCharCodes();
 					FT_Face	charCodeFace = NULL;
-					outFontHeader.version = 1;
+					std::vector<IndexVec>	faceCoverage;
+					IndexVec	missingCharcodes;
+					CreateFaceCoverage(face, fallbackFaces, inCharcodeItr.GetIndexVec(),
+										faceCoverage, missingCharcodes);
 					outFontHeader.horizontal = (rotated && horizontal) ? 1:0;
 					outFontHeader.oneBit = oneBitPerPixel ? 1:0;
 					outFontHeader.rotated = rotated ? 1:0;
 					outFontHeader.ascent = face->size->metrics.ascender/64;
 					outFontHeader.descent = face->size->metrics.descender/64;
 					outFontHeader.height = (uint32_t)(face->size->metrics.height/64);;
-					outFontHeader.numCharcodeRuns = inCharcodeItr.GetNumRuns() +1;
+					outFontHeader.flags = 0;
+					{
+						std::vector<CharcodeRun>	charcodeRuns;
+						std::vector<CharcodePlane>	charcodePlanes;
+						outFontHeader.version = CreateCharcodeRuns(inCharcodeItr.GetIndexVec(),
+													charcodeRuns, charcodePlanes);
+						outFontHeader.numCharcodeRuns = (uint16_t)charcodeRuns.size();
+						numCharCodes = charcodeRuns.back().entryIndex;
+					}
 					outFontHeader.numCharCodes = numCharCodes;
 					outFontHeader.monospaced = 0;
 					outFontHeader.width = 0;
@@ -1438,40 +3554,28 @@ int SubsetFontCreator::PreviewFont(
 					if (error == 0)
 					{
 						FT_ULong	charcode;
-						FT_Int32	loadFlags = FT_LOAD_RENDER;
-						if (oneBitPerPixel)
-						{
-							loadFlags |= FT_LOAD_TARGET_MONO;
-						}	// else grayscale
+						GlyphBitmap	bitmap;
 						charcode = inCharcodeItr.Current();
 						while (inCharcodeItr.IsValid() &&
 							createFileError == eSubsetNoErr)
 						{
-							if (charcode > 0 && charcode < 0xFFFF)
+							if (charcode > 0 && (charcode & 0xFFFF) != 0xFFFF)
 							{
-								FT_UInt	glyphIndex = FT_Get_Char_Index(face, charcode);
-								if (glyphIndex ||
-									supplementalFace == NULL)
-								{
-									error = FT_Load_Glyph(face, glyphIndex, loadFlags);
-									charCodeFace = face;
-								} else
-								{
-									error = FT_Load_Char(supplementalFace, charcode, loadFlags);
-									charCodeFace = supplementalFace;
-								}
+								size_t	faceIndex = FaceForCharcode(faceCoverage, (uint32_t)charcode);
+								charCodeFace = faceIndex ? fallbackFaces[faceIndex-1] : face;
+								error = session->LoadGlyph(charCodeFace,
+											FT_Get_Char_Index(charCodeFace, charcode),
+												(uint32_t)charcode, oneBitPerPixel, bitmap);
 								if (error == 0)
 								{
-									FT_GlyphSlot	slot = charCodeFace->glyph;
-									FT_Bitmap&		bitmap = slot->bitmap;
 									int32_t			rows = bitmap.rows;
 
 
-									if (outGlyphHeader.x < slot->bitmap_left)
+									if (outGlyphHeader.x < bitmap.bitmapLeft)
 									{
-										outGlyphHeader.x = slot->bitmap_left;
+										outGlyphHeader.x = bitmap.bitmapLeft;
 									}
-									int8_t	thisGlyphY = ascent - slot->bitmap_top;
+									int16_t	thisGlyphY = ascent - bitmap.bitmapTop;
 									if (outGlyphHeader.y > thisGlyphY)
 									{
 										outGlyphHeader.y = thisGlyphY;
@@ -1489,7 +3593,7 @@ int SubsetFontCreator::PreviewFont(
 										outGlyphHeader.columns = bitmap.width;
 									}
 
-									uint8_t		advanceX = slot->advance.x/64;
+									uint16_t	advanceX = bitmap.advanceX/64;
 									if (outGlyphHeader.advanceX < advanceX)
 									{
 										outGlyphHeader.advanceX = advanceX;
@@ -1518,7 +3622,6 @@ int SubsetFontCreator::PreviewFont(
 							outErrorStr->assign("FT_Set_Char_Size() failed.");
 						}
 					}
-					FT_Done_Face(face);
 				} else
 				{
 					createFileError = eFTNewFaceFailedErr;
@@ -1527,11 +3630,6 @@ int SubsetFontCreator::PreviewFont(
 						outErrorStr->assign("FT_New_Face() failed.");
 					}
 				}
-				if (supplementalFace)
-				{
-					FT_Done_Face(supplementalFace);
-				}
-				FT_Done_FreeType(ftLibrary);
 			} else
 			{
 				createFileError = eFTInitFreeTypeFailedErr;
@@ -1540,6 +3638,7 @@ int SubsetFontCreator::PreviewFont(
 					outErrorStr->assign("FT_Init_FreeType() failed.");
 				}
 			}
+			delete localSession;
 		}
 		inCharcodeItr.MoveToStart();
 	} else
@@ -1570,13 +3669,12 @@ SubsetCharcodeIterator::SubsetCharcodeIterator(
 void SubsetCharcodeIterator::Initialize(
 	const char*	inSubset)
 {
-	std::string	subset(inSubset);
-	if (subset.length())
+	if (inSubset &&
+		inSubset[0])
 	{
 		mError = eSubsetNoErr;
 		mSubsetVec.Clear();
-		std::string::const_iterator	strItr = subset.begin();
-		std::string::const_iterator	strItrEnd = subset.end();
+		XFont::UTF8Reader	reader(inSubset);
 		/*
 		*	Validate the ranges
 		*	- there must be an end range
@@ -1584,9 +3682,9 @@ void SubsetCharcodeIterator::Initialize(
 		*/
 		uint32_t	startChar = 0;
 		int			pairIndex = 0;	// Used for error reporting
-		for (startChar = NextChar(strItr, strItrEnd); startChar; startChar = NextChar(strItr, strItrEnd))
+		for (startChar = reader.Next(); startChar; startChar = reader.Next())
 		{
-			uint32_t	endChar = NextChar(strItr, strItrEnd);
+			uint32_t	endChar = reader.Next();
 			if (startChar <= endChar)
 			{
 				mSubsetVec.Set(startChar, endChar);
@@ -1628,28 +3726,24 @@ void SubsetCharcodeIterator::Initialize(
 void SubsetCharcodeIterator::InitializeWithText(
 	const char*	inText)
 {
-	if (inText)
+	if (inText &&
+		inText[0])
 	{
-		std::string	text(inText);
-		if (text.length())
-		{
-			mError = eSubsetNoErr;
-			mIsValid = true;
-			mSubsetVec.Clear();
-			std::string::const_iterator	strItr = text.begin();
-			std::string::const_iterator	strItrEnd = text.end();
-			uint32_t	thisChar = 0;
+		mError = eSubsetNoErr;
+		mIsValid = true;
+		mSubsetVec.Clear();
+		XFont::UTF8Reader	reader(inText);
+		uint32_t	thisChar = 0;
 
-			for (thisChar = NextChar(strItr, strItrEnd); thisChar;
-									thisChar = NextChar(strItr, strItrEnd))
+		for (thisChar = reader.Next(); thisChar;
+								thisChar = reader.Next())
+		{
+			if (thisChar >= 0x20)
 			{
-				if (thisChar >= 0x20)
-				{
-					mSubsetVec.Set(thisChar, thisChar);
-				}
+				mSubsetVec.Set(thisChar, thisChar);
 			}
-			mIndexVecItr.SetIndexVec(&mSubsetVec);
 		}
+		mIndexVecItr.SetIndexVec(&mSubsetVec);
 	}
 }
 
@@ -1714,82 +3808,9 @@ uint32_t SubsetCharcodeIterator::GetNumRuns(void) const
 	return((uint32_t)mSubsetVec.GetRuns().size()/2);
 }
 
-/********************************** NextChar **********************************/
-uint32_t SubsetCharcodeIterator::NextChar(
-	std::string::const_iterator&	inSubsetStrItr,
-	std::string::const_iterator&	inSubsetStrItrEnd)
-{
-	uint32_t	nextChar = 0;
-	if (inSubsetStrItr != inSubsetStrItrEnd)
-	{
-		uint32_t  codepoint = (uint32_t)*(inSubsetStrItr++);
-		if ((codepoint & 0x80) == 0)
-		{
-			nextChar = codepoint;
-		// 2 byte sequence
-		} else if ((codepoint & 0xE0) == 0xC0)
-		{
-			nextChar = (uint32_t)(((codepoint & 0x1F) << 6) +
-							((uint32_t)(*(inSubsetStrItr++)) & 0x3F));
-		// 3 byte sequence
-		} else if ((codepoint & 0xF0) == 0xE0)
-		{
-			nextChar = (uint32_t)(((codepoint & 0x0F) << 0xC) +
-							(((uint32_t)(inSubsetStrItr[0]) & 0x3F) << 6) +
-								((uint32_t)(inSubsetStrItr[1]) & 0x3F));
-			inSubsetStrItr+=2;
-		// 4 byte sequence
-		} else if ((codepoint & 0xF8) == 0xF0)
-		{
-			nextChar = ((codepoint & 7) << 0x12) +
-							(((uint32_t)(inSubsetStrItr[0]) & 0x3F) << 0xC) +
-								(((uint32_t)(inSubsetStrItr[1]) & 0x3F) << 6) +
-									((uint32_t)(inSubsetStrItr[2]) & 0x3F);
-			inSubsetStrItr+=3;
-		}
-		
-			/*
-			*	No need to support 5 & 6 byte sequences.
-			*	The largest Unicode 6 code point is 10FFFF, (a 4 byte sequence)
-			* 5 byte sequence
-			*} else if ((codepoint & 0xFC) == 0xF8)
-			*{
-			*	nextChar = ((codepoint & 3) << 0x18) +
-			*					(((uint32_t)(inSubsetStrItr[0]) & 0x3F) << 0x12) +
-			*						(((uint32_t)(inSubsetStrItr[1]) & 0x3F) << 0xC) +
-			*							(((uint32_t)(inSubsetStrItr[2]) & 0x3F) << 6) +
-			*								((uint32_t)(inSubsetStrItr[3]) & 0x3F);
-			*	inSubsetStrItr+=4;
-			*}
-			* 6 byte sequence
-			*} else if ((codepoint & 0xFE) == 0xFC)
-			*{
-			*	nextChar = ((codepoint & 1) << 0x1E) +
-			*					(((uint32_t)(inSubsetStrItr[0]) & 0x3F) << 0x18) +
-			*						(((uint32_t)(inSubsetStrItr[1]) & 0x3F) << 0x12) +
-			*							(((uint32_t)(inSubsetStrItr[2]) & 0x3F) << 0xC) +
-			*								(((uint32_t)(inSubsetStrItr[3]) & 0x3F) << 6) +
-			*									((uint32_t)(inSubsetStrItr[4]) & 0x3F);
-			*	inSubsetStrItr+=5;
-			*}
-			*
-			*	For uint16_t
-			*if (codepoint > 0xFFFF)
-			*{
-			*	nextChar = (uint32_t)(0xD7C0 + (codepoint >> 0xA)); //(>>10 in decimal) compiler expects a Hex (not Decimal) number
-			*	mNextWChar = (uint32_t)(0xDC00 + (codepoint & 0x3FF));
-			*} else
-			*{
-			*	nextChar = (uint32_t)codepoint;
-			*}
-			*/
-	}
-	return(nextChar);
-}
-
 /******************************** AppendUTF16 *********************************/
 void SubsetCharcodeIterator::AppendUTF16(
-	uint16_t		inCodepoint,
+	uint32_t		inCodepoint,
 	std::string&	outUTF8)
 {
 		if (inCodepoint < 0x80)
@@ -1799,17 +3820,131 @@ void SubsetCharcodeIterator::AppendUTF16(
 		{
 			outUTF8 += (0xC0 | inCodepoint >> 6);
 			outUTF8 += (0x80 | (inCodepoint & 0x3F));
-		} else/* if (inCodepoint < 0x10000)*/
+		} else if (inCodepoint < 0x10000)
 		{
 			outUTF8 += (0xE0 | inCodepoint >> 0xC);
 			outUTF8 += (0x80 | (inCodepoint >> 6 & 0x3F));
 			outUTF8 += (0x80 | (inCodepoint & 0x3F));
-		}
-		/*else if (inCodepoint < 0x200000)
+		} else
 		{
 			outUTF8 += (0xF0 | inCodepoint >> 0x12);
-			outUTF8 += (0x80 | inCodepoint >> 0xC & 0x3F);
-			outUTF8 += (0x80 | inCodepoint >> 6 & 0x3F);
-			outUTF8 += (0x80 | inCodepoint & 0x3F);
-		}*/
+			outUTF8 += (0x80 | (inCodepoint >> 0xC & 0x3F));
+			outUTF8 += (0x80 | (inCodepoint >> 6 & 0x3F));
+			outUTF8 += (0x80 | (inCodepoint & 0x3F));
+		}
+}
+
+/******************************** AddText *************************************/
+/*
+*	Counts each charcode within a sample of the text to be displayed.
+*/
+void GlyphUsageProfile::AddText(
+	const char*	inText)
+{
+	if (inText)
+	{
+		XFont::UTF8Reader	reader(inText);
+		uint32_t	thisChar = 0;
+
+		for (thisChar = reader.Next(); thisChar;
+						thisChar = reader.Next())
+		{
+			if (thisChar >= 0x20)
+			{
+				mCounts[thisChar]++;
+			}
+		}
+	}
+}
+
+/******************************* AddHistogram *********************************/
+/*
+*	Parses a recorded histogram, one "U+XXXX count" or "0xXXXX count" per line.
+*	Empty lines are ignored.  Returns false (without adding anything) if
+*	inHistogram isn't a histogram.
+*/
+bool GlyphUsageProfile::AddHistogram(
+	const char*	inHistogram)
+{
+	std::map<uint32_t, uint32_t>	counts;
+	bool	isHistogram = inHistogram != NULL;
+	const char*	linePtr = inHistogram;
+	while (isHistogram && *linePtr)
+	{
+		for (; *linePtr == ' ' || *linePtr == '\t'; linePtr++){}
+		if (*linePtr == '\n' || *linePtr == '\r')
+		{
+			linePtr++;
+			continue;
+		}
+		if (*linePtr == 0)
+		{
+			break;
+		}
+		isHistogram = (linePtr[0] == 'U' && linePtr[1] == '+') ||
+						(linePtr[0] == '0' && (linePtr[1] == 'x' || linePtr[1] == 'X'));
+		if (isHistogram)
+		{
+			char*	endPtr;
+			uint32_t	charcode = (uint32_t)strtoul(&linePtr[2], &endPtr, 16);
+			isHistogram = endPtr != &linePtr[2] && (*endPtr == ' ' || *endPtr == '\t');
+			if (isHistogram)
+			{
+				linePtr = endPtr;
+				uint32_t	count = (uint32_t)strtoul(linePtr, &endPtr, 10);
+				isHistogram = endPtr != linePtr;
+				linePtr = endPtr;
+				for (; *linePtr == ' ' || *linePtr == '\t'; linePtr++){}
+				isHistogram = isHistogram &&
+					(*linePtr == 0 || *linePtr == '\n' || *linePtr == '\r');
+				counts[charcode] += count;
+			}
+		}
+	}
+	if (isHistogram)
+	{
+		std::map<uint32_t, uint32_t>::const_iterator	itr = counts.begin();
+		std::map<uint32_t, uint32_t>::const_iterator	itrEnd = counts.end();
+		for (; itr != itrEnd; ++itr)
+		{
+			mCounts[itr->first] += itr->second;
+		}
+	}
+	return(isHistogram);
+}
+
+/*********************************** Load *************************************/
+/*
+*	Loads a histogram or sample text file.  A file that isn't a histogram is
+*	treated as UTF-8 sample text.
+*/
+bool GlyphUsageProfile::Load(
+	const char*	inPath)
+{
+	FILE*	file = fopen(inPath, "r");
+	bool	success = file != NULL;
+	if (success)
+	{
+		std::string	contents;
+		char	buffer[1024];
+		size_t	bytesRead;
+		while ((bytesRead = fread(buffer, 1, sizeof(buffer), file)) > 0)
+		{
+			contents.append(buffer, bytesRead);
+		}
+		fclose(file);
+		if (!AddHistogram(contents.c_str()))
+		{
+			AddText(contents.c_str());
+		}
+	}
+	return(success);
+}
+
+/********************************* GetCount ***********************************/
+uint32_t GlyphUsageProfile::GetCount(
+	uint32_t	inCharcode) const
+{
+	std::map<uint32_t, uint32_t>::const_iterator	itr = mCounts.find(inCharcode);
+	return(itr != mCounts.end() ? itr->second : 0);
 }
@@ -36,6 +36,7 @@
 #define SubsetFontCreator_h
 
 #include <string>
+#include <map>
 #include "IndexVec.h"
 #include "XFontGlyph.h"
 
@@ -50,10 +51,42 @@ enum ESubsetErr
 	eFTSetCharSizeFailedErr,
 	eFTLoadCharFailedErr,
 	eFTNewFaceFailedErr,
-	eFTInitFreeTypeFailedErr
+	eFTInitFreeTypeFailedErr,
+	eUsageProfileReadErr,
+	eMetricsTooLargeErr
 };
 
 class SubsetCharcodeIterator;
+class GlyphUsageProfile;
+class TabbedFileStream;
+struct FontSession;
+
+/*
+*	A font face to take glyphs from when the font doesn't have them.  The
+*	fallback faces are searched in order, so each charcode is taken from the
+*	first face that has it.
+*/
+struct FallbackFace
+{
+	std::string	path;
+	long		faceIndex;
+				FallbackFace(
+					const char*	inPath,
+					long		inFaceIndex = 0)
+					: path(inPath), faceIndex(inFaceIndex){}
+};
+typedef std::vector<FallbackFace> FallbackFaces;
+
+/*
+*	Fixed UTF-8 strings (labels, menu titles, etc.) exported as pre-rendered
+*	images.  Each image is stored in the glyph data as a glyph the width of
+*	the string and the height of the font, encoded the same way as the
+*	glyphs, and is drawn using XFont::DrawStaticString.  The string ID is the
+*	index of the string.  The strings don't need to be within the subset.
+*	The xfnt file ends with the uint32_t glyph data offset of each string,
+*	plus the offset of the end, followed by the uint16_t number of strings.
+*/
+typedef std::vector<std::string> StaticStrings;
 
 class SubsetFontCreator
 {
@@ -81,7 +114,53 @@ public:
 		*	Minimize Height trims the overall height of the font to min y +
 		*	tallest glyph.  This is useful for very large fonts.
 		*/
-		eMinimizeHeight			= 0x20
+		eMinimizeHeight			= 0x20,
+		/*
+		*	Page aligned glyph data is for glyph data stored on an external
+		*	EEPROM (e.g. AT24C) read via a page based cache.  Glyphs are laid
+		*	out so that a glyph no larger than a page doesn't straddle a page
+		*	boundary.  The gaps created are filled with smaller glyphs where
+		*	possible, otherwise padded.  The page size is 16 << field value
+		*	(ePageAlign32 to ePageAlign256), 0 = not page aligned.  Requires
+		*	eGlyphDataSeparately, the glyph data file must be written at a
+		*	page aligned EEPROM address.
+		*/
+		ePageAlignMask			= 0x1C0,
+		ePageAlign32			= 0x40,
+		ePageAlign64			= 0x80,
+		ePageAlign128			= 0xC0,
+		ePageAlign256			= 0x100,
+		/*
+		*	Segmented data offsets remove the 64KB glyph data limit of 16 bit
+		*	offsets.  The 16 bit offsets are relative to a 32 bit base offset
+		*	per 256 entries.  CreateFile switches to segmented offsets when the
+		*	glyph data doesn't fit within 16 bit offsets.
+		*/
+		eSegmentedDataOffsets	= 0x200,
+		/*
+		*	C headers use delta encoded data offsets (a byte per glyph plus a
+		*	16 bit checkpoint per 16 glyphs) whenever this saves PROGMEM.
+		*	Fixed data offsets disables this, trading PROGMEM for the
+		*	slightly faster lookup of one 16 bit offset per glyph.
+		*/
+		eFixedDataOffsets		= 0x400,
+		/*
+		*	16 bit metrics (FontHeader version 3) remove the 255 pixel limit
+		*	of the font and glyph metrics.  CreateXfntFile selects 16 bit
+		*	metrics when the font metrics need them, and CreateFile starts
+		*	over with 16 bit metrics when a glyph's metrics need them.
+		*/
+		e16BitMetrics			= 0x800,
+		/*
+		*	Kerning pairs (from the font's kern table) between the glyphs
+		*	of the subset are appended to the xfnt file.  See XFontGlyph.h
+		*/
+		eKerningPairs			= 0x1000,
+		/*
+		*	Adaptive encoding stores each 8 bit glyph either run length
+		*	encoded or raw, whichever is smaller.  See XFontGlyph.h
+		*/
+		eAdaptiveEncoding		= 0x2000
 	};
 	static int				CreateXfntFile(
 								const char*				inFontFilePath,
@@ -91,11 +170,13 @@ public:
 								int						inOptions,
 								SubsetCharcodeIterator&	inCharcodeItr,
 								long					inFontFaceIndex,
-								const char*				inSupplementalFontFilePath,
-								long					inSupplementalFontFaceIndex,
+								const FallbackFaces&	inFallbackFaces,
 								std::string*			outErrorStr = NULL,
 								std::string*			outWarningStr = NULL,
-								std::string*			outInfoStr = NULL);
+								std::string*			outInfoStr = NULL,
+								const GlyphUsageProfile*	inUsageProfile = NULL,
+								FontSession*			inSession = NULL,
+								const StaticStrings*	inStaticStrings = NULL);
 	static int				CreateFile(
 								EFormat					inExportFormat,
 								const char*				inFontFilePath,
@@ -104,23 +185,99 @@ public:
 								int						inOptions,
 								const char*				inSubset,
 								long					inFontFaceIndex,
-								const char*				inSupplementalFontFilePath,
-								long					inSupplementalFontFaceIndex,
+								const FallbackFaces&	inFallbackFaces,
 								std::string*			outErrorStr = NULL,
 								std::string*			outWarningStr = NULL,
-								std::string*			outInfoStr = NULL);
+								std::string*			outInfoStr = NULL,
+								const char*				inUsageProfilePath = NULL,
+								FontSession*			inSession = NULL,
+								const StaticStrings*	inStaticStrings = NULL);
+	/*
+	*	CreateFamilyFile exports the subset at each of inPointSizes to a
+	*	single C header.  The sizes share one CharcodeRun table, and each size
+	*	has its own FontHeader, glyph data offsets and glyph data within a
+	*	namespace named for its point size.  The font is only opened once.
+	*/
+	static int				CreateFamilyFile(
+								const char*				inFontFilePath,
+								const char*				inExportPath,
+								const std::vector<int32_t>&	inPointSizes,
+								int						inOptions,
+								const char*				inSubset,
+								long					inFontFaceIndex,
+								const FallbackFaces&	inFallbackFaces,
+								std::string*			outErrorStr = NULL,
+								std::string*			outWarningStr = NULL,
+								std::string*			outInfoStr = NULL,
+								const char*				inUsageProfilePath = NULL);
+	/*
+	*	CreateMultiFormatFiles exports the subset at inPointSize once per
+	*	target, e.g. an 8 bit C header for a TFT and a 1 bit rotated C header
+	*	for an SSD1306.  Each glyph is only rendered once, as grayscale.  1 bit
+	*	targets set the pixels >= inMonoThreshold.  When inMonoRerender, the
+	*	glyphs whose mono hinting differs from the grayscale rendering are
+	*	rendered as mono instead.
+	*/
+	struct ExportTarget
+	{
+		EFormat		format;
+		std::string	path;
+		int			options;
+					ExportTarget(
+						EFormat		inFormat,
+						const char*	inPath,
+						int			inOptions)
+						: format(inFormat), path(inPath), options(inOptions){}
+	};
+	typedef std::vector<ExportTarget> ExportTargets;
+	static int				CreateMultiFormatFiles(
+								const char*				inFontFilePath,
+								const ExportTargets&	inTargets,
+								int32_t					inPointSize,
+								const char*				inSubset,
+								long					inFontFaceIndex,
+								const FallbackFaces&	inFallbackFaces,
+								uint8_t					inMonoThreshold = 128,
+								bool					inMonoRerender = false,
+								std::string*			outErrorStr = NULL,
+								std::string*			outWarningStr = NULL,
+								std::string*			outInfoStr = NULL,
+								const char*				inUsageProfilePath = NULL);
 	static int				GetFaceNames(
 								const char*				inFontFilePath,
 								std::vector<std::string>&	outFaceNames);
 
 protected:
+	static int				CreateXfntFileAndRetry(
+								const char*				inFontFilePath,
+								FILE*					inExportFile,
+								FILE*					inGlyphDataExportFile,
+								int32_t					inPointSize,
+								int&					ioOptions,
+								SubsetCharcodeIterator&	inCharcodeItr,
+								long					inFontFaceIndex,
+								const FallbackFaces&	inFallbackFaces,
+								std::string*			outErrorStr,
+								std::string*			outWarningStr,
+								std::string*			outInfoStr,
+								const GlyphUsageProfile*	inUsageProfile,
+								FontSession*			inSession = NULL,
+								const StaticStrings*	inStaticStrings = NULL);
 	static int				XFntToC_Header(
 								FILE*					inXFntFile,
 								const char*				inExportPath,
 								FILE*					inOutputFile,
 								std::string&			inSubsetStr,
 								bool					inIncludeGlyphData,
-								int						inOptions);
+								int						inOptions,
+								const char*				inFamilySizeName = NULL,
+								const StaticStrings*	inStaticStrings = NULL);
+	static void				WriteCharcodeRuns(
+								TabbedFileStream&		inTabbedStream,
+								const CharcodeRun*		inCharcodeRuns,
+								uint32_t				inNumCharcodeRuns,
+								const CharcodePlane*	inCharcodePlanes,
+								uint32_t				inNumCharcodePlanes);
 	static uint8_t* 		CreateRotatedData(
 								const uint8_t*			inBitmap,
 								int						inRows,
@@ -129,17 +286,48 @@ protected:
 								bool					inMSBTop,
 								bool					inHorizontal,
 								size_t&					outDataLen);
+	static uint32_t			RunLengthEncode(
+								const uint8_t*			inPixels,
+								int32_t					inPixelCount,
+								uint8_t*				outData);
+	static int				RenderStaticString(
+								FontSession*			inSession,
+								std::vector<IndexVec>&	inFaceCoverage,
+								const std::string&		inString,
+								bool					inOneBit,
+								bool					inKerningPairs,
+								int32_t					inTop,
+								int32_t					inHeight,
+								uint32_t&				outColumns,
+								std::vector<uint8_t>&	outPixels);
+	static uint32_t			LayoutGlyphEntries(
+								const uint32_t*			inEntryOffsets,
+								uint32_t				inNumEntries,
+								uint32_t				inGlyphDataLen,
+								uint32_t				inPageSize,
+								const std::vector<uint32_t>&	inPreferredOrder,
+								std::vector<uint32_t>&	outEntryOffsets,
+								std::vector<uint32_t>&	outEntryOrder);
+	static uint32_t			BusTransactionsForGlyph(
+								uint32_t				inEntryOffset,
+								uint32_t				inEntrySize,
+								uint32_t				inPageSize);
+	static uint8_t			CreateCharcodeRuns(
+								const IndexVec&			inIndexVec,
+								std::vector<CharcodeRun>&	outCharcodeRuns,
+								std::vector<CharcodePlane>&	outCharcodePlanes,
+								bool					inUsePlanes = false);
 	static int				PreviewFont(
 								const char*				inFontFilePath,
 								int32_t					inPointSize,
 								int						inOptions,
 								SubsetCharcodeIterator&	inCharcodeItr,
 								long					inFontFaceIndex,
-								const char*				inSupplementalFontFilePath,
-								long					inSupplementalFontFaceIndex,
-								FontHeader&				outFontHeader,
-								GlyphHeader&			outGlyphHeader,
-								std::string*			outErrorStr);
+								const FallbackFaces&	inFallbackFaces,
+								FontHeader16&			outFontHeader,
+								GlyphHeader16&			outGlyphHeader,
+								std::string*			outErrorStr,
+								FontSession*			inSession = NULL);
 };
 
 class SubsetCharcodeIterator
@@ -174,16 +362,42 @@ protected:
 	std::string*	mErrorStr;
 	ESubsetErr		mError;
 
-							/*
-							*	Only used during initialization of the subset index vec
-							*/
-	static uint32_t			NextChar(
-								std::string::const_iterator&	inSubsetStrItr,
-								std::string::const_iterator&	inSubsetStrItrEnd);
 	static void				AppendUTF16(
-								uint16_t				inCodepoint,
+								uint32_t				inCodepoint,
 								std::string&			outUTF8);
 };
 
+/*
+*	GlyphUsageProfile holds the relative usage of each charcode.  When passed
+*	to CreateXfntFile, the most used glyphs are placed contiguously at the
+*	front of the glyph data (the glyph data offsets remain indirect.)
+*
+*	The profile is either a sample of the text to be displayed, or a recorded
+*	histogram.  A histogram has one charcode per line as U+XXXX or 0xXXXX
+*	followed by whitespace and a decimal count, e.g. "U+0030 1250".
+*/
+class GlyphUsageProfile
+{
+public:
+	void					AddText(
+								const char*				inText);
+	bool					AddHistogram(
+								const char*				inHistogram);
+	bool					Load(
+								const char*				inPath);
+	void					AddCount(
+								uint32_t				inCharcode,
+								uint32_t				inCount)
+								{mCounts[inCharcode] += inCount;}
+	uint32_t				GetCount(
+								uint32_t				inCharcode) const;
+	bool					IsEmpty(void) const
+								{return(mCounts.empty());}
+	void					Clear(void)
+								{mCounts.clear();}
+protected:
+	std::map<uint32_t, uint32_t>	mCounts;
+};
+
 
 #endif /* SubsetFontCreator_h */
@@ -62,23 +62,118 @@ uint32_t XFont16BitDataStream::Clip(
 	return(mSourceStream->Clip(inLength));
 }
 
-/********************************** NextByte **********************************/
+/************************************ Skip ************************************/
 /*
-*	This routine manages a small buffer rather than constantly calling Read of
-*	the source stream.
+*	Skips inPixels as if they were read, without calculating their colors.
+*	1 bit and raw 8 bit data are skipped by seeking.  Run length encoded data
+*	only reads the run lengths and the first pixel of the runs skipped into.
 */
-uint8_t XFont16BitDataStream::NextByte(void)
+void XFont16BitDataStream::Skip(
+	uint32_t	inPixels)
 {
-	if (mBufferIndex == mBytesInBuffer)
+	if (mXFont->GetFontHeader().oneBit)
 	{
-		mBytesInBuffer = (uint8_t)mSourceStream->Read(sizeof(mBuffer), mBuffer);
-		mBufferIndex = 0;
-	}
-	if (mBytesInBuffer)
+		uint8_t	bitsInByteIn = mSavedState.oneBit.bitsInByteIn;
+		if (inPixels < bitsInByteIn)
+		{
+			mSavedState.oneBit.byteIn <<= inPixels;
+			mSavedState.oneBit.bitsInByteIn = bitsInByteIn - inPixels;
+		} else
+		{
+			inPixels -= bitsInByteIn;
+			SkipBytes(inPixels >> 3);
+			bitsInByteIn = inPixels & 7;
+			if (bitsInByteIn)
+			{
+				mSavedState.oneBit.byteIn = NextByte() << bitsInByteIn;
+				bitsInByteIn = 8 - bitsInByteIn;
+			}
+			mSavedState.oneBit.bitsInByteIn = bitsInByteIn;
+		}
+	} else
 	{
-		return(mBuffer[mBufferIndex++]);
+		int8_t	runLength = mSavedState.run.length;
+		uint8_t	runTint = 0;
+		bool	runTintRead = false;
+		if (runLength == 0 &&
+			!mSavedState.run.raw &&
+			inPixels)
+		{
+			runLength = NextByte();
+			if (runLength == 0)
+			{
+				mSavedState.run.raw = true;
+				mSavedState.run.tint = 0;
+				mSavedState.run.color = mXFont->GetBGTextColor();
+			} else
+			{
+				runTint = NextByte();
+				runTintRead = true;
+			}
+		}
+		if (mSavedState.run.raw)
+		{
+			SkipBytes(inPixels);
+		} else
+		{
+			while (inPixels)
+			{
+				/*
+				*	If the run length is negative THEN
+				*	this is a run of unique values.  The current pixel has
+				*	already been read, the rest of the run hasn't.
+				*/
+				if (runLength < 0)
+				{
+					uint32_t	pixelsInRun = -runLength;
+					if (inPixels < pixelsInRun)
+					{
+						SkipBytes(inPixels - 1);
+						runTint = NextByte();
+						runTintRead = true;
+						runLength += inPixels;
+						inPixels = 0;
+					} else
+					{
+						SkipBytes(pixelsInRun - 1);
+						inPixels -= pixelsInRun;
+						runLength = 0;
+					}
+				/*
+				*	Else this is a run of same values.
+				*/
+				} else if (runLength > 0)
+				{
+					if (inPixels < (uint32_t)runLength)
+					{
+						runLength -= inPixels;
+						inPixels = 0;
+					} else
+					{
+						inPixels -= runLength;
+						runLength = 0;
+					}
+				} else
+				{
+					// Fatal error in source data.  A zero run length was read.
+					break;
+				}
+				if (runLength == 0 &&
+					inPixels)
+				{
+					runLength = NextByte();
+					runTint = NextByte();
+					runTintRead = true;
+				}
+			}
+			mSavedState.run.length = runLength;
+			if (runTintRead &&
+				runLength)
+			{
+				mSavedState.run.color = mXFont->Calc565Color(runTint);
+			}
+		}
 	}
-	return(0);
 }
 
 /************************************ Read ************************************/
@@ -93,9 +188,9 @@ uint32_t XFont16BitDataStream::Read(
 	if (mReadGlyphHeader)
 	{
 		mReadGlyphHeader = false;
-		mBufferIndex = 0;
-		mBytesInBuffer = 0;
-		mSavedState.run = {0};
+		mBufferPtr = mBuffer;
+		mBufferEnd = mBuffer;
+		memset(&mSavedState, 0, sizeof(mSavedState));
 		return(mSourceStream->Read(inLength, outBuffer));
 	}
 	if (inLength)
@@ -150,65 +245,102 @@ uint32_t XFont16BitDataStream::Read(
 		{
 			int8_t runLength = mSavedState.run.length;
 			uint16_t	runColor;
-			if (runLength == 0)
+			if (runLength == 0 &&
+				!mSavedState.run.raw)
 			{
 				runLength = NextByte();
-				runColor = mXFont->Calc565Color(NextByte());
+				/*
+				*	A zero run length is only written at the start of a raw
+				*	glyph (see XFontGlyph.h)
+				*/
+				if (runLength == 0)
+				{
+					mSavedState.run.raw = true;
+					mSavedState.run.tint = 0;
+					mSavedState.run.color = mXFont->GetBGTextColor();
+				} else
+				{
+					runColor = mXFont->Calc565Color(NextByte());
+				}
 			} else
 			{
 				runColor = mSavedState.run.color;
 			}
-			do
+			/*
+			*	If this is a raw glyph THEN copy a tint per pixel.  Most
+			*	pixels are either the background or the text color, so the
+			*	color is only recalculated when the tint changes.
+			*/
+			if (mSavedState.run.raw)
 			{
-				/*
-				*	If the run length is negative THEN
-				*	this is a run of unique values.
-				*/
-				if (runLength < 0)
+				uint8_t		tint = mSavedState.run.tint;
+				uint16_t	color = mSavedState.run.color;
+				while (oBufferPtr != oBufferEnd)
 				{
-					while (oBufferPtr != oBufferEnd)
+					uint8_t	thisTint = NextByte();
+					if (thisTint != tint)
 					{
-						*(oBufferPtr++) = runColor;
-						runLength++;
-						if (runLength)
+						tint = thisTint;
+						color = mXFont->Calc565Color(tint);
+					}
+					*(oBufferPtr++) = color;
+				}
+				mSavedState.run.tint = tint;
+				mSavedState.run.color = color;
+			} else
+			{
+				do
+				{
+					/*
+					*	If the run length is negative THEN
+					*	this is a run of unique values.
+					*/
+					if (runLength < 0)
+					{
+						while (oBufferPtr != oBufferEnd)
 						{
-							runColor = mXFont->Calc565Color(NextByte());
-							continue;
+							*(oBufferPtr++) = runColor;
+							runLength++;
+							if (runLength)
+							{
+								runColor = mXFont->Calc565Color(NextByte());
+								continue;
+							}
+							break;
 						}
-						break;
+					/*
+					*	Else this is a run of same values.
+					*/
+					} else if (runLength > 0)
+					{
+						for (; oBufferPtr != oBufferEnd && runLength; runLength--)
+						{
+							*(oBufferPtr++) = runColor;
+						}
+					} else
+					{
+						// Fatal error in source data.  A zero run length was read.
+						oBufferPtr = oBufferEnd;
 					}
-				/*
-				*	Else this is a run of same values.
-				*/
-				} else if (runLength > 0)
-				{
-					for (; oBufferPtr != oBufferEnd && runLength; runLength--)
+					/*
+					*	If not at the end of the output buffer THEN
+					*	load the next run length and its color
+					*/
+					if (oBufferPtr != oBufferEnd)
 					{
-						*(oBufferPtr++) = runColor;
+						runLength = NextByte();
+						runColor = mXFont->Calc565Color(NextByte());
+					/*
+					*	else, save the state and exit.
+					*/
+					} else
+					{
+						mSavedState.run.length = runLength;
+						mSavedState.run.color = runColor;
+						break;
 					}
-				} else
-				{
-					// Fatal error in source data.  A zero run length was read.
-					oBufferPtr = oBufferEnd;
-				}
-				/*
-				*	If not at the end of the output buffer THEN
-				*	load the next run length and its color
-				*/
-				if (oBufferPtr != oBufferEnd)
-				{
-					runLength = NextByte();
-					runColor = mXFont->Calc565Color(NextByte());
-				/*
-				*	else, save the state and exit.
-				*/
-				} else
-				{
-					mSavedState.run.length = runLength;
-					mSavedState.run.color = runColor;
-					break;
-				}
-			} while (true);
+				} while (true);
+			}
 		}
 	}
 	return(inLength);
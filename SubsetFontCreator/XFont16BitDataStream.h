@@ -46,6 +46,8 @@ public:
 	virtual bool			AtEOF(void) const;
 	virtual uint32_t		Clip(
 								uint32_t				inLength) const;
+	virtual void			Skip(
+								uint32_t				inPixels);
 protected:
 	bool		mOneBit;
 	bool		mReadGlyphHeader;
@@ -62,13 +64,9 @@ protected:
 		{
 			uint16_t	color;
 			int8_t		length;
+			bool		raw;	// Raw glyph, color is the color of tint
+			uint8_t		tint;
 		} run;
 	} mSavedState;
-
-	uint8_t		mBuffer[32];
-	uint8_t		mBufferIndex;
-	uint8_t		mBytesInBuffer;
-	
-	uint8_t					NextByte(void);
 };
 #endif // XFont16BitDataStream_h
@@ -62,23 +62,26 @@ uint32_t XFontR1BitDataStream::Clip(
 	return(mSourceStream->Clip(inLength));
 }
 
-/********************************** NextByte **********************************/
+/************************************ Skip ************************************/
 /*
-*	This routine manages a small buffer rather than constantly calling Read of
-*	the source stream.
+*	Skips inLength unpacked bytes.  When skipping whole columns from the start
+*	of a column (as done when clipping), only the packed bits of the columns
+*	are skipped.  Otherwise the bytes are unpacked and discarded.
 */
-uint8_t XFontR1BitDataStream::NextByte(void)
+void XFontR1BitDataStream::Skip(
+	uint32_t	inLength)
 {
-	if (mBufferIndex == mBytesInBuffer)
+	uint16_t	bytesPerColumn = (mXFont->Glyph().y + mXFont->Glyph().rows + 7)/8;
+	if (bytesPerColumn &&
+		mBitsInColumn == 0 &&
+		(inLength % bytesPerColumn) == 0)
 	{
-		mBytesInBuffer = (uint8_t)mSourceStream->Read(sizeof(mBuffer), mBuffer);
-		mBufferIndex = 0;
-	}
-	if (mBytesInBuffer)
+		SkipBits((inLength / bytesPerColumn) * mXFont->Glyph().rows,
+			mByteIn, mBitsInByteIn);
+	} else
 	{
-		return(mBuffer[mBufferIndex++]);
+		XFontDataStream::Skip(inLength);
 	}
-	return(0);
 }
 
 #if 0
@@ -127,16 +130,16 @@ uint32_t XFontR1BitDataStream::Read(
 	if (mReadGlyphHeader)
 	{
 		mReadGlyphHeader = false;
-		mBufferIndex = 0;
-		mBytesInBuffer = 0;
+		mBufferPtr = mBuffer;
+		mBufferEnd = mBuffer;
 		mBitsInByteIn = 0;
 		mBitsInColumn = 0;
 		return(mSourceStream->Read(inLength, outBuffer));
 	}
 	if (inLength)
 	{
-		uint8_t		offsetBitsBy = mXFont->Glyph().y;
-		uint8_t		bitsPerColumn = offsetBitsBy + mXFont->Glyph().rows;
+		uint16_t	offsetBitsBy = mXFont->Glyph().y;
+		uint16_t	bitsPerColumn = offsetBitsBy + mXFont->Glyph().rows;
 		uint8_t*	oBufferPtr = (uint8_t*)outBuffer;
 		uint8_t*	oBufferEnd = &oBufferPtr[inLength];
 		uint8_t		byteIn = 0;
@@ -153,7 +156,7 @@ uint32_t XFontR1BitDataStream::Read(
 		}
 		
 		uint8_t	bitsInByteOut = 0;
-		uint8_t	bitsInColumn = mBitsInColumn;
+		uint16_t	bitsInColumn = mBitsInColumn;
 		while (oBufferPtr != oBufferEnd)
 		{
 			if (bitsInColumn < offsetBitsBy)
@@ -185,7 +188,7 @@ uint32_t XFontR1BitDataStream::Read(
 				{
 					byteOut = byteIn;
 				}
-				uint8_t	bitsNeededToFillColumn = bitsPerColumn - bitsInColumn;
+				uint16_t	bitsNeededToFillColumn = bitsPerColumn - bitsInColumn;
 				if (bitsNeededToFillOut > bitsNeededToFillColumn)
 				{
 					if (bitsInByteIn >= bitsNeededToFillColumn)
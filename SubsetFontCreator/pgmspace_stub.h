@@ -3,7 +3,9 @@
 
 #include <inttypes.h>
 
+#define pgm_read_byte_near(address_short) *(uint8_t*)(address_short)
 #define pgm_read_word_near(address_short) *(uint16_t*)(address_short)
+#define pgm_read_dword_near(address_short) *(uint32_t*)(address_short)
 
 #define memcpy_P(dest, src, len)	memcpy(dest, src, len)
 